@@ -1,18 +1,38 @@
 #include "IOManager.hpp"
 #include <iostream>
-#include <chrono>
 #include <fstream>
-#include <cstdlib>
-#include <ctime>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+IODeviceConfig &io_device_by_name(std::vector<IODeviceConfig> &devices, const std::string &name) {
+    for (IODeviceConfig &device : devices)
+        if (device.name == name) return device;
+    std::string names;
+    for (const IODeviceConfig &device : devices) names += (names.empty() ? "" : ", ") + device.name;
+    throw std::invalid_argument("Dispositivo de I/O desconhecido: " + name + " (" + names + ")");
+}
+
+std::vector<IODeviceConfig> IOManager::defaultDevices() {
+    return {
+        {"printer", "print_job", "Imprimindo documento...", 1, 100, 300, 1},
+        {"disk", "read_from_disk", "Lendo dados do disco...", 1, 100, 300, 2},
+        {"network", "send_packet", "Enviando pacote pela rede...", 1, 50, 400, 1},
+    };
+}
 
 // Construtor
-IOManager::IOManager() :
-    printer_requesting(false),
-    disk_requesting(false),
-    network_requesting(false),
-    shutdown_flag(false)
+IOManager::IOManager(uint32_t seed, std::vector<IODeviceConfig> devices) :
+    configs(std::move(devices)),
+    rng(seed)
 {
-    srand(time(nullptr));
+    if (configs.empty()) throw std::invalid_argument("IOManager sem dispositivos");
+    for (const IODeviceConfig &config : configs) {
+        if (config.channels == 0 || config.min_cycles > config.max_cycles)
+            throw std::invalid_argument("Dispositivo de I/O '" + config.name + "': canais ou ciclos invalidos");
+        total_weight += config.weight;
+    }
+    if (total_weight == 0) throw std::invalid_argument("IOManager: todos os dispositivos com peso zero");
 
     resultFile.open("result.dat", std::ios::app);
     outputFile.open("output.dat", std::ios::app);
@@ -21,112 +41,226 @@ IOManager::IOManager() :
         std::cerr << "Erro: não foi possível abrir arquivos de saída." << std::endl;
     }
 
-    managerThread = std::thread(&IOManager::managerLoop, this);
+    // Cada dispositivo tem o seu gerador, derivado da semente: o custo de um
+    // atendimento não depende do que os outros dispositivos já sortearam
+    for (std::size_t i = 0; i < configs.size(); ++i) {
+        auto device = std::make_unique<Device>();
+        device->busy_until.assign(configs[i].channels, 0);
+        device->rng.seed(seed + 1 + static_cast<uint32_t>(i));
+        deviceStates.push_back(std::move(device));
+    }
+    for (std::size_t i = 0; i < configs.size(); ++i)
+        for (unsigned c = 0; c < configs[i].channels; ++c)
+            deviceStates[i]->workers.emplace_back(&IOManager::workerLoop, this, i);
 }
 
 // Destrutor
 IOManager::~IOManager() {
-    shutdown_flag = true;
-    if (managerThread.joinable()) {
-        managerThread.join();
+    for (auto &device : deviceStates) {
+        {
+            std::lock_guard<std::mutex> lock(device->lock);
+            device->shutdown = true;
+        }
+        device->work.notify_all();
     }
+    for (auto &device : deviceStates)
+        for (std::thread &worker : device->workers)
+            if (worker.joinable()) worker.join();
     resultFile.close();
     outputFile.close();
 }
 
-// Adiciona um processo à lista de espera por I/O
-void IOManager::registerProcessWaitingForIO(PCB* process) {
-    std::lock_guard<std::mutex> lock(waiting_processes_lock);
-    waiting_processes.push_back(process);
+// Adiciona um processo à fila de espera de um dispositivo sorteado pelo peso
+void IOManager::registerProcessWaitingForIO(PCB* process, uint64_t cycle) {
+    std::size_t device = 0;
+    {
+        std::lock_guard<std::mutex> lock(routeLock);
+        unsigned pick = rng() % total_weight;
+        while (pick >= configs[device].weight) pick -= configs[device++].weight;
+    }
+    registerProcessWaitingForIO(process, cycle, device);
 }
 
-// Adiciona uma requisição criada à fila de processamento
-void IOManager::addRequest(std::unique_ptr<IORequest> request) {
-    std::lock_guard<std::mutex> lock(queueLock);
-    requests.push_back(std::move(request));
+void IOManager::registerProcessWaitingForIO(PCB* process, uint64_t cycle, std::size_t device) {
+    if (device >= deviceStates.size()) throw std::out_of_range("Dispositivo de I/O inexistente");
+    IORequest request;
+    request.process = process;
+    request.device = device;
+    request.submit_cycle = cycle;
+    Device &d = *deviceStates[device];
+    {
+        std::lock_guard<std::mutex> lock(d.lock);
+        d.requests.push_back(std::move(request));
+    }
+    d.work.notify_one();
 }
 
-void IOManager::managerLoop() {
-    while (!shutdown_flag) {
-        // ETAPA 1: Simula os dispositivos solicitando uma operação
-        {
-            std::lock_guard<std::mutex> lock(device_state_lock);
-            if (rand() % 100 == 0) {
-                if (!printer_requesting) {
-                    printer_requesting = true;
-                    // std::cout << "I/O Manager: [Impressora] está solicitando uma operação." << std::endl;
-                }
-            }
-            if (rand() % 50 == 0) {
-                if (!disk_requesting) {
-                    disk_requesting = true;
-                    // std::cout << "I/O Manager: [Disco] está solicitando uma operação." << std::endl;
-                }
-            }
+std::vector<PCB*> IOManager::takeCompletions(std::size_t minimum) {
+    std::vector<PCB*> done;
+    PCB *process = nullptr;
+    for (;;) {
+        while (completions.tryPop(process)) done.push_back(process);
+        if (done.size() >= minimum) break;
+
+        // Anuncia que vai dormir e só então olha a fila de novo: ou o
+        // produtor vê o aviso e acorda, ou a conclusão dele já está visível
+        std::unique_lock<std::mutex> lock(sleepLock);
+        consumer_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        completed.wait(lock, [this] { return !completions.empty(); });
+        consumer_waiting.store(false, std::memory_order_relaxed);
+    }
+    // A ordem de chegada depende de qual thread terminou primeiro
+    std::stable_sort(done.begin(), done.end(), [](const PCB *a, const PCB *b) {
+        const uint64_t ca = a->io_ready_cycle.load(), cb = b->io_ready_cycle.load();
+        return ca != cb ? ca < cb : a->pid < b->pid;
+    });
+    return done;
+}
+
+bool IOManager::postCompletion(PCB *process) {
+    if (!completions.tryPush(process)) return false;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_waiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        completed.notify_one();
+    }
+    return true;
+}
+
+IOManager::PendingState IOManager::pendingState() const {
+    std::lock_guard<std::mutex> routeGuard(routeLock);
+    std::vector<std::unique_lock<std::mutex>> deviceGuards;
+    for (const auto &device : deviceStates) deviceGuards.emplace_back(device->lock);
+
+    PendingState state;
+    std::ostringstream rngState;
+    rngState << rng;
+    state.rng = rngState.str();
+    for (const auto &device : deviceStates) {
+        DeviceState saved;
+        std::ostringstream deviceRng;
+        deviceRng << device->rng;
+        saved.rng = deviceRng.str();
+        saved.busy_until = device->busy_until;
+        saved.requests.assign(device->requests.begin(), device->requests.end());
+        state.devices.push_back(std::move(saved));
+        for (PCB *process : device->unpublished) {
+            IORequest done;
+            done.process = process;
+            done.completion_cycle = process->io_ready_cycle.load();
+            state.completed.push_back(std::move(done));
         }
+    }
+    // Chamado pelo escalonador, o consumidor da fila: pode olhar sem retirar
+    completions.forEach([&state](PCB *process) {
+        IORequest done;
+        done.process = process;
+        done.completion_cycle = process->io_ready_cycle.load();
+        state.completed.push_back(std::move(done));
+    });
+    return state;
+}
 
-        // ETAPA 2: Verifica se há dispositivos solicitando E processos esperando
-        std::unique_ptr<IORequest> new_request = nullptr;
-        {
-            std::lock_guard<std::mutex> wplock(waiting_processes_lock);
-            if (!waiting_processes.empty()) {
-                std::lock_guard<std::mutex> dslock(device_state_lock);
-                PCB* process_to_service = waiting_processes.front();
-
-                if (printer_requesting) {
-                    new_request = std::make_unique<IORequest>();
-                    new_request->operation = "print_job";
-                    new_request->msg = "Imprimindo documento...";
-                    printer_requesting = false;
-                } else if (disk_requesting) {
-                    new_request = std::make_unique<IORequest>();
-                    new_request->operation = "read_from_disk";
-                    new_request->msg = "Lendo dados do disco...";
-                    disk_requesting = false;
-                }
-                
-                if (new_request) {
-                    new_request->process = process_to_service;
-                    waiting_processes.erase(waiting_processes.begin());
-                    new_request->cost_cycles = std::chrono::milliseconds((rand() % 3 + 1) * 100);
-                }
-            }
+bool IOManager::compatible(const PendingState &state) const {
+    if (state.devices.size() != configs.size()) return false;
+    for (std::size_t i = 0; i < configs.size(); ++i)
+        if (state.devices[i].busy_until.size() != configs[i].channels) return false;
+    return true;
+}
+
+void IOManager::restorePendingState(const PendingState &state) {
+    if (!compatible(state))
+        throw std::invalid_argument("Estado de I/O de outra configuracao de dispositivos");
+    {
+        std::lock_guard<std::mutex> routeGuard(routeLock);
+        std::vector<std::unique_lock<std::mutex>> deviceGuards;
+        for (const auto &device : deviceStates) deviceGuards.emplace_back(device->lock);
+
+        std::istringstream rngState(state.rng);
+        rngState >> rng;
+        for (std::size_t i = 0; i < deviceStates.size(); ++i) {
+            Device &device = *deviceStates[i];
+            std::istringstream deviceRng(state.devices[i].rng);
+            deviceRng >> device.rng;
+            device.busy_until = state.devices[i].busy_until;
+            device.requests.assign(state.devices[i].requests.begin(), state.devices[i].requests.end());
+            for (IORequest &request : device.requests) request.device = i;
+            device.unpublished.clear();
         }
-        
-        if (new_request) {
-            addRequest(std::move(new_request));
+        for (PCB *discarded = nullptr; completions.tryPop(discarded);) {}
+        // O que não couber na fila fica para as threads do primeiro dispositivo publicarem
+        for (const IORequest &done : state.completed) {
+            done.process->io_ready_cycle = done.completion_cycle;
+            if (!completions.tryPush(done.process)) deviceStates.front()->unpublished.push_back(done.process);
         }
+    }
+    for (const auto &device : deviceStates) device->work.notify_all();
+}
+
+// Cada requisição fica com o canal que se libera primeiro (empate: o de
+// menor índice), a partir de quando o processo bloqueou, e termina
+// 'cost_cycles' depois. A thread que executa não importa: o canal é o do
+// tempo virtual, então o resultado não depende de qual thread acordou.
+void IOManager::serve(std::size_t device, IORequest &request) {
+    const IODeviceConfig &config = configs[device];
+    Device &d = *deviceStates[device];
+    const auto channel = std::min_element(d.busy_until.begin(), d.busy_until.end());
+    const uint64_t start = std::max(request.submit_cycle, *channel);
+    request.operation = config.operation;
+    request.msg = config.msg;
+    request.channel = static_cast<unsigned>(channel - d.busy_until.begin());
+    request.cost_cycles = config.min_cycles + d.rng() % (config.max_cycles - config.min_cycles + 1);
+    request.completion_cycle = start + request.cost_cycles;
+    *channel = request.completion_cycle;
+}
 
-        // ETAPA 3: Processa a próxima requisição na fila
-        std::unique_ptr<IORequest> req_to_process = nullptr;
+void IOManager::workerLoop(std::size_t device) {
+    Device &d = *deviceStates[device];
+    for (;;) {
+        // Dorme até chegar uma requisição para o dispositivo (ou o
+        // encerramento). Tirar da fila, atender e publicar a conclusão
+        // acontecem sob a trava, então pendingState() vê a requisição inteira
+        // em um dos dois lados e cada dispositivo atende na ordem de chegada.
+        // Com a fila de conclusões cheia, a conclusão fica em 'unpublished'
+        // (ainda sob a trava) e a thread tenta de novo sem segurar a trava:
+        // pendingState() e restorePendingState() tomam todas as travas e não
+        // podem esperar o escalonador esvaziar a fila.
+        IORequest req_to_process;
+        int pid = 0; // o PCB pode deixar de existir depois de entregue
         {
-            std::lock_guard<std::mutex> lock(queueLock);
-            if (!requests.empty()) {
-                req_to_process = std::move(requests.front());
-                requests.erase(requests.begin());
+            std::unique_lock<std::mutex> lock(d.lock);
+            d.work.wait(lock, [&d] { return d.shutdown || !d.requests.empty() || !d.unpublished.empty(); });
+            if (d.shutdown) return;
+            if (!d.unpublished.empty()) {
+                if (postCompletion(d.unpublished.front())) {
+                    d.unpublished.pop_front();
+                } else {
+                    lock.unlock();
+                    std::this_thread::yield(); // cheia: o escalonador esvazia
+                }
+                continue;
             }
-        }
-
-        if (req_to_process) {
-            auto start = std::chrono::steady_clock::now();
-            std::this_thread::sleep_for(req_to_process->cost_cycles);
-            auto end = std::chrono::steady_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+            req_to_process = std::move(d.requests.front());
+            d.requests.pop_front();
+            serve(device, req_to_process);
 
             // Incrementa ciclos de I/O no PCB
-            req_to_process->process->io_cycles.fetch_add(duration);
-
-            std::cout << "I/O Manager: Processo " << req_to_process->process->pid 
-                    << " executou '" << req_to_process->operation << "'\n";
+            req_to_process.process->io_cycles.fetch_add(req_to_process.cost_cycles);
+            req_to_process.process->io_ready_cycle = req_to_process.completion_cycle;
+            pid = req_to_process.process->pid;
+            wakeup_count.fetch_add(1);
+            if (!postCompletion(req_to_process.process)) d.unpublished.push_back(req_to_process.process);
+        }
 
-            resultFile << "Processo " << req_to_process->process->pid << " -> " 
-                    << req_to_process->operation << " : " << req_to_process->msg << "\n";
-            outputFile << req_to_process->process->pid << "," 
-                    << req_to_process->operation << "," << duration << "ms\n";
+        std::lock_guard<std::mutex> lock(logLock);
+        std::cout << "I/O Manager: Processo " << pid
+                << " executou '" << req_to_process.operation << "' ("
+                << configs[device].name << ", canal " << req_to_process.channel << ")\n";
 
-            req_to_process->process->state = State::Ready;
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
-        }
+        resultFile << "Processo " << pid << " -> "
+                << req_to_process.operation << " : " << req_to_process.msg << "\n";
+        outputFile << pid << ","
+                << req_to_process.operation << "," << req_to_process.cost_cycles << " ciclos\n";
     }
-}
\ No newline at end of file
+}
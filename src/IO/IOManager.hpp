@@ -2,52 +2,152 @@
 #define IOMANAGER_HPP
 
 #include "../cpu/PCB.hpp"
+#include "completion_ring.hpp"
+#include <atomic>
+#include <cstddef>
+#include <deque>
 #include <vector>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
 #include <memory>
 #include <fstream>
-#include <chrono>
+#include <random>
+#include <string>
 
 // Definição completa da estrutura IORequest
 struct IORequest {
     std::string operation;
     std::string msg;
     PCB* process = nullptr; // Ponteiro para o PCB associado
-    std::chrono::milliseconds cost_cycles;
+    std::size_t device = 0;         // índice em IOManager::devices()
+    unsigned channel = 0;           // canal do dispositivo que atendeu
+    uint64_t cost_cycles = 0;       // duração do atendimento no dispositivo
+    uint64_t submit_cycle = 0;      // ciclo (virtual) em que o processo bloqueou
+    uint64_t completion_cycle = 0;  // ciclo em que o processo volta a ficar pronto
 };
 
+// Um dispositivo de I/O: fila própria e 'channels' canais atendendo em
+// paralelo, cada um com uma thread de trabalho
+struct IODeviceConfig {
+    std::string name;           // "printer", "disk", "network" (--io=nome:...)
+    std::string operation;      // o que aparece em result.dat e output.dat
+    std::string msg;
+    unsigned channels = 1;
+    uint64_t min_cycles = 100;  // atendimento uniforme em [min_cycles, max_cycles]
+    uint64_t max_cycles = 300;
+    unsigned weight = 1;        // chance relativa de uma requisição ir para ele
+};
+
+// Dispositivo pelo nome (invalid_argument se não existir), para ajustar a
+// configuração antes de criar o IOManager
+IODeviceConfig &io_device_by_name(std::vector<IODeviceConfig> &devices, const std::string &name);
+
+// Os dispositivos trabalham em tempo virtual, nos ciclos do escalonador: o
+// atendimento não dorme, só calcula quando a requisição termina. Cada
+// requisição vai para um dispositivo sorteado na submissão (pelo peso) e
+// espera na fila dele até um canal ficar livre; dispositivos diferentes e
+// canais do mesmo dispositivo atendem ao mesmo tempo. Com a mesma semente, a
+// mesma configuração e as mesmas submissões, os ciclos de término são sempre
+// os mesmos.
+//
+// As threads de trabalho dormem numa variável de condição do seu dispositivo
+// até chegar uma requisição; o processo atendido volta ao escalonador por uma
+// fila sem travas (CompletionRing), esvaziada em takeCompletions. As threads
+// não mexem em PCB::state.
 class IOManager {
 public:
-    IOManager();
+    explicit IOManager(uint32_t seed = 1, std::vector<IODeviceConfig> devices = defaultDevices());
     ~IOManager();
 
-    // Método para um processo se registrar como "esperando por I/O"
-    void registerProcessWaitingForIO(PCB* process);
+    // Impressora, disco e rede, um canal cada; o disco recebe metade das
+    // requisições
+    static std::vector<IODeviceConfig> defaultDevices();
+    const std::vector<IODeviceConfig> &devices() const { return configs; }
+
+    // Método para um processo se registrar como "esperando por I/O" no ciclo
+    // 'cycle', no dispositivo sorteado ou no indicado. Acorda uma thread do
+    // dispositivo.
+    void registerProcessWaitingForIO(PCB* process, uint64_t cycle);
+    void registerProcessWaitingForIO(PCB* process, uint64_t cycle, std::size_t device);
+
+    // Processos atendidos, com PCB::io_ready_cycle preenchido, em ordem de
+    // término (empate: menor pid). Espera até haver pelo menos 'minimum' (0:
+    // não espera). Os dispositivos terminam fora de ordem entre si, então a
+    // ordem só é determinística pedindo todas as requisições pendentes, como
+    // o escalonador faz. Só o escalonador chama (a fila tem um consumidor
+    // só); custa O(conclusões), não O(processos bloqueados).
+    std::vector<PCB*> takeCompletions(std::size_t minimum = 0);
+
+    // Conclusões que cabem na fila; com ela cheia a thread de I/O guarda a
+    // conclusão no dispositivo e tenta de novo sem segurar a trava dele
+    static constexpr std::size_t COMPLETION_CAPACITY = 1024;
+
+    // Vezes que uma thread de trabalho acordou para atender (ociosas, dormem)
+    uint64_t wakeups() const { return wakeup_count.load(); }
+
+    // Trabalho pendente, para o checkpoint (cpu/checkpoint): o gerador do
+    // sorteio e, por dispositivo, o gerador, quando cada canal fica livre e
+    // as requisições ainda sem resposta, na ordem de chegada; e as atendidas
+    // que o escalonador ainda não recebeu.
+    struct DeviceState {
+        std::string rng;                  // operator<< de std::mt19937
+        std::vector<uint64_t> busy_until; // por canal
+        std::vector<IORequest> requests;  // process e submit_cycle
+    };
+    struct PendingState {
+        std::string rng;
+        std::vector<DeviceState> devices; // na ordem de devices()
+        std::vector<IORequest> completed; // process e completion_cycle
+    };
+    PendingState pendingState() const;
+    // O estado veio de um IOManager com os mesmos dispositivos e canais?
+    bool compatible(const PendingState &state) const;
+    // Substitui o trabalho pendente (descarta o que houver). invalid_argument
+    // se !compatible(state)
+    void restorePendingState(const PendingState &state);
 
 private:
-    void managerLoop();
-    void addRequest(std::unique_ptr<IORequest> request);
+    struct Device {
+        std::deque<IORequest> requests;   // esperando um canal, na ordem de chegada
+        std::deque<PCB*> unpublished;     // atendidas que não couberam na fila de conclusões
+        std::vector<uint64_t> busy_until; // ciclo em que cada canal fica livre
+        std::mt19937 rng;
+        bool shutdown = false;
+        std::mutex lock;                  // protege tudo acima
+        std::condition_variable work;     // requisição nova ou encerramento
+        std::vector<std::thread> workers; // uma por canal
+    };
+
+    void workerLoop(std::size_t device);
+    // Escolhe o canal e calcula custo e término (sob Device::lock)
+    void serve(std::size_t device, IORequest &request);
+    // Publica uma conclusão e acorda o escalonador se ele estiver dormindo;
+    // false, sem esperar, se a fila está cheia
+    bool postCompletion(PCB *process);
 
-    // Fila de requisições prontas para serem executadas
-    std::vector<std::unique_ptr<IORequest>> requests;
-    std::mutex queueLock;
+    std::vector<IODeviceConfig> configs;
+    std::vector<std::unique_ptr<Device>> deviceStates; // na ordem de configs
 
-    // Fila de processos que estão no estado BLOCKED esperando por um dispositivo
-    std::vector<PCB*> waiting_processes;
-    std::mutex waiting_processes_lock;
+    // Sorteio do dispositivo na submissão. Trava em ordem: routeLock, depois
+    // os Device::lock em ordem de índice
+    std::mt19937 rng;
+    unsigned total_weight = 0;
+    mutable std::mutex routeLock;
 
-    // Variáveis booleanas representando o estado de cada dispositivo (0/1)
-    bool printer_requesting;
-    bool disk_requesting;
-    bool network_requesting;
-    std::mutex device_state_lock;
+    std::atomic<uint64_t> wakeup_count{0};
 
-    bool shutdown_flag;
-    std::thread managerThread;
+    // Processos atendidos esperando o escalonador. A fila não tem trava; a
+    // variável de condição só serve para o escalonador dormir com ela vazia
+    // (consumer_waiting avisa os produtores que há alguém para acordar)
+    CompletionRing<PCB*, COMPLETION_CAPACITY> completions;
+    std::atomic<bool> consumer_waiting{false};
+    std::mutex sleepLock;
+    std::condition_variable completed;
 
+    std::mutex logLock; // console e arquivos, escritos por todas as threads
     std::ofstream resultFile;
     std::ofstream outputFile;
 };
 
-#endif // IOMANAGER_HPP 
\ No newline at end of file
+#endif // IOMANAGER_HPP
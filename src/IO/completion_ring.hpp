@@ -0,0 +1,98 @@
+#ifndef COMPLETION_RING_HPP
+#define COMPLETION_RING_HPP
+/*
+  completion_ring.hpp
+  Fila circular limitada, sem travas, de vários produtores e um consumidor
+  (MPSC). As threads de I/O publicam os processos atendidos e o escalonador
+  os retira, cada um em O(1), sem percorrer a lista de bloqueados.
+
+  Cada posição tem um número de sequência (esquema de D. Vyukov): a posição
+  'pos' está livre para o produtor quando sequence == pos e pronta para o
+  consumidor quando sequence == pos + 1. Os produtores disputam 'tail' com
+  compare_exchange; o consumidor é um só, então 'head' nem precisa ser
+  atômico. Publicar com release e ler com acquire garante que o consumidor
+  vê tudo o que o produtor escreveu antes (PCB::io_cycles, io_ready_cycle).
+
+  Cheia, tryPush devolve false e o produtor decide o que fazer (o IOManager
+  cede a vez até o escalonador esvaziar).
+*/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, std::size_t Capacity>
+class CompletionRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacidade deve ser potencia de 2");
+
+public:
+    CompletionRing() {
+        for (std::size_t i = 0; i < Capacity; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    CompletionRing(const CompletionRing &) = delete;
+    CompletionRing &operator=(const CompletionRing &) = delete;
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    // Qualquer thread. false: fila cheia
+    bool tryPush(const T &value) {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot &slot = slots[pos & (Capacity - 1)];
+            const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                // Posição livre: quem ganhar o CAS escreve nela
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // o consumidor ainda não liberou a posição de uma volta atrás
+            } else {
+                pos = tail.load(std::memory_order_relaxed); // outro produtor passou na frente
+            }
+        }
+    }
+
+    // Só o consumidor. false: vazia (ou o produtor da próxima posição ainda
+    // não terminou de publicar)
+    bool tryPop(T &value) {
+        Slot &slot = slots[head & (Capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) return false;
+        value = slot.value;
+        slot.sequence.store(head + Capacity, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    // Só o consumidor
+    bool empty() const {
+        return slots[head & (Capacity - 1)].sequence.load(std::memory_order_acquire) != head + 1;
+    }
+
+    // Só o consumidor: visita, sem retirar, os elementos já publicados em
+    // ordem (checkpoint do IOManager)
+    template <typename F>
+    void forEach(F &&visit) const {
+        for (std::size_t pos = head;; ++pos) {
+            const Slot &slot = slots[pos & (Capacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return;
+            visit(slot.value);
+        }
+    }
+
+private:
+    // Cada posição e cada índice numa linha de cache própria: produtores e
+    // consumidor não disputam a mesma linha sem necessidade
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    alignas(64) std::atomic<std::size_t> tail{0};
+    alignas(64) std::size_t head = 0;
+    Slot slots[Capacity];
+};
+
+#endif // COMPLETION_RING_HPP
@@ -0,0 +1,204 @@
+#include "BRANCH_PREDICTOR.hpp"
+#include "checkpoint.hpp"
+
+#include <stdexcept>
+
+namespace {
+
+constexpr const char *KIND_NAMES[] = {"not-taken", "static", "bimodal", "gshare", "tournament"};
+
+inline bool counterTaken(uint8_t c) { return c >= 2; }
+
+inline void saturate(uint8_t &c, bool up) {
+    if (up) { if (c < 3) ++c; }
+    else if (c > 0) --c;
+}
+
+bool isPowerOfTwo(unsigned v) { return v != 0 && (v & (v - 1)) == 0; }
+
+} // namespace
+
+PredictorKind predictor_kind_from_string(const std::string &name) {
+    for (unsigned i = 0; i < sizeof(KIND_NAMES) / sizeof(KIND_NAMES[0]); ++i)
+        if (name == KIND_NAMES[i]) return static_cast<PredictorKind>(i);
+    throw std::invalid_argument("Preditor de desvios desconhecido: " + name +
+                                " (not-taken, static, bimodal, gshare ou tournament)");
+}
+
+const char *predictor_kind_name(PredictorKind kind) {
+    return KIND_NAMES[static_cast<unsigned>(kind)];
+}
+
+BranchPredictor::BranchPredictor(const BranchPredictorConfig &config) : cfg(config) {
+    if (cfg.tableBits < 1 || cfg.tableBits > 20)
+        throw std::invalid_argument("Preditor de desvios: table_bits deve estar entre 1 e 20");
+    if (cfg.historyBits > cfg.tableBits)
+        throw std::invalid_argument("Preditor de desvios: history_bits nao pode passar de table_bits");
+    if (cfg.btbEntries != 0 && !isPowerOfTwo(cfg.btbEntries))
+        throw std::invalid_argument("Preditor de desvios: btb_entries deve ser potencia de 2");
+
+    const size_t tableSize = size_t(1) << cfg.tableBits;
+    tableMask = static_cast<uint32_t>(tableSize - 1);
+    historyMask = (uint32_t(1) << cfg.historyBits) - 1;
+    if (cfg.kind == PredictorKind::Bimodal || cfg.kind == PredictorKind::Tournament) bimodal.assign(tableSize, 1);
+    if (cfg.kind == PredictorKind::GShare || cfg.kind == PredictorKind::Tournament) gshare.assign(tableSize, 1);
+    if (cfg.kind == PredictorKind::Tournament) chooser.assign(tableSize, 1);
+    btb.resize(cfg.btbEntries);
+    ras.resize(cfg.rasEntries);
+}
+
+bool BranchPredictor::directionFor(uint32_t pc, uint32_t target, uint32_t hist, Prediction &p) const {
+    switch (cfg.kind) {
+        case PredictorKind::Static:
+            return target < pc; // laços: desvio para trás
+        case PredictorKind::Bimodal:
+            return counterTaken(bimodal[pcIndex(pc)]);
+        case PredictorKind::GShare:
+            return counterTaken(gshare[gshareIndex(pc, hist)]);
+        case PredictorKind::Tournament:
+            p.bimodalTaken = counterTaken(bimodal[pcIndex(pc)]);
+            p.gshareTaken = counterTaken(gshare[gshareIndex(pc, hist)]);
+            return counterTaken(chooser[pcIndex(pc)]) ? p.gshareTaken : p.bimodalTaken;
+        default:
+            return false;
+    }
+}
+
+Prediction BranchPredictor::predict(uint32_t pc) {
+    Prediction p;
+    p.nextPC = pc + 4;
+    p.history = history;
+    p.rasTop = rasTop;
+    if (cfg.kind == PredictorKind::NotTaken || btb.empty()) return p;
+
+    const BtbEntry &e = btb[(pc >> 2) & (btb.size() - 1)];
+    if (!e.valid || e.tag != pc) return p;
+    p.btbHit = true;
+
+    uint32_t target = e.target;
+    switch (e.kind) {
+        case BranchKind::Conditional:
+            p.taken = directionFor(pc, e.target, history, p);
+            history = ((history << 1) | (p.taken ? 1u : 0u)) & historyMask;
+            break;
+        case BranchKind::Jump:
+            p.taken = true;
+            break;
+        case BranchKind::Call:
+            p.taken = true;
+            if (!ras.empty()) ras[rasTop++ % ras.size()] = pc + 4;
+            break;
+        case BranchKind::Return:
+            p.taken = true;
+            if (!ras.empty() && rasTop > 0) target = ras[--rasTop % ras.size()];
+            break;
+        case BranchKind::None:
+            break;
+    }
+    if (p.taken) p.nextPC = target;
+    return p;
+}
+
+void BranchPredictor::train(uint32_t pc, const Prediction &p, bool taken) {
+    if (!bimodal.empty()) saturate(bimodal[pcIndex(pc)], taken);
+    if (!gshare.empty()) saturate(gshare[gshareIndex(pc, p.history)], taken);
+    if (!chooser.empty() && p.bimodalTaken != p.gshareTaken)
+        saturate(chooser[pcIndex(pc)], p.gshareTaken == taken);
+}
+
+bool BranchPredictor::update(uint32_t pc, isa::Op op, const Prediction &prediction, bool taken, uint32_t target) {
+    const BranchKind kind = branch_kind_of(op);
+    const uint32_t actualNext = taken ? target : pc + 4;
+    const bool mispredicted = actualNext != prediction.nextPC;
+    if (cfg.kind == PredictorKind::NotTaken) return mispredicted;
+
+    BtbEntry *entry = btb.empty() ? nullptr : &btb[(pc >> 2) & (btb.size() - 1)];
+
+    if (kind == BranchKind::Conditional) {
+        Prediction votes = prediction;
+        if (!prediction.btbHit) directionFor(pc, target, prediction.history, votes); // votos para o seletor
+        train(pc, votes, taken);
+    }
+
+    if (mispredicted) {
+        // Desfaz o que a previsão (e o caminho errado) fez e aplica o real
+        history = prediction.history;
+        rasTop = prediction.rasTop;
+        if (kind == BranchKind::Conditional) history = ((history << 1) | (taken ? 1u : 0u)) & historyMask;
+        if (kind == BranchKind::Call && !ras.empty()) ras[rasTop++ % ras.size()] = pc + 4;
+        if (kind == BranchKind::Return && !ras.empty() && rasTop > 0) --rasTop;
+    }
+
+    if (entry) {
+        if (kind == BranchKind::None) {
+            // O endereço deixou de ser um desvio (código reescrito)
+            if (entry->valid && entry->tag == pc) entry->valid = false;
+        } else if (taken) {
+            entry->valid = true;
+            entry->kind = kind;
+            entry->tag = pc;
+            entry->target = target;
+        }
+    }
+    return mispredicted;
+}
+
+void BranchPredictor::saveState(std::ostream &out) const {
+    ckpt::put<uint8_t>(out, static_cast<uint8_t>(cfg.kind));
+    ckpt::put<uint32_t>(out, cfg.tableBits);
+    ckpt::put<uint32_t>(out, cfg.historyBits);
+    ckpt::put<uint32_t>(out, cfg.btbEntries);
+    ckpt::put<uint32_t>(out, cfg.rasEntries);
+    ckpt::put<uint32_t>(out, cfg.mispredictPenalty);
+    ckpt::put<uint32_t>(out, history);
+    ckpt::put<uint32_t>(out, rasTop);
+    for (const auto *table : {&bimodal, &gshare, &chooser})
+        out.write(reinterpret_cast<const char*>(table->data()), static_cast<std::streamsize>(table->size()));
+    for (const auto &e : btb) {
+        ckpt::put<uint8_t>(out, e.valid);
+        ckpt::put<uint8_t>(out, static_cast<uint8_t>(e.kind));
+        ckpt::put<uint32_t>(out, e.tag);
+        ckpt::put<uint32_t>(out, e.target);
+    }
+    for (uint32_t v : ras) ckpt::put<uint32_t>(out, v);
+}
+
+void BranchPredictor::loadState(std::istream &in) {
+    BranchPredictorConfig config;
+    const uint8_t kind = ckpt::get<uint8_t>(in);
+    if (kind > static_cast<uint8_t>(PredictorKind::Tournament))
+        throw std::runtime_error("Checkpoint corrompido (preditor de desvios)");
+    config.kind = static_cast<PredictorKind>(kind);
+    config.tableBits = ckpt::get<uint32_t>(in);
+    config.historyBits = ckpt::get<uint32_t>(in);
+    config.btbEntries = ckpt::get<uint32_t>(in);
+    config.rasEntries = ckpt::get<uint32_t>(in);
+    config.mispredictPenalty = ckpt::get<uint32_t>(in);
+    if (config.btbEntries > (1u << 20) || config.rasEntries > (1u << 20))
+        throw std::runtime_error("Checkpoint corrompido (preditor de desvios)");
+
+    BranchPredictor restored = [&] {
+        try {
+            return BranchPredictor(config);
+        } catch (const std::invalid_argument &) {
+            throw std::runtime_error("Checkpoint corrompido (preditor de desvios)");
+        }
+    }();
+    restored.history = ckpt::get<uint32_t>(in);
+    restored.rasTop = ckpt::get<uint32_t>(in);
+    for (auto *table : {&restored.bimodal, &restored.gshare, &restored.chooser}) {
+        in.read(reinterpret_cast<char*>(table->data()), static_cast<std::streamsize>(table->size()));
+        if (!in) throw std::runtime_error("Checkpoint truncado");
+    }
+    for (auto &e : restored.btb) {
+        e.valid = ckpt::get<uint8_t>(in) != 0;
+        const uint8_t branchKind = ckpt::get<uint8_t>(in);
+        if (branchKind > static_cast<uint8_t>(BranchKind::Return))
+            throw std::runtime_error("Checkpoint corrompido (BTB)");
+        e.kind = static_cast<BranchKind>(branchKind);
+        e.tag = ckpt::get<uint32_t>(in);
+        e.target = ckpt::get<uint32_t>(in);
+    }
+    for (auto &v : restored.ras) v = ckpt::get<uint32_t>(in);
+    *this = std::move(restored);
+}
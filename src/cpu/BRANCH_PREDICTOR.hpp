@@ -0,0 +1,118 @@
+#ifndef BRANCH_PREDICTOR_HPP
+#define BRANCH_PREDICTOR_HPP
+/*
+  BRANCH_PREDICTOR.hpp
+  Unidade de previsão de desvios do estágio de Fetch.
+
+  A cada busca, predict() devolve o próximo PC sem conhecer a instrução:
+  - BTB (Branch Target Buffer) mapeado diretamente, indexado pelo PC: diz se
+    o endereço é um desvio, de que tipo e qual o alvo. Sem acerto na BTB a
+    previsão é PC + 4;
+  - direção dos desvios condicionais, conforme o tipo do preditor:
+      not-taken   nunca desvia (o comportamento original do pipeline; não
+                  consulta a BTB)
+      static      para trás desvia, para frente não (BTFN)
+      bimodal     contador saturado de 2 bits por PC
+      gshare      contador de 2 bits indexado por PC xor histórico global
+      tournament  bimodal + gshare e um seletor de 2 bits por PC;
+  - j e jal desviam sempre; jal empilha PC + 4 na RAS (Return Address Stack)
+    e jr desvia para o topo dela.
+
+  O estágio EX resolve o desvio e chama update() com o resultado real. O
+  histórico global e a RAS são atualizados de forma especulativa na previsão;
+  um erro restaura o estado guardado em Prediction antes de aplicar o real.
+
+  Cada processo (PCB) tem o seu preditor, que persiste entre as fatias do
+  escalonador, entra no checkpoint e é copiado nas bifurcações.
+*/
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "ISA.hpp"
+
+enum class PredictorKind : uint8_t { NotTaken, Static, Bimodal, GShare, Tournament };
+
+// Nome usado na linha de comando e no JSON do PCB ("gshare"...); lança invalid_argument
+PredictorKind predictor_kind_from_string(const std::string &name);
+const char *predictor_kind_name(PredictorKind kind);
+
+struct BranchPredictorConfig {
+    PredictorKind kind = PredictorKind::NotTaken;
+    unsigned tableBits = 10;        // 2^tableBits contadores por tabela
+    unsigned historyBits = 8;       // histórico global (gshare/tournament), <= tableBits
+    unsigned btbEntries = 64;       // potência de 2 (0 desliga a BTB)
+    unsigned rasEntries = 8;        // 0 desliga a RAS
+    unsigned mispredictPenalty = 0; // ciclos de Fetch parado além da bolha do flush
+};
+
+enum class BranchKind : uint8_t { None, Conditional, Jump, Call, Return };
+
+constexpr BranchKind branch_kind_of(isa::Op op) {
+    switch (op) {
+        case isa::Op::BEQ: case isa::Op::BNE: case isa::Op::BGT: case isa::Op::BLT:
+            return BranchKind::Conditional;
+        case isa::Op::J:   return BranchKind::Jump;
+        case isa::Op::JAL: return BranchKind::Call;
+        case isa::Op::JR:  return BranchKind::Return;
+        default:           return BranchKind::None;
+    }
+}
+
+// O que a busca previu, guardado com a instrução até o EX
+struct Prediction {
+    uint32_t nextPC = 0;
+    bool taken = false;
+    bool btbHit = false;
+    bool bimodalTaken = false;   // votos do tournament
+    bool gshareTaken = false;
+    uint32_t history = 0;        // histórico global antes desta previsão
+    uint32_t rasTop = 0;         // topo da RAS antes desta previsão
+};
+
+class BranchPredictor {
+public:
+    BranchPredictor() : BranchPredictor(BranchPredictorConfig{}) {}
+    explicit BranchPredictor(const BranchPredictorConfig &config);
+
+    const BranchPredictorConfig &config() const { return cfg; }
+
+    Prediction predict(uint32_t pc);
+    // Resultado real do EX. Retorna true se a previsão estava errada.
+    bool update(uint32_t pc, isa::Op op, const Prediction &prediction, bool taken, uint32_t target);
+
+    // Aquecimento funcional (núcleo rápido): prevê e treina de uma vez
+    void warm(uint32_t pc, isa::Op op, bool taken, uint32_t target) {
+        update(pc, op, predict(pc), taken, target);
+    }
+
+    // Checkpoint (cpu/checkpoint): configuração e todas as tabelas
+    void saveState(std::ostream &out) const;
+    void loadState(std::istream &in);
+
+private:
+    struct BtbEntry {
+        bool valid = false;
+        BranchKind kind = BranchKind::None;
+        uint32_t tag = 0;
+        uint32_t target = 0;
+    };
+
+    bool directionFor(uint32_t pc, uint32_t target, uint32_t hist, Prediction &p) const;
+    void train(uint32_t pc, const Prediction &p, bool taken);
+    uint32_t pcIndex(uint32_t pc) const { return (pc >> 2) & tableMask; }
+    uint32_t gshareIndex(uint32_t pc, uint32_t history) const { return ((pc >> 2) ^ history) & tableMask; }
+
+    BranchPredictorConfig cfg;
+    uint32_t tableMask = 0;
+    uint32_t historyMask = 0;
+    uint32_t history = 0;
+    std::vector<uint8_t> bimodal;   // contadores de 2 bits (0..3, >= 2 desvia)
+    std::vector<uint8_t> gshare;
+    std::vector<uint8_t> chooser;   // >= 2 escolhe o gshare
+    std::vector<BtbEntry> btb;
+    std::vector<uint32_t> ras;      // pilha circular
+    uint32_t rasTop = 0;            // quantidade empilhada (mod tamanho indexa o topo)
+};
+
+#endif // BRANCH_PREDICTOR_HPP
@@ -15,14 +15,49 @@
 #include <vector>
 #include <fstream>
 #include <mutex>
+#include <atomic>
+#include <limits>
 
 static std::mutex log_mutex;
+static std::atomic<bool> coreTrace{true};
+
+void setCoreTrace(bool enabled) { coreTrace = enabled; }
+bool coreTraceEnabled() { return coreTrace; }
+
+// Ajustado antes de a simulação começar (linha de comando)
+static PipelineConfig pipelineModel;
+
+void setPipelineConfig(const PipelineConfig &config) { pipelineModel = config; }
+PipelineConfig pipelineConfig() { return pipelineModel; }
+
+static constexpr const char *UNIT_NAMES[UNIT_COUNT] = {"alu", "mul", "div", "mem"};
+
+UnitKind unit_of(isa::LatencyClass latency) {
+    switch (latency) {
+        case isa::LatencyClass::Mul:   return UnitKind::Multiplier;
+        case isa::LatencyClass::Div:   return UnitKind::Divider;
+        case isa::LatencyClass::Load:
+        case isa::LatencyClass::Store: return UnitKind::LoadStore;
+        default:                       return UnitKind::Alu;
+    }
+}
+
+UnitKind unit_kind_from_string(const std::string &name) {
+    for (unsigned i = 0; i < UNIT_COUNT; ++i)
+        if (name == UNIT_NAMES[i]) return static_cast<UnitKind>(i);
+    throw std::invalid_argument("Unidade funcional desconhecida: " + name + " (alu, mul, div ou mem)");
+}
+
+const char *unit_kind_name(UnitKind kind) {
+    return UNIT_NAMES[static_cast<unsigned>(kind)];
+}
 
 
 
 using namespace std;
 
 void Control_Unit::log_operation(const std::string &msg) {
+    if (!coreTrace) return;
     std::lock_guard<std::mutex> lock(log_mutex);
 
     // Imprime no console
@@ -98,116 +133,125 @@ string Control_Unit::Get_source_Register(const uint32_t instruction) {
 
 string Control_Unit::Identificacao_instrucao(uint32_t instruction, hw::REGISTER_BANK &registers) {
     (void)registers; // evita warning
-    uint32_t opcode = (instruction >> 26) & 0x3Fu;
-    std::string opcode_bin = toBinStr(opcode, 6);
-
-    // Se existir mapa textual (instructionMap), mantenha compatibilidade
-    for (const auto &p : instructionMap) {
-        if (p.second == opcode_bin) {
-            std::string key = p.first;
-            for (auto &c : key) c = toupper(c);
-            return key;
-        }
-    }
+    // Uma consulta à tabela ISA (a mesma usada pelo montador)
+    const isa::InstrDesc *desc = isa::decode(instruction);
+    if (!desc) return ""; // desconhecido
 
-    // Tratamento por opcode numérico (MIPS-like / convenções comuns)
-    switch (opcode) {
-        case 0x00: { // R-type: usa funct
-            uint32_t funct = instruction & 0x3Fu;
-            if (funct == 0x20) return "ADD";
-            if (funct == 0x22) return "SUB";
-            if (funct == 0x18) return "MULT";
-            if (funct == 0x1A) return "DIV";
-            // não reconhecido -> vazio
-            return "";
-        }
-        case 0x02: return "J";        // jump
-        case 0x03: return "JAL";
-        case 0x04: return "BEQ";
-        case 0x05: return "BNE";
-        case 0x08: return "ADDI";     // 001000
-        case 0x09: return "ADDIU";    // 001001
-        case 0x0F: return "LUI";      // 001111
-        case 0x0C: return "ANDI";     // 001100 (opcional)
-        case 0x0A: return "SLTI";     // 001010 (opcional)
-        case 0x23: return "LW";       // 100011
-        case 0x2B: return "SW";       // 101011
-        case 0x0E: return "LI";       // custom LI, se usado
-        case 0x10: return "PRINT";    // custom PRINT opcode, ajuste se necessário
-        case 0x3F: return "END";      // sentinel/END (se aplicável)
-        default:
-            return ""; // desconhecido
-    }
+    std::string key(desc->mnemonic);
+    for (auto &c : key) c = toupper(c);
+    return key;
 }
 
-void Control_Unit::Fetch(ControlContext &context) {
+void Control_Unit::Fetch(ControlContext &context, Instruction_Data &slot) {
     account_stage(context.process);
+    slot.fetched = true;
+    slot.address = context.registers.pc.value;
     // MAR <- PC
     context.registers.mar.write(context.registers.pc.value);
     // Read memory at MAR (endereçamento em bytes presunção: PC em bytes)
     uint32_t instr = context.memManager.read(context.registers.mar.read(), context.process);
+    // Código reescrito por um sw que ainda está no store buffer
+    if (const Buffered_Store *buffered = Buffered_Value(slot.address)) instr = buffered->value;
     context.registers.ir.write(instr);
+    slot.rawInstruction = instr; // com várias buscas por ciclo, o IR fica com a última
 
     // === TRACE FETCH ===
-    std::cout << "[FETCH] PC=" << context.registers.pc.value
-              << " MAR=" << context.registers.mar.read()
-              << " INSTR=0x" << std::hex << instr << std::dec
-              << " (" << toBinStr(instr, 32) << ")\n";
+    if (coreTrace) {
+        std::cout << "[FETCH] PC=" << context.registers.pc.value
+                  << " MAR=" << context.registers.mar.read()
+                  << " INSTR=0x" << std::hex << instr << std::dec
+                  << " (" << toBinStr(instr, 32) << ")\n";
+    }
 
-    const uint32_t END_SENTINEL = 0b11111100000000000000000000000000u;
-    if (instr == END_SENTINEL) {
+    if (instr == isa::END_WORD) {
         context.endProgram = true;
         return;
     }
-    // PC <- PC + 4 (endereçamento por byte)
-    context.registers.pc.write(context.registers.pc.value + 4);
+    // PC <- próximo previsto (PC + 4 sem acerto na BTB; endereçamento por byte)
+    slot.prediction = context.process.branchPredictor.predict(slot.address);
+    context.registers.pc.write(slot.prediction.nextPC);
+}
+
+// Pares que o decodificador funde numa só operação: slti ou addi seguido de
+// um desvio condicional que lê o resultado (comparação e desvio, contador de
+// laço) e sll seguido de ori no mesmo registrador (constante de 32 bits; a
+// ISA não tem lui).
+bool Control_Unit::Fusible(uint32_t head, uint32_t tail) {
+    const isa::InstrDesc *first = isa::decode(head);
+    const isa::InstrDesc *second = isa::decode(tail);
+    if (!first || !second) return false;
+    const isa::RegisterUse a = isa::registerUse(*first, head);
+    const isa::RegisterUse b = isa::registerUse(*second, tail);
+    if (a.dst == 0) return false;
+    switch (first->op) {
+        case isa::Op::SLTI:
+        case isa::Op::ADDI:
+            return second->latency == isa::LatencyClass::Branch && (b.src1 == a.dst || b.src2 == a.dst);
+        case isa::Op::SLL:
+            return second->op == isa::Op::ORI && b.src1 == a.dst && b.dst == a.dst;
+        default:
+            return false;
+    }
+}
+
+// Depois de buscar group.back(): se a instrução seguinte forma um par com
+// ela, é buscada agora e vai na mesma posição do grupo
+void Control_Unit::Fetch_Fused(ControlContext &context, vector<Instruction_Data> &group) {
+    const Instruction_Data &head = group.back();
+    if (context.endProgram || head.fused || head.prediction.nextPC != head.address + 4) return;
+    uint32_t next = context.memManager.peek(head.address + 4);
+    if (const Buffered_Store *buffered = Buffered_Value(head.address + 4)) next = buffered->value;
+    if (!Fusible(head.rawInstruction, next)) return;
+
+    group.emplace_back();
+    group.back().fused = true;
+    if (coreTrace) std::cout << "[FETCH] macro-fusao com PC=" << head.address << "\n";
+    Fetch(context, group.back());
 }
 
 void Control_Unit::Decode(hw::REGISTER_BANK &registers, Instruction_Data &data) {
-    uint32_t instruction = registers.ir.read();
-    data.rawInstruction = instruction;
+    const uint32_t instruction = data.rawInstruction;
+    data.bubble = false;
+
+    const isa::InstrDesc *desc = isa::decode(instruction);
+    data.kind = desc ? desc->op : isa::Op::INVALID;
     data.op = Identificacao_instrucao(instruction, registers);
 
-    // R-type
-    if (data.op == "ADD" || data.op == "SUB" || data.op == "MULT" || data.op == "DIV") {
-        data.source_register = Get_source_Register(instruction);
-        data.target_register = Get_target_Register(instruction);
-        data.destination_register = Get_destination_Register(instruction);
-
-    // I-type: ADDI, ADDIU, LI, LW, LA, SW, and branches / custom immediates
-    } else if (data.op == "ADDI" || data.op == "ADDIU" ||
-               data.op == "LI" || data.op == "LW" || data.op == "LA" || data.op == "SW" ||
-               data.op == "BGTI" || data.op == "BLTI" || data.op == "BEQ" || data.op == "BNE" ||
-               data.op == "BGT"  || data.op == "BLT" || data.op == "SLTI" || data.op == "LUI") {
-
-        data.source_register = Get_source_Register(instruction);   // rs
-        data.target_register = Get_target_Register(instruction);   // rt (destino para ADDI/LW)
-        data.addressRAMResult = Get_immediate(instruction);
-        uint16_t imm16 = static_cast<uint16_t>(instruction & 0xFFFFu);
-        data.immediate = signExtend16(imm16);
-
-    } else if (data.op == "J") {
-        uint32_t instr26 = instruction & 0x03FFFFFFu;
-        data.addressRAMResult = std::bitset<26>(instr26).to_string();
-        data.immediate = static_cast<int32_t>(instr26);
-    } else if (data.op == "PRINT") {
-        data.target_register = Get_target_Register(instruction);
-        std::string imm = Get_immediate(instruction);
-        bool allZero = true;
-        for (char c : imm) if (c != '0') { allZero = false; break; }
-        if (!allZero) {
-            data.addressRAMResult = imm;
-            uint16_t imm16 = static_cast<uint16_t>(binaryStringToUint(imm));
-            data.immediate = signExtend16(imm16);
-        } else {
-            data.addressRAMResult.clear();
-            data.immediate = 0;
+    if (desc) {
+        data.regs = isa::registerUse(*desc, instruction);
+        switch (desc->format) {
+            case isa::Format::R:
+                data.source_register = Get_source_Register(instruction);
+                data.target_register = Get_target_Register(instruction);
+                data.destination_register = Get_destination_Register(instruction);
+                data.immediate = static_cast<int32_t>(isa::shamtOf(instruction));
+                break;
+
+            case isa::Format::I:
+                data.source_register = Get_source_Register(instruction);   // rs
+                data.target_register = Get_target_Register(instruction);   // rt (destino para ADDI/LW)
+                data.addressRAMResult = Get_immediate(instruction);
+                data.immediate = signExtend16(static_cast<uint16_t>(instruction & 0xFFFFu));
+                break;
+
+            case isa::Format::J: {
+                uint32_t instr26 = isa::targetOf(instruction);
+                data.addressRAMResult = std::bitset<26>(instr26).to_string();
+                data.immediate = static_cast<int32_t>(instr26);
+                break;
+            }
+
+            case isa::Format::V: // registradores vetoriais, lidos direto da palavra
+                break;
         }
+        data.lanes = desc->lanes;
     }
 
     // === TRACE DECODE ===
+    if (!coreTrace) return;
     std::cout << "[DECODE] RAW=0x" << std::hex << data.rawInstruction << std::dec
-              << " OP=" << (data.op.empty() ? "<UNKNOWN>" : data.op) << "\n";
+              << " OP=" << (data.op.empty() ? "<UNKNOWN>" : data.op)
+              << " ASM=\"" << isa::disassemble(instruction, data.address) << "\"\n";
     if (!data.source_register.empty()) {
         std::cout << "         rs(bits)=" << data.source_register
                   << " name=" << this->map.getRegisterName(binaryStringToUint(data.source_register)) << "\n";
@@ -233,237 +277,616 @@ void Control_Unit::Execute_Immediate_Operation(hw::REGISTER_BANK &registers, Ins
 
     int32_t val_rs = registers.readRegister(name_rs);
     int32_t imm = data.immediate; // já sign-extended
+    uint32_t uimm = static_cast<uint16_t>(imm); // andi/ori usam o imediato sem sinal
 
     std::ostringstream ss;
+    ALU alu;
+    alu.A = val_rs;
 
-    // ADDI / ADDIU
-    if (data.op == "ADDI" || data.op == "ADDIU") {
-        ALU alu;
-        alu.A = val_rs;
-        alu.B = imm;
-        alu.op = ADD;
-        alu.calculate();
-        registers.writeRegister(name_rt, alu.result);
-
-        ss << "[IMM] " << data.op << " "
-           << name_rt << " = " << name_rs << "(" << val_rs << ") + "
-           << imm << " -> " << alu.result;
-        log_operation(ss.str());
-        return;
+    switch (data.kind) {
+        case isa::Op::ADDI: alu.B = imm;  alu.op = ADD;    break;
+        case isa::Op::ANDI: alu.B = uimm; alu.op = AND_OP; break;
+        case isa::Op::ORI:  alu.B = uimm; alu.op = OR_OP;  break;
+        case isa::Op::SLTI: {
+            int32_t res = (val_rs < imm) ? 1 : 0;
+            registers.writeRegister(name_rt, res);
+
+            ss << "[IMM] SLTI " << name_rt << " = (" << name_rs << "(" << val_rs
+               << ") < " << imm << ") ? 1 : 0 -> " << res;
+            log_operation(ss.str());
+            return;
+        }
+        default:
+            // Caso não mapeado
+            ss << "[IMM] UNKNOWN OP: " << data.op
+               << " rs=" << name_rs << " imm=" << imm;
+            log_operation(ss.str());
+            return;
     }
 
-    // SLTI
-    if (data.op == "SLTI") {
-        int32_t res = (val_rs < imm) ? 1 : 0;
-        registers.writeRegister(name_rt, res);
+    alu.calculate();
+    registers.writeRegister(name_rt, alu.result);
 
-        ss << "[IMM] SLTI " << name_rt << " = (" << name_rs << "(" << val_rs
-           << ") < " << imm << ") ? 1 : 0 -> " << res;
-        log_operation(ss.str());
-        return;
+    ss << "[IMM] " << data.op << " "
+       << name_rt << " = " << name_rs << "(" << val_rs << ") " << data.op << " "
+       << static_cast<int32_t>(alu.B) << " -> " << alu.result;
+    log_operation(ss.str());
+}
+
+// Hazard RAW de uma instrução do grupo em Decode (counter - 1) com os grupos
+// que estão em EX (counter - 2) e MEM (counter - 3) neste ciclo: no próximo
+// ciclo ela estaria no EX com esses dois em MEM e WB. O grupo em WB agora
+// escreve no banco antes da leitura (meio ciclo cada) e nunca causa espera.
+// Sem espera, devolve em exEx/memEx os operandos adiantados.
+Hazard Control_Unit::Data_Hazard(ControlContext &context, const PipelineConfig &config,
+                                 const Instruction_Data &consumer, unsigned &exEx, unsigned &memEx) const {
+    auto writes = [](const Instruction_Data &p, uint8_t reg) {
+        return !p.bubble && (p.regs.dst == reg || (isa::isHiLo(reg) && isa::writesHiLo(p.kind)));
+    };
+    // A escrita mais nova do grupo é a que vale
+    auto producer = [&](int distance, uint8_t reg) -> const Instruction_Data * {
+        const int index = context.counter - 1 - distance;
+        if (index < 0) return nullptr;
+        const Instruction_Data *found = nullptr;
+        for (const Instruction_Data &p : data[index].slots)
+            if (writes(p, reg)) found = &p;
+        return found;
+    };
+
+    for (uint8_t reg : {consumer.regs.src1, consumer.regs.src2}) {
+        if (reg == 0) continue;
+        if (const Instruction_Data *inEx = producer(1, reg)) {
+            // lw só tem o valor no fim do MEM; a ULA já no fim do EX
+            if (isa::isLoad(inEx->kind)) return Hazard::LoadUse;
+            if (!config.forwardExEx) return Hazard::Raw;
+            exEx++;
+        } else if (const Instruction_Data *inMem = producer(2, reg)) {
+            if (!config.forwardMemEx) return isa::isLoad(inMem->kind) ? Hazard::LoadUse : Hazard::Raw;
+            memEx++;
+        }
     }
+    return Hazard::None;
+}
 
-    // LUI
-    if (data.op == "LUI") {
-        uint32_t uimm = static_cast<uint32_t>(static_cast<uint16_t>(imm));
-        int32_t val = static_cast<int32_t>(uimm << 16);
-        registers.writeRegister(name_rt, val);
+// Placar das unidades funcionais: a instrução em Decode entraria no EX no
+// próximo ciclo. Espera se um operando ainda está sendo calculado por uma
+// unidade de várias etapas (ou se terminaria antes de uma escrita mais antiga
+// no mesmo registrador) e se a unidade não aceita outra operação ainda.
+Hazard Control_Unit::Unit_Hazard(const Instruction_Data &d, const PipelineConfig &config) const {
+    const isa::InstrDesc *desc = isa::decode(d.rawInstruction);
+    if (!desc) return Hazard::None;
+    const UnitKind kind = unit_of(desc->latency);
+    const int issue = cycle + 1;
+    const int ready = issue + static_cast<int>(config.unit(kind).latency) + (isa::isLoad(d.kind) ? 1 : 0);
+
+    for (uint8_t reg : {d.regs.src1, d.regs.src2})
+        if (reg != 0 && resultReady[reg] > issue) return Hazard::UnitLatency;
+    if (d.regs.dst != 0 && resultReady[d.regs.dst] > ready) return Hazard::UnitLatency;
+    if (isa::writesHiLo(d.kind) && (resultReady[isa::REG_HI] > ready || resultReady[isa::REG_LO] > ready))
+        return Hazard::UnitLatency;
+    if (unitFree[static_cast<unsigned>(kind)] > issue) return Hazard::UnitBusy;
+    return Hazard::None;
+}
 
-        ss << "[IMM] LUI " << name_rt << " = (0x" << std::hex << imm
-           << " << 16) -> 0x" << val << std::dec;
-        log_operation(ss.str());
-        return;
+// Regras de emparelhamento: group.slots[slot] sai no mesmo ciclo que as mais
+// antigas do grupo? Não se ler ou escrever o que uma delas escreve, se
+// escrever a base ou o dado de um lw/sw anterior (lidos só no MEM), se usar
+// uma unidade que não seja a ULA já usada no grupo ou se vier depois de um
+// desvio (o desvio é sempre o último a sair). A segunda metade de um par
+// fundido não depende da primeira: as duas são uma operação só.
+Hazard Control_Unit::Pairing(const vector<Instruction_Data> &group, size_t slot) {
+    const Instruction_Data &d = group[slot];
+    const isa::InstrDesc *desc = isa::decode(d.rawInstruction);
+    const UnitKind kind = desc ? unit_of(desc->latency) : UnitKind::Alu;
+    auto writes = [](const Instruction_Data &p, uint8_t reg) {
+        return reg != 0 && (p.regs.dst == reg || (isa::isHiLo(reg) && isa::writesHiLo(p.kind)));
+    };
+    for (size_t i = 0; i < slot; ++i) {
+        if (d.fused && i + 1 == slot) continue;
+        const Instruction_Data &older = group[i];
+        if (branch_kind_of(older.kind) != BranchKind::None) return Hazard::SlotStructural;
+        const bool memory = isa::accessesMemory(older.kind);
+        if (writes(older, d.regs.src1) || writes(older, d.regs.src2) || writes(older, d.regs.dst) ||
+            (isa::writesHiLo(older.kind) && isa::writesHiLo(d.kind)) ||
+            (memory && d.regs.dst != 0 && (d.regs.dst == older.regs.src1 || d.regs.dst == older.regs.src2)))
+            return Hazard::SlotDependency;
+        const isa::InstrDesc *olderDesc = isa::decode(older.rawInstruction);
+        if (kind != UnitKind::Alu && olderDesc && unit_of(olderDesc->latency) == kind) return Hazard::SlotStructural;
     }
+    return Hazard::None;
+}
 
-    // LI
-    if (data.op == "LI") {
-        registers.writeRegister(name_rt, imm);
+// Quantas instruções do grupo em Decode entram no EX no próximo ciclo: o
+// maior prefixo sem hazard (um par fundido sai inteiro ou fica inteiro). Se
+// nem a primeira sai, o ciclo conta como parado pela causa dela; senão a
+// causa só separa o grupo. As que saem vão para o placar.
+unsigned Control_Unit::Select_Issue(ControlContext &context, const PipelineConfig &config) {
+    const vector<Instruction_Data> &slots = data[context.counter - 1].slots;
+    PCB &process = context.process;
+    unsigned issued = 0, exEx = 0, memEx = 0;
+    Hazard hazard = Hazard::None;
+    while (issued < slots.size()) {
+        const unsigned size = issued + 1 < slots.size() && slots[issued + 1].fused ? 2 : 1;
+        unsigned slotExEx = 0, slotMemEx = 0;
+        for (unsigned i = issued; i < issued + size && hazard == Hazard::None; ++i) {
+            hazard = Pairing(slots, i);
+            if (hazard == Hazard::None) hazard = Data_Hazard(context, config, slots[i], slotExEx, slotMemEx);
+            if (hazard == Hazard::None) hazard = Unit_Hazard(slots[i], config);
+        }
+        if (hazard != Hazard::None) break;
+        exEx += slotExEx;
+        memEx += slotMemEx;
+        issued += size;
+    }
 
-        ss << "[IMM] LI " << name_rt << " = " << imm;
-        log_operation(ss.str());
-        return;
+    if (issued == 0) {
+        switch (hazard) {
+            case Hazard::Raw:         process.stall_raw_cycles.fetch_add(1);        break;
+            case Hazard::LoadUse:     process.stall_load_use_cycles.fetch_add(1);   break;
+            case Hazard::UnitLatency: process.stall_fu_latency_cycles.fetch_add(1); break;
+            case Hazard::UnitBusy:    process.stall_fu_busy_cycles.fetch_add(1);    break;
+            default:                                                                break;
+        }
+    } else if (hazard == Hazard::UnitBusy || hazard == Hazard::SlotStructural) {
+        process.issue_split_structural.fetch_add(1);
+    } else if (hazard != Hazard::None) {
+        process.issue_split_dependency.fetch_add(1);
     }
 
-    // Caso não mapeado
-    ss << "[IMM] UNKNOWN OP: " << data.op
-       << " rs=" << name_rs << " imm=" << imm;
-    log_operation(ss.str());
+    for (unsigned i = 0; i < issued; ++i) Issue(slots[i], config);
+    if (exEx) process.forwards_ex_ex.fetch_add(exEx);
+    if (memEx) process.forwards_mem_ex.fetch_add(memEx);
+    return issued;
+}
+
+// Registra no placar a instrução que sai do Decode neste ciclo
+void Control_Unit::Issue(const Instruction_Data &d, const PipelineConfig &config) {
+    const isa::InstrDesc *desc = isa::decode(d.rawInstruction);
+    if (!desc) return;
+    const UnitKind kind = unit_of(desc->latency);
+    const FunctionalUnit &unit = config.unit(kind);
+    const int issue = cycle + 1;
+    // lw: o valor sai do MEM, um estágio depois do EX
+    const int ready = issue + static_cast<int>(unit.latency) + (isa::isLoad(d.kind) ? 1 : 0);
+    if (d.regs.dst != 0) resultReady[d.regs.dst] = ready;
+    if (isa::writesHiLo(d.kind)) resultReady[isa::REG_HI] = resultReady[isa::REG_LO] = ready;
+    unitFree[static_cast<unsigned>(kind)] = issue + static_cast<int>(unit.interval);
 }
 
 void Control_Unit::Execute_Aritmetic_Operation(hw::REGISTER_BANK &registers, Instruction_Data &data) {
     std::string name_rs = this->map.getRegisterName(binaryStringToUint(data.source_register));
     std::string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
-    std::string name_rd = this->map.getRegisterName(binaryStringToUint(data.target_register));
+    std::string name_rd = this->map.getRegisterName(binaryStringToUint(data.destination_register));
 
     int32_t val_rs = registers.readRegister(name_rs);
     int32_t val_rt = registers.readRegister(name_rt);
 
+    if (data.kind == isa::Op::MFHI || data.kind == isa::Op::MFLO) {
+        const bool high = data.kind == isa::Op::MFHI;
+        const uint32_t value = (high ? registers.hi : registers.lo).read();
+        registers.writeRegister(name_rd, value);
+
+        std::ostringstream ss;
+        ss << "[ARIT] " << data.op << " " << name_rd << " = " << (high ? "hi" : "lo")
+           << "(" << static_cast<int32_t>(value) << ")";
+        log_operation(ss.str());
+        return;
+    }
+
     ALU alu;
     alu.A = val_rs;
     alu.B = val_rt;
 
-    if (data.op == "ADD") alu.op = ADD;
-    else if (data.op == "SUB") alu.op = SUB;
-    else if (data.op == "MULT") alu.op = MUL;
-    else if (data.op == "DIV") alu.op = DIV;
-    else return;
+    switch (data.kind) {
+        case isa::Op::ADD:  alu.op = ADD;    break;
+        case isa::Op::SUB:  alu.op = SUB;    break;
+        case isa::Op::AND:  alu.op = AND_OP; break;
+        case isa::Op::OR:   alu.op = OR_OP;  break;
+        case isa::Op::MULT: alu.op = MUL;    break;
+        case isa::Op::DIV:  alu.op = DIV;    break;
+        // Shifts: rd = rt << shamt
+        case isa::Op::SLL:  alu.op = SLL; alu.A = val_rt; alu.B = data.immediate; break;
+        case isa::Op::SRL:  alu.op = SRL; alu.A = val_rt; alu.B = data.immediate; break;
+        default: return;
+    }
 
     alu.calculate();
     registers.writeRegister(name_rd, alu.result);
 
+    // Como no MIPS, mult deixa o produto de 64 bits em HI:LO e div o
+    // quociente em LO e o resto em HI (divisor zero: resto = dividendo)
+    if (data.kind == isa::Op::MULT) {
+        const uint64_t product = static_cast<uint64_t>(int64_t(val_rs) * int64_t(val_rt));
+        registers.hi.write(static_cast<uint32_t>(product >> 32));
+        registers.lo.write(static_cast<uint32_t>(product));
+    } else if (data.kind == isa::Op::DIV) {
+        const bool overflow = val_rs == std::numeric_limits<int32_t>::min() && val_rt == -1;
+        const int32_t rest = val_rt == 0 ? val_rs : overflow ? 0 : val_rs % val_rt;
+        registers.hi.write(static_cast<uint32_t>(rest));
+        registers.lo.write(static_cast<uint32_t>(alu.result));
+    }
+
+    std::ostringstream ss;
+    if (data.kind == isa::Op::SLL || data.kind == isa::Op::SRL) {
+        ss << "[ARIT] " << data.op << " " << name_rd
+           << " = " << name_rt << "(" << val_rt << ") " << data.op << " " << data.immediate
+           << " = " << alu.result;
+    } else {
+        ss << "[ARIT] " << data.op << " " << name_rd
+           << " = " << name_rs << "(" << val_rs << ") "
+           << data.op << " " << name_rt << "(" << val_rt << ") = "
+           << alu.result;
+    }
+    log_operation(ss.str());
+}
+
+// vadd/vsub/vmul: lane a lane na ULA vetorial, $wd = $ws op $wt
+void Control_Unit::Execute_Vector_Operation(hw::REGISTER_BANK &registers, Instruction_Data &data) {
+    const uint32_t rd = isa::rdOf(data.rawInstruction) % isa::VECTOR_REGISTERS;
+    const uint32_t rs = isa::rsOf(data.rawInstruction) % isa::VECTOR_REGISTERS;
+    const uint32_t rt = isa::rtOf(data.rawInstruction) % isa::VECTOR_REGISTERS;
+    const operation op = data.kind == isa::Op::VADD ? ADD : data.kind == isa::Op::VSUB ? SUB : MUL;
+    vector_calculate(op, registers.w[rs].data(), registers.w[rt].data(), registers.w[rd].data(), data.lanes);
+
+    if (!coreTrace) return;
     std::ostringstream ss;
-    ss << "[ARIT] " << data.op << " " << name_rd
-       << " = " << name_rs << "(" << val_rs << ") "
-       << data.op << " " << name_rt << "(" << val_rt << ") = "
-       << alu.result;
+    ss << "[VET] " << data.op << " " << isa::VECTOR_REGISTER_NAMES[rd] << " = "
+       << isa::VECTOR_REGISTER_NAMES[rs] << " " << data.op << " " << isa::VECTOR_REGISTER_NAMES[rt] << " = [";
+    for (unsigned i = 0; i < data.lanes; ++i) ss << (i ? ", " : "") << static_cast<int32_t>(registers.w[rd][i]);
+    ss << "]";
     log_operation(ss.str());
 }
 
 void Control_Unit::Execute_Operation(Instruction_Data &data, ControlContext &context) {
-    if (data.op == "PRINT") {
-        if (!data.target_register.empty()) {
-            string name = this->map.getRegisterName(binaryStringToUint(data.target_register));
-            int value = context.registers.readRegister(name);
-            auto req = std::make_unique<IORequest>();
-            req->msg = std::to_string(value);
-            req->process = &context.process;
-            context.ioRequests.push_back(std::move(req));
-
-            // TRACE PRINT from register
+    if (data.kind == isa::Op::PRINT) {
+        string name = this->map.getRegisterName(binaryStringToUint(data.target_register));
+        int value = context.registers.readRegister(name);
+        auto req = std::make_unique<IORequest>();
+        req->msg = std::to_string(value);
+        req->process = &context.process;
+        context.ioRequests.push_back(std::move(req));
+
+        // TRACE PRINT from register
+        if (coreTrace) {
             std::cout << "[PRINT-REQ] PRINT REG " << name << " value=" << value
                       << " (pid=" << context.process.pid << ")\n";
+        }
 
-            if (context.printLock) {
-                context.process.state = State::Blocked;
-                context.endExecution = true;
-            }
+        if (context.printLock) {
+            context.process.state = State::Blocked;
+            context.endExecution = true;
         }
     }
 }
 
-void Control_Unit::Execute_Loop_Operation(hw::REGISTER_BANK &registers, Instruction_Data &data,
-                                          int &counter, int &counterForEnd, bool &programEnd,
-                                          MemoryManager &memManager, PCB &process) {
+void Control_Unit::Execute_Loop_Operation(Instruction_Data &data, ControlContext &context) {
+    hw::REGISTER_BANK &registers = context.registers;
     string name_rs = this->map.getRegisterName(binaryStringToUint(data.source_register));
     string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
 
     ALU alu;
-    alu.A = registers.readRegister(name_rs);
-    alu.B = registers.readRegister(name_rt);
-
     bool jump = false;
-    if (data.op == "BEQ") { alu.op = BEQ; alu.calculate(); if (alu.result == 1) jump = true; }
-    else if (data.op == "BNE") { alu.op = BNE; alu.calculate(); if (alu.result == 1) jump = true; }
-    else if (data.op == "J") { jump = true; }
-    else if (data.op == "BLT") { alu.op = BLT; alu.calculate(); if (alu.result == 1) jump = true; }
-    else if (data.op == "BGT") { alu.op = BGT; alu.calculate(); if (alu.result == 1) jump = true; }
-
-    if (jump) {
-        uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        // TRACE BRANCH/JUMP
+    uint32_t addr = isa::branchTarget(data.address, data.rawInstruction);
+
+    switch (data.kind) {
+        case isa::Op::BEQ: alu.op = BEQ; break;
+        case isa::Op::BNE: alu.op = BNE; break;
+        case isa::Op::BLT: alu.op = BLT; break;
+        case isa::Op::BGT: alu.op = BGT; break;
+        case isa::Op::J:
+            jump = true; addr = isa::targetOf(data.rawInstruction);
+            break;
+        case isa::Op::JAL:
+            jump = true; addr = isa::targetOf(data.rawInstruction);
+            registers.writeRegister("ra", data.address + 4);
+            break;
+        case isa::Op::JR:
+            jump = true; addr = registers.readRegister(name_rs);
+            break;
+        default: return;
+    }
+    if (!jump) {
+        alu.A = registers.readRegister(name_rs);
+        alu.B = registers.readRegister(name_rt);
+        alu.calculate();
+        jump = (alu.result == 1);
+    }
+
+    // TRACE BRANCH/JUMP
+    if (jump && coreTrace) {
         std::cout << "[BRANCH] OP=" << data.op << " taken, new PC=" << addr << "\n";
+    }
+    Resolve_Next_PC(data, context, jump, addr);
+}
+
+// Confere o PC previsto no Fetch com o real e treina o preditor
+void Control_Unit::Resolve_Next_PC(Instruction_Data &data, ControlContext &context, bool taken, uint32_t target) {
+    PCB &process = context.process;
+    const bool mispredicted = process.branchPredictor.update(data.address, data.kind, data.prediction, taken, target);
+    if (branch_kind_of(data.kind) != BranchKind::None) {
+        process.branch_predictions.fetch_add(1);
+        if (mispredicted) process.branch_mispredictions.fetch_add(1);
+    }
+    if (!mispredicted) return;
+
+    if (coreTrace) {
+        std::cout << "[BRANCH] mispredict at PC=" << data.address
+                  << " predicted=" << data.prediction.nextPC << "\n";
+    }
+
+    // Flush: a instrução buscada no caminho errado (agora em Decode) vira
+    // bolha e o próximo Fetch já busca o endereço certo, depois da penalidade.
+    context.registers.pc.write(taken ? target : data.address + 4);
+    context.branchTaken = true;
+    process.branch_flush_cycles.fetch_add(1);
+    fetchStall = process.branchPredictor.config().mispredictPenalty;
 
-        registers.pc.write(addr);
-        registers.ir.write(memManager.read(registers.pc.read(), process));
-        counter = 0; counterForEnd = 5; programEnd = false;
+    // Um END buscado no caminho errado não encerra o programa
+    if (context.endProgram) {
+        context.endProgram = false;
+        context.endExecution = false;
+        context.counterForEnd = 5;
     }
 }
 
 void Control_Unit::Execute(Instruction_Data &data, ControlContext &context) {
     account_stage(context.process);
 
-    // Immediates / I-type arithmetic
-    if (data.op == "ADDI" || data.op == "ADDIU" || data.op == "SLTI" || data.op == "LUI" || data.op == "LI") {
-        Execute_Immediate_Operation(context.registers, data);
-        return;
+    switch (data.kind) {
+        // Immediates / I-type arithmetic
+        case isa::Op::ADDI: case isa::Op::ANDI: case isa::Op::ORI: case isa::Op::SLTI:
+            Execute_Immediate_Operation(context.registers, data);
+            break;
+        // R-type
+        case isa::Op::ADD: case isa::Op::SUB: case isa::Op::AND: case isa::Op::OR:
+        case isa::Op::MULT: case isa::Op::DIV: case isa::Op::SLL: case isa::Op::SRL:
+        case isa::Op::MFHI: case isa::Op::MFLO:
+            Execute_Aritmetic_Operation(context.registers, data);
+            break;
+        case isa::Op::VADD: case isa::Op::VSUB: case isa::Op::VMUL:
+            Execute_Vector_Operation(context.registers, data);
+            break;
+        // Desvios e saltos
+        case isa::Op::BEQ: case isa::Op::BNE: case isa::Op::BGT: case isa::Op::BLT:
+        case isa::Op::J: case isa::Op::JAL: case isa::Op::JR:
+            Execute_Loop_Operation(data, context);
+            break;
+        case isa::Op::PRINT:
+            Execute_Operation(data, context);
+            break;
+        default:
+            break;
     }
+    // Instrução comum com entrada na BTB (código reescrito): confere a previsão
+    if (!data.bubble && data.prediction.btbHit && branch_kind_of(data.kind) == BranchKind::None)
+        Resolve_Next_PC(data, context, false, 0);
+}
+
+// Endereço efetivo de lw/sw: rs + offset
+static uint32_t effectiveAddress(Control_Unit &uc, Instruction_Data &data, hw::REGISTER_BANK &registers) {
+    string name_rs = uc.map.getRegisterName(binaryStringToUint(data.source_register));
+    ALU alu;
+    alu.execute(LW, registers.readRegister(name_rs), static_cast<uint32_t>(data.immediate));
+    return static_cast<uint32_t>(alu.result);
+}
+
+// Store mais novo do buffer no endereço, ou nullptr
+const Buffered_Store *Control_Unit::Buffered_Value(uint32_t address) const {
+    for (auto it = storeBuffer.rbegin(); it != storeBuffer.rend(); ++it)
+        if (it->address == address) return &*it;
+    return nullptr;
+}
+
+// Escreve na memória o store mais antigo do buffer (usa a porta de dados)
+void Control_Unit::Drain_Store(ControlContext &context) {
+    const Buffered_Store store = storeBuffer.front();
+    storeBuffer.pop_front();
+    context.memManager.write(store.address, store.value, context.process);
 
-    // R-type
-    if (data.op == "ADD" || data.op == "SUB" || data.op == "MULT" || data.op == "DIV") {
-        Execute_Aritmetic_Operation(context.registers, data);
-    } else if (data.op == "BEQ" || data.op == "J" || data.op == "BNE" || data.op == "BGT" || data.op == "BGTI" || data.op == "BLT" || data.op == "BLTI") {
-        Execute_Loop_Operation(context.registers, data, context.counter, context.counterForEnd, context.endProgram, context.memManager, context.process);
-    } else if (data.op == "PRINT") {
-        Execute_Operation(data, context);
+    if (coreTrace) {
+        std::cout << "[MEMORY] STORE BUFFER -> addr=" << store.address << " value=" << static_cast<int32_t>(store.value)
+                  << " (" << storeBuffer.size() << " no buffer)\n";
     }
 }
 
-void Control_Unit::Memory_Acess(Instruction_Data &data, ControlContext &context) {
+// Retorna true se usou a porta de dados da memória neste ciclo
+bool Control_Unit::Memory_Acess(Instruction_Data &data, ControlContext &context, const PipelineConfig &config) {
     account_stage(context.process);
-    string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
-    if (data.op == "LW") {
-        uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        int value = context.memManager.read(addr, context.process);
+    if (data.kind == isa::Op::LW) {
+        string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
+        uint32_t addr = effectiveAddress(*this, data, context.registers);
+        // Endereços exatos: o lw passa pelos stores de outros endereços e só
+        // pega do buffer o mais novo no mesmo endereço
+        const Buffered_Store *buffered = Buffered_Value(addr);
+        int value = buffered ? static_cast<int>(buffered->value) : context.memManager.read(addr, context.process);
         context.registers.writeRegister(name_rt, value);
+        if (buffered) context.process.loads_forwarded.fetch_add(1);
 
-        std::cout << "[MEMORY] LW addr=" << addr << " value=" << value
-                  << " -> " << name_rt << "\n";
-    } else if (data.op == "LA" || data.op == "LI") {
-        uint32_t val = binaryStringToUint(data.addressRAMResult);
-        context.registers.writeRegister(name_rt, static_cast<int>(val));
-
-        std::cout << "[MEMORY] " << data.op << " -> " << name_rt
-                  << " value=" << static_cast<int>(val) << "\n";
-    } else if (data.op == "PRINT" && data.target_register.empty()) {
-        uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        int value = context.memManager.read(addr, context.process);
-        auto req = std::make_unique<IORequest>();
-        req->msg = std::to_string(value);
-        req->process = &context.process;
-        context.ioRequests.push_back(std::move(req));
+        if (coreTrace) {
+            std::cout << "[MEMORY] LW addr=" << addr << " value=" << value
+                      << " -> " << name_rt << (buffered ? " (store buffer)" : "") << "\n";
+        }
+        return !buffered;
+    }
+    if (data.kind == isa::Op::SW) {
+        // Operandos lidos aqui, antes de o EX da instrução seguinte escrever
+        uint32_t addr = effectiveAddress(*this, data, context.registers);
+        string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
+        int value = context.registers.readRegister(name_rt);
+
+        if (coreTrace) {
+            std::cout << "[MEMORY] SW addr=" << addr << " value=" << value
+                      << " from reg " << name_rt << (config.storeBufferEntries ? " (store buffer)" : "") << "\n";
+        }
+        if (config.storeBufferEntries == 0) {
+            context.memManager.write(addr, value, context.process);
+            return true;
+        }
+        // Buffer cheio: o mais antigo sai agora, ocupando a porta
+        const bool full = storeBuffer.size() >= config.storeBufferEntries;
+        if (full) {
+            context.process.store_buffer_full_stalls.fetch_add(1);
+            Drain_Store(context);
+        }
+        storeBuffer.push_back({addr, static_cast<uint32_t>(value)});
+        return full;
+    }
+    if (isa::isAtomic(data.kind)) {
+        uint32_t addr = effectiveAddress(*this, data, context.registers);
+        string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
+        const uint32_t operand = context.registers.readRegister(name_rt);
+        // Barreira: os sw mais antigos chegam à memória (e às reservas) antes
+        while (!storeBuffer.empty()) Drain_Store(context);
+        const uint32_t value = context.memManager.atomic(data.kind, addr, operand, context.process, &context.process);
+        context.registers.writeRegister(name_rt, value);
 
-        std::cout << "[PRINT-REQ] PRINT MEM addr=" << addr << " value=" << value
-                  << " (pid=" << context.process.pid << ")\n";
+        if (coreTrace) {
+            std::cout << "[MEMORY] " << data.op << " addr=" << addr << " rt=" << static_cast<int>(operand)
+                      << " -> " << name_rt << "=" << static_cast<int>(value) << "\n";
+        }
+        return true;
+    }
+    if (data.kind == isa::Op::VLOAD) {
+        uint32_t addr = effectiveAddress(*this, data, context.registers);
+        hw::REGISTER_BANK::VECTOR &lanes = context.registers.w[isa::rtOf(data.rawInstruction) % isa::VECTOR_REGISTERS];
+        context.memManager.readVector(addr, lanes.data(), data.lanes, context.process);
+        // Palavras que ainda estão no store buffer vêm de lá
+        bool forwarded = false;
+        for (unsigned i = 0; i < data.lanes; ++i) {
+            if (const Buffered_Store *buffered = Buffered_Value(addr + 4 * i)) {
+                lanes[i] = buffered->value;
+                forwarded = true;
+            }
+        }
+        if (forwarded) context.process.loads_forwarded.fetch_add(1);
 
-        if (context.printLock) {
-            context.process.state = State::Blocked;
-            context.endExecution = true;
+        if (coreTrace) {
+            std::cout << "[MEMORY] VLOAD addr=" << addr << " lanes=" << unsigned(data.lanes) << " linhas="
+                      << MemoryManager::vectorLines(addr, data.lanes) << (forwarded ? " (store buffer)" : "") << "\n";
+        }
+        return true;
+    }
+    if (data.kind == isa::Op::VSTORE) {
+        uint32_t addr = effectiveAddress(*this, data, context.registers);
+        const hw::REGISTER_BANK::VECTOR &lanes = context.registers.w[isa::rtOf(data.rawInstruction) % isa::VECTOR_REGISTERS];
+        // O vstore não passa pelo store buffer: os sw mais antigos vão antes, em ordem
+        while (!storeBuffer.empty()) Drain_Store(context);
+        context.memManager.writeVector(addr, lanes.data(), data.lanes, context.process);
+
+        if (coreTrace) {
+            std::cout << "[MEMORY] VSTORE addr=" << addr << " lanes=" << unsigned(data.lanes) << " linhas="
+                      << MemoryManager::vectorLines(addr, data.lanes) << "\n";
         }
+        return true;
     }
+    return false;
 }
 
 void Control_Unit::Write_Back(Instruction_Data &data, ControlContext &context) {
     account_stage(context.process);
-    if (data.op == "SW") {
-        uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
-        int value = context.registers.readRegister(name_rt);
-        context.memManager.write(addr, value, context.process);
-
-        std::cout << "[WRITE-BACK] SW addr=" << addr << " value=" << value
-                  << " from reg " << name_rt << "\n";
+    if (!data.bubble) context.process.instructions_retired.fetch_add(1);
+    if (!data.bubble && data.fused) context.process.fused_pairs.fetch_add(1);
+    if (!data.bubble && isa::isVector(data.kind)) {
+        context.process.vector_instructions.fetch_add(1);
+        context.process.vector_lanes.fetch_add(data.lanes);
     }
 }
 
 // A função Core agora espera um ponteiro para o PCB, pois o PCB não é mais copiável
 void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock) {
     Control_Unit UC;
-    Instruction_Data data;
     int clock = 0;
     int counterForEnd = 5;
     int counter = 0;
     bool endProgram = false;
     bool endExecution = false;
+    bool branchTaken = false;
+    int drainStart = -1; // ciclo em que a busca parou de vez (-1: ainda buscando)
 
-    ControlContext context{ process.regBank, memoryManager, *ioRequests, printLock, process, counter, counterForEnd, endProgram, endExecution };
+    ControlContext context{ process.regBank, memoryManager, *ioRequests, printLock, process, counter, counterForEnd, endProgram, endExecution, branchTaken };
+    const PipelineConfig hazards = pipelineConfig();
+    const unsigned width = std::max(hazards.issueWidth, 1u);
+    if (process.issue_width_cycles.size() < width + 1) process.issue_width_cycles.resize(width + 1);
 
     while (context.counterForEnd > 0) {
+        context.branchTaken = false;
+        UC.cycle = clock;
         if (context.counter >= 4 && context.counterForEnd >= 1) {
-            UC.Write_Back(UC.data[context.counter - 4], context);
+            for (Instruction_Data &slot : UC.data[context.counter - 4].slots) UC.Write_Back(slot, context);
         }
+        bool dataPort = false; // o MEM usou a memória neste ciclo
         if (context.counter >= 3 && context.counterForEnd >= 2) {
-            UC.Memory_Acess(UC.data[context.counter - 3], context);
+            for (Instruction_Data &inMem : UC.data[context.counter - 3].slots)
+                if (UC.Memory_Acess(inMem, context, hazards)) dataPort = true;
         }
+        const bool memoryBusy = hazards.unifiedMemoryPort && dataPort;
         if (context.counter >= 2 && context.counterForEnd >= 3) {
-            UC.Execute(UC.data[context.counter - 2], context);
+            for (Instruction_Data &slot : UC.data[context.counter - 2].slots) {
+                // Depois de um desvio mal previsto, o resto do grupo é caminho errado
+                if (context.branchTaken) slot = Instruction_Data{};
+                else UC.Execute(slot, context);
+            }
+        }
+        // Flush: o grupo em Decode (inclusive o que sobrou de uma separação) vira bolha
+        if (context.branchTaken && context.counter >= 1 && context.counterForEnd >= 4) {
+            for (Instruction_Data &slot : UC.data[context.counter - 1].slots) slot = Instruction_Data{};
+        }
+        bool stalled = false;
+        unsigned issued = 0;
+        if (context.counter >= 1 && context.counterForEnd >= 4 && !context.branchTaken &&
+            UC.data[context.counter - 1].slots.front().fetched) {
+            // Depois de uma espera as instruções já estão decodificadas
+            for (Instruction_Data &slot : UC.data[context.counter - 1].slots) {
+                if (slot.bubble) {
+                    account_stage(process);
+                    UC.Decode(context.registers, slot);
+                }
+            }
+            const unsigned leavingSlots = UC.Select_Issue(context, hazards);
+            vector<Instruction_Data> &waiting = UC.data[context.counter - 1].slots;
+            // Um par fundido conta como uma instrução emitida
+            issued = static_cast<unsigned>(std::count_if(waiting.begin(), waiting.begin() + leavingSlots,
+                                                         [](const Instruction_Data &d) { return !d.fused; }));
+            if (leavingSlots < waiting.size()) {
+                // As que saem entram no EX (ou uma bolha); as outras ficam no Decode e o Fetch espera
+                Instruction_Group leaving;
+                if (leavingSlots > 0) {
+                    leaving.slots.assign(waiting.begin(), waiting.begin() + leavingSlots);
+                    waiting.erase(waiting.begin(), waiting.begin() + leavingSlots);
+                }
+                UC.data.insert(UC.data.begin() + (context.counter - 1), std::move(leaving));
+                stalled = true;
+            }
         }
-        if (context.counter >= 1 && context.counterForEnd >= 4) {
-            account_stage(process);
-            UC.Decode(context.registers, UC.data[context.counter - 1]);
+        process.issue_width_cycles[issued]++;
+        bool fetchPort = false; // o Fetch leu a memória neste ciclo
+        if (context.counter >= 0 && context.counterForEnd == 5 && !stalled) {
+            UC.data.emplace_back();
+            if (UC.fetchStall > 0) {
+                UC.fetchStall -= 1;
+                process.branch_flush_cycles.fetch_add(1);
+            } else if (memoryBusy) {
+                process.stall_structural_cycles.fetch_add(1);
+            } else {
+                fetchPort = true;
+                // Busca em sequência até a largura, parando no END e num desvio
+                // previsto como tomado. A segunda metade de um par fundido vem
+                // junto e não ocupa uma posição.
+                vector<Instruction_Data> &group = UC.data.back().slots;
+                UC.Fetch(context, group.front());
+                if (hazards.macroFusion) UC.Fetch_Fused(context, group);
+                for (unsigned fetched = 1; fetched < width && !context.endProgram &&
+                     group.back().prediction.nextPC == group.back().address + 4; ++fetched) {
+                    group.emplace_back();
+                    UC.Fetch(context, group.back());
+                    if (hazards.macroFusion) UC.Fetch_Fused(context, group);
+                }
+            }
         }
-        if (context.counter >= 0 && context.counterForEnd == 5) {
-            UC.data.push_back(data);
-            UC.Fetch(context);
+
+        // Porta de dados livre (e, numa porta só, sem busca): o store mais antigo vai para a memória
+        if (!UC.storeBuffer.empty() && !dataPort && !(hazards.unifiedMemoryPort && fetchPort)) {
+            UC.Drain_Store(context);
         }
 
         context.counter += 1;
@@ -473,17 +896,42 @@ void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IOReque
         if (clock >= process.quantum || context.endProgram == true) {
             context.endExecution = true;
         }
-        if (context.endExecution == true) {
+        // Um END no caminho errado desfaz o fim: a busca continua
+        if (!context.endExecution) drainStart = -1;
+        else if (drainStart < 0) drainStart = clock;
+        // No esvaziamento, uma instrução parada no Decode segura a contagem
+        if (context.endExecution == true && !(stalled && context.counterForEnd < 5)) {
             context.counterForEnd -= 1;
         }
     }
 
+    // Esvaziamento (PCB::pipeline_drain_cycles): os estágios depois da última
+    // busca e a espera pelas unidades funcionais. As escritas do store buffer
+    // não entram: uma execução contínua também as faria, tomando a porta.
+    int drainCycles = clock - drainStart;
+
+    // Antes de o processo deixar a CPU, o que sobrou no buffer vai para a memória, um por ciclo
+    while (!UC.storeBuffer.empty()) {
+        UC.Drain_Store(context);
+        account_pipeline_cycle(process);
+        clock += 1;
+    }
+
+    // O esvaziamento também espera as operações longas que ainda estão nas unidades
+    const int pending = *std::max_element(UC.resultReady.begin(), UC.resultReady.end()) - clock;
+    if (pending > 0) {
+        process.pipeline_cycles.fetch_add(static_cast<uint64_t>(pending));
+        process.stall_fu_latency_cycles.fetch_add(static_cast<uint64_t>(pending));
+        drainCycles += pending;
+    }
+    process.pipeline_drain_cycles.fetch_add(static_cast<uint64_t>(drainCycles));
+
     if (context.endProgram) {
         process.state = State::Finished;
     }
 
     // === DUMP FINAL DOS REGISTRADORES ===
-    {
+    if (coreTrace) {
         // nomes comuns de registradores MIPS como fallback
         const vector<string> fallback_names = {
             "zero","at","v0","v1","a0","a1","a2","a3",
@@ -4,12 +4,16 @@
 #include "REGISTER_BANK.hpp" // Incluído diretamente para ter a definição completa
 #include "ULA.hpp"
 #include "HASH_REGISTER.hpp"
+#include "ISA.hpp"
+#include "BRANCH_PREDICTOR.hpp"
 #include "../memory/cache.hpp"
 #include <unordered_map>
 #include <string>
 #include <vector>
 #include <cstdint>
 #include <memory>
+#include <array>
+#include <deque>
 
 using std::string;
 using std::vector;
@@ -23,14 +27,94 @@ struct IORequest;
 
 void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock);
 
+// Liga/desliga o trace do pipeline (console e output/temp_*.log). Os modos que
+// chamam Core() muitas vezes (lockstep, amostragem) rodam sem trace.
+void setCoreTrace(bool enabled);
+bool coreTraceEnabled();
+
+// Desliga o trace enquanto existir
+struct QuietCore {
+    bool previous;
+    QuietCore() : previous(coreTraceEnabled()) { setCoreTrace(false); }
+    ~QuietCore() { setCoreTrace(previous); }
+};
+
+// Unidades funcionais do EX. Uma operação fica 'latency' ciclos na unidade
+// antes de o resultado poder ser adiantado e a unidade aceita outra a cada
+// 'interval' ciclos (interval == latency: unidade não segmentada).
+enum class UnitKind : uint8_t { Alu, Multiplier, Divider, LoadStore };
+inline constexpr unsigned UNIT_COUNT = 4;
+
+struct FunctionalUnit {
+    unsigned latency = 1;
+    unsigned interval = 1;
+};
+
+UnitKind unit_of(isa::LatencyClass latency);
+UnitKind unit_kind_from_string(const std::string &name); // invalid_argument se desconhecido
+const char *unit_kind_name(UnitKind kind);
+
+// Modelo de hazards do pipeline, o mesmo para todos os processos. Os valores
+// são sempre corretos (os estágios rodam de WB para IF e escrevem direto no
+// REGISTER_BANK); o modelo só decide quantos ciclos cada dependência custa.
+struct PipelineConfig {
+    bool forwardExEx = true;        // resultado da ULA no EX/MEM -> EX da seguinte
+    bool forwardMemEx = true;       // MEM/WB -> EX (lw após uma bolha, ULA a duas de distância)
+    bool unifiedMemoryPort = true;  // Von Neumann: Fetch espera quando lw/sw usa a memória no MEM
+    // Na ordem de UnitKind: ULA, multiplicador (segmentado), divisor (não segmentado), lw/sw
+    std::array<FunctionalUnit, UNIT_COUNT> units{{{1, 1}, {4, 1}, {12, 12}, {1, 1}}};
+    // Instruções buscadas, decodificadas e emitidas por ciclo. Cada posição
+    // tem a sua ULA; multiplicador, divisor e a porta de lw/sw são únicos.
+    unsigned issueWidth = 1;
+    // Entradas do store buffer: o sw entra no buffer no MEM e vai para a
+    // memória quando a porta fica livre; um lw no mesmo endereço recebe o
+    // valor direto do buffer. 0: o sw escreve na memória no MEM.
+    unsigned storeBufferEntries = 0;
+    // Macro-fusão: pares comuns de instruções vizinhas (slti/addi + desvio
+    // condicional no resultado, sll + ori montando uma constante) são
+    // buscados juntos e ocupam uma só posição do grupo.
+    bool macroFusion = false;
+
+    FunctionalUnit &unit(UnitKind kind) { return units[static_cast<unsigned>(kind)]; }
+    const FunctionalUnit &unit(UnitKind kind) const { return units[static_cast<unsigned>(kind)]; }
+};
+
+void setPipelineConfig(const PipelineConfig &config);
+PipelineConfig pipelineConfig();
+
 struct Instruction_Data {
     string source_register;
     string target_register;
     string destination_register;
-    string op;
+    string op;                          // mnemônico (trace)
+    isa::Op kind = isa::Op::INVALID;    // o que executar (INVALID: palavra desconhecida, não faz nada)
+    bool bubble = true;                 // só o Decode transforma a entrada numa instrução de fato
+    bool fetched = false;               // o Fetch buscou algo para esta entrada (não parado)
     string addressRAMResult;
     uint32_t rawInstruction = 0;
+    uint32_t address = 0;               // endereço da instrução
     int32_t immediate = 0;
+    isa::RegisterUse regs;              // dependências (hazards)
+    Prediction prediction;              // próximo PC previsto no Fetch, conferido no EX
+    bool fused = false;                 // segunda metade de um par fundido: sai junto com a anterior
+    uint8_t lanes = 0;                  // instruções vetoriais: palavras por operação
+};
+
+// Instruções que atravessam o pipeline juntas, na ordem do programa (até
+// issueWidth). Uma bolha é um grupo com uma única entrada vazia.
+struct Instruction_Group {
+    vector<Instruction_Data> slots{1};
+};
+
+// Por que uma instrução do Decode não entra no EX no próximo ciclo
+enum class Hazard : uint8_t {
+    None,
+    Raw,            // dependência sem caminho de adiantamento
+    LoadUse,        // esperando o valor de um lw
+    UnitLatency,    // operando ainda numa unidade de várias etapas
+    UnitBusy,       // unidade não segmentada ocupada
+    SlotDependency, // depende de uma instrução mais antiga do mesmo grupo
+    SlotStructural  // unidade já usada no grupo, ou depois de um desvio no grupo
 };
 
 struct ControlContext {
@@ -43,19 +127,28 @@ struct ControlContext {
     int &counterForEnd;
     bool &endProgram;
     bool &endExecution;
+    bool &branchTaken; // desvio tomado neste ciclo: a instrução em Decode é descartada
+};
+
+// sw que já passou pelo MEM e ainda não foi escrito na memória
+struct Buffered_Store {
+    uint32_t address = 0;
+    uint32_t value = 0;
 };
 
 struct Control_Unit {
-    vector<Instruction_Data> data;
+    vector<Instruction_Group> data;
     hw::Map map;
+    unsigned fetchStall = 0; // ciclos de Fetch parado que ainda faltam (penalidade de erro de previsão)
+
+    // Placar das unidades funcionais, em ciclos de Core(): quando cada
+    // registrador (0..31, HI, LO, $w0..$w7) pode ser lido no EX e quando
+    // cada unidade aceita uma nova operação
+    int cycle = 0;
+    std::array<int, isa::REGISTER_IDS> resultReady{};
+    std::array<int, UNIT_COUNT> unitFree{};
 
-    std::unordered_map<string, string> instructionMap = {
-        {"add", "000000"}, {"and", "000001"}, {"div", "000010"}, {"mult","000011"},
-        {"sub", "000100"}, {"beq", "000101"}, {"bne", "000110"}, {"bgt", "000111"},
-        {"bgti","001000"}, {"blt", "001001"}, {"blti","001010"}, {"j", "001011"},
-        {"lw", "001100"},  {"sw", "001101"},  {"li", "001110"},  {"la", "001111"},
-        {"print", "010000"},{"end", "111111"}
-    };
+    std::deque<Buffered_Store> storeBuffer; // do mais antigo para o mais novo
 
     static string Get_immediate(uint32_t instruction);
     static string Get_destination_Register(uint32_t instruction);
@@ -65,17 +158,27 @@ struct Control_Unit {
     // Assinatura corrigida para corresponder à implementação
     string Identificacao_instrucao(uint32_t instruction, hw::REGISTER_BANK &registers);
 
-    void Fetch(ControlContext &context);
+    void Fetch(ControlContext &context, Instruction_Data &slot);
+    static bool Fusible(uint32_t head, uint32_t tail);
+    void Fetch_Fused(ControlContext &context, vector<Instruction_Data> &group);
     void Decode(hw::REGISTER_BANK &registers, Instruction_Data &data);
+    Hazard Data_Hazard(ControlContext &context, const PipelineConfig &config, const Instruction_Data &consumer,
+                       unsigned &exEx, unsigned &memEx) const;
+    Hazard Unit_Hazard(const Instruction_Data &d, const PipelineConfig &config) const;
+    static Hazard Pairing(const vector<Instruction_Data> &group, size_t slot);
+    unsigned Select_Issue(ControlContext &context, const PipelineConfig &config);
+    void Issue(const Instruction_Data &data, const PipelineConfig &config);
     void Execute_Aritmetic_Operation(hw::REGISTER_BANK &registers, Instruction_Data &d);
+    void Execute_Vector_Operation(hw::REGISTER_BANK &registers, Instruction_Data &d);
     void Execute_Operation(Instruction_Data &data, ControlContext &context);
-    void Execute_Loop_Operation(hw::REGISTER_BANK &registers, Instruction_Data &d,
-                                int &counter, int &counterForEnd, bool &endProgram,
-                                MemoryManager &memManager, PCB &process);
+    void Execute_Loop_Operation(Instruction_Data &d, ControlContext &context);
+    void Resolve_Next_PC(Instruction_Data &data, ControlContext &context, bool taken, uint32_t target);
     void Execute(Instruction_Data &data, ControlContext &context);
     void Execute_Immediate_Operation(hw::REGISTER_BANK &registers, Instruction_Data &data);
     void log_operation(const std::string &msg);
-    void Memory_Acess(Instruction_Data &data, ControlContext &context);
+    bool Memory_Acess(Instruction_Data &data, ControlContext &context, const PipelineConfig &config);
+    const Buffered_Store *Buffered_Value(uint32_t address) const;
+    void Drain_Store(ControlContext &context);
     void Write_Back(Instruction_Data &data, ControlContext &context);
 };
 
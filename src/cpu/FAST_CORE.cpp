@@ -0,0 +1,391 @@
+#include "FAST_CORE.hpp"
+#include "OOO_CORE.hpp"
+#include "CONTROL_UNIT.hpp"
+#include "ISA.hpp"
+#include "ULA.hpp"
+#include "PCB.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../IO/IOManager.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#if defined(__GNUC__) && !defined(FAST_CORE_NO_COMPUTED_GOTO)
+#define FAST_CORE_COMPUTED_GOTO 1
+#else
+#define FAST_CORE_COMPUTED_GOTO 0
+#endif
+
+namespace {
+
+// Escritas em $zero vão para este registrador extra, que nunca é lido
+constexpr uint8_t ZERO_SINK = 32;
+constexpr uint8_t RA = 31;
+
+struct DecodedInstr {
+    uint32_t generation = 0; // válida só se igual à geração da execução corrente
+    isa::Op op = isa::Op::INVALID;
+    uint8_t dst = ZERO_SINK; // registrador escrito (ZERO_SINK se for $zero)
+    uint8_t rs = 0;
+    uint8_t rt = 0;
+    uint32_t imm = 0;        // imediato já estendido, shamt ou alvo absoluto do desvio
+    uint32_t word = 0;
+    uint8_t lanes = 0;       // instruções vetoriais (rs/rt/dst são então $w0..$w7, exceto a base de vload/vstore)
+};
+
+// Instruções pré-decodificadas, indexadas por endereço/4. Trocar a geração
+// invalida a tabela inteira em O(1); isso só acontece quando a versão do código
+// do MemoryManager mudou (outra memória, ou escrita numa palavra já
+// decodificada), então as entradas sobrevivem entre quanta e entre processos.
+// Dentro de uma execução, um sw invalida a entrada do endereço escrito
+// (código automodificável).
+struct DecodeCache {
+    vector<DecodedInstr> entries;
+    uint32_t generation = 0;
+    uint64_t codeVersion = 0; // MemoryManager::codeVersion() da última execução
+};
+
+thread_local DecodeCache decodeCache;
+
+uint8_t destination(uint32_t reg) {
+    return reg == 0 ? ZERO_SINK : static_cast<uint8_t>(reg);
+}
+
+DecodedInstr predecode(uint32_t word, uint32_t address, uint32_t generation) {
+    DecodedInstr d;
+    d.generation = generation;
+    d.word = word;
+
+    const isa::InstrDesc *desc = isa::decode(word);
+    // Assim como em Core(), só a palavra END exata encerra o programa; outras
+    // palavras com o opcode de end não fazem nada.
+    if (!desc || (desc->op == isa::Op::END && word != isa::END_WORD)) return d;
+
+    d.op = desc->op;
+    d.rs = static_cast<uint8_t>(isa::rsOf(word));
+    d.rt = static_cast<uint8_t>(isa::rtOf(word));
+    switch (desc->format) {
+        case isa::Format::R:
+            d.dst = destination(isa::rdOf(word));
+            d.imm = isa::shamtOf(word);
+            break;
+        case isa::Format::I:
+            d.dst = destination(isa::rtOf(word));
+            d.imm = static_cast<uint32_t>(isa::immOf(word));
+            break;
+        case isa::Format::J:
+            d.imm = isa::targetOf(word);
+            break;
+        case isa::Format::V:
+            d.rs %= isa::VECTOR_REGISTERS;
+            d.rt %= isa::VECTOR_REGISTERS;
+            d.dst = static_cast<uint8_t>(isa::rdOf(word) % isa::VECTOR_REGISTERS);
+            break;
+    }
+    d.lanes = desc->lanes;
+    if (d.op == isa::Op::VLOAD || d.op == isa::Op::VSTORE) d.rt %= isa::VECTOR_REGISTERS;
+    switch (d.op) {
+        case isa::Op::ANDI: case isa::Op::ORI:
+            d.imm &= 0xFFFFu; // imediato sem sinal
+            break;
+        case isa::Op::BEQ: case isa::Op::BNE: case isa::Op::BGT: case isa::Op::BLT:
+            d.imm = isa::branchTarget(address, word);
+            break;
+        default:
+            break;
+    }
+    return d;
+}
+
+// Registradores de uso geral do REGISTER_BANK na ordem da codificação
+REGISTER hw::REGISTER_BANK::* const GPR[32] = {
+    &hw::REGISTER_BANK::zero, &hw::REGISTER_BANK::at, &hw::REGISTER_BANK::v0, &hw::REGISTER_BANK::v1,
+    &hw::REGISTER_BANK::a0, &hw::REGISTER_BANK::a1, &hw::REGISTER_BANK::a2, &hw::REGISTER_BANK::a3,
+    &hw::REGISTER_BANK::t0, &hw::REGISTER_BANK::t1, &hw::REGISTER_BANK::t2, &hw::REGISTER_BANK::t3,
+    &hw::REGISTER_BANK::t4, &hw::REGISTER_BANK::t5, &hw::REGISTER_BANK::t6, &hw::REGISTER_BANK::t7,
+    &hw::REGISTER_BANK::s0, &hw::REGISTER_BANK::s1, &hw::REGISTER_BANK::s2, &hw::REGISTER_BANK::s3,
+    &hw::REGISTER_BANK::s4, &hw::REGISTER_BANK::s5, &hw::REGISTER_BANK::s6, &hw::REGISTER_BANK::s7,
+    &hw::REGISTER_BANK::t8, &hw::REGISTER_BANK::t9, &hw::REGISTER_BANK::k0, &hw::REGISTER_BANK::k1,
+    &hw::REGISTER_BANK::gp, &hw::REGISTER_BANK::sp, &hw::REGISTER_BANK::fp, &hw::REGISTER_BANK::ra
+};
+
+inline int32_t s32(uint32_t v) { return static_cast<int32_t>(v); }
+
+// Mesma convenção da ULA: divisão por zero dá 0 e INT_MIN / -1 dá INT_MIN
+inline uint32_t divide(uint32_t a, uint32_t b) {
+    if (s32(b) == 0) return 0;
+    if (s32(a) == std::numeric_limits<int32_t>::min() && s32(b) == -1) return a;
+    return static_cast<uint32_t>(s32(a) / s32(b));
+}
+
+// Resto (vai para HI): com divisor zero o resto é o dividendo, e a == q*b + r vale sempre
+inline uint32_t remainder(uint32_t a, uint32_t b) {
+    if (s32(b) == 0) return a;
+    if (s32(a) == std::numeric_limits<int32_t>::min() && s32(b) == -1) return 0;
+    return static_cast<uint32_t>(s32(a) % s32(b));
+}
+
+// O laço do interpretador. Com Warm, buscas, lw e sw também passam por
+// MemoryManager::read/write (contabilizados em 'warmMetrics', descartável),
+// deixando a cache no estado em que o pipeline a deixaria; os desvios treinam
+// o preditor do processo.
+template <bool Warm>
+uint64_t interpret(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests,
+                   bool &printLock, uint64_t maxInstructions, PCB *warmMetrics) {
+    DecodeCache &cache = decodeCache;
+    if (cache.codeVersion != memoryManager.codeVersion() && ++cache.generation == 0) {
+        for (auto &e : cache.entries) e.generation = 0;
+        cache.generation = 1;
+    }
+    cache.codeVersion = memoryManager.codeVersion();
+    const size_t slots = (memoryManager.addressSpaceSize() + 3) / 4;
+    if (cache.entries.size() < slots) cache.entries.resize(slots);
+    DecodedInstr *const table = cache.entries.data();
+    const size_t tableSize = cache.entries.size();
+    const uint32_t generation = cache.generation;
+
+    hw::REGISTER_BANK &bank = process.regBank;
+    uint32_t regs[33];
+    for (int i = 0; i < 32; ++i) regs[i] = (bank.*GPR[i]).value;
+    regs[0] = 0;
+    regs[ZERO_SINK] = 0;
+    uint32_t hi = bank.hi.value, lo = bank.lo.value;
+
+    uint32_t pc = bank.pc.value;
+    uint32_t lastPc = pc;
+    uint64_t executed = 0, loads = 0, stores = 0, vectorOps = 0, vectorLanes = 0;
+    DecodedInstr scratch;
+    const DecodedInstr *in = &scratch;
+
+#if FAST_CORE_COMPUTED_GOTO
+    // Mesma ordem de isa::Op
+    static void *const handlers[] = {
+        &&op_INVALID,
+        &&op_ADD, &&op_SUB, &&op_AND, &&op_OR, &&op_MULT, &&op_DIV, &&op_SLL, &&op_SRL, &&op_JR,
+        &&op_MFHI, &&op_MFLO,
+        &&op_ADDI, &&op_ANDI, &&op_ORI, &&op_SLTI,
+        &&op_LW, &&op_SW,
+        &&op_BEQ, &&op_BNE, &&op_BGT, &&op_BLT,
+        &&op_J, &&op_JAL,
+        &&op_VADD, &&op_VSUB, &&op_VMUL, &&op_VLOAD, &&op_VSTORE,
+        &&op_LL, &&op_SC, &&op_AMOSWAP, &&op_AMOADD,
+        &&op_PRINT, &&op_END
+    };
+    static_assert(sizeof(handlers) / sizeof(handlers[0]) == static_cast<size_t>(isa::Op::END) + 1,
+                  "um tratador por isa::Op");
+#define HANDLER(op) op_##op:
+#define DISPATCH() goto *handlers[static_cast<uint8_t>(in->op)]
+#else
+#define HANDLER(op) case isa::Op::op:
+#define DISPATCH() goto dispatch
+#endif
+
+    // Busca a próxima instrução (da tabela ou decodificando) e salta para o tratador
+#define NEXT()                                                                  \
+    do {                                                                        \
+        if (executed == maxInstructions) goto out;                             \
+        const uint32_t slot = pc >> 2;                                          \
+        if ((pc & 3u) == 0 && slot < tableSize) {                              \
+            if (table[slot].generation != generation) {                        \
+                table[slot] = predecode(memoryManager.peek(pc), pc, generation);\
+                memoryManager.markCode(pc);                                     \
+            }                                                                   \
+            in = &table[slot];                                                  \
+        } else {                                                                \
+            scratch = predecode(memoryManager.peek(pc), pc, generation);        \
+            in = &scratch;                                                      \
+        }                                                                       \
+        if constexpr (Warm) memoryManager.read(pc, *warmMetrics);              \
+        lastPc = pc;                                                            \
+        ++executed;                                                             \
+        DISPATCH();                                                             \
+    } while (0)
+
+    // Desvio: com Warm, também treina o preditor do processo
+#define BRANCH(cond, target)                                                    \
+    do {                                                                        \
+        const bool taken_ = (cond);                                             \
+        const uint32_t target_ = (target);                                      \
+        if constexpr (Warm) process.branchPredictor.warm(pc, in->op, taken_, target_); \
+        pc = taken_ ? target_ : pc + 4;                                         \
+    } while (0)
+
+    NEXT();
+
+#if !FAST_CORE_COMPUTED_GOTO
+dispatch:
+    switch (in->op) {
+#endif
+    HANDLER(INVALID)
+        pc += 4; NEXT();
+
+    HANDLER(ADD)  regs[in->dst] = regs[in->rs] + regs[in->rt];  pc += 4; NEXT();
+    HANDLER(SUB)  regs[in->dst] = regs[in->rs] - regs[in->rt];  pc += 4; NEXT();
+    HANDLER(AND)  regs[in->dst] = regs[in->rs] & regs[in->rt];  pc += 4; NEXT();
+    HANDLER(OR)   regs[in->dst] = regs[in->rs] | regs[in->rt];  pc += 4; NEXT();
+    HANDLER(MULT) {
+        const uint64_t product = static_cast<uint64_t>(int64_t(s32(regs[in->rs])) * int64_t(s32(regs[in->rt])));
+        lo = static_cast<uint32_t>(product);
+        hi = static_cast<uint32_t>(product >> 32);
+        regs[in->dst] = lo;
+        pc += 4; NEXT();
+    }
+    HANDLER(DIV)
+        hi = remainder(regs[in->rs], regs[in->rt]);
+        lo = divide(regs[in->rs], regs[in->rt]);
+        regs[in->dst] = lo;
+        pc += 4; NEXT();
+    HANDLER(SLL)  regs[in->dst] = regs[in->rt] << in->imm; pc += 4; NEXT();
+    HANDLER(SRL)  regs[in->dst] = regs[in->rt] >> in->imm; pc += 4; NEXT();
+    HANDLER(JR)   BRANCH(true, regs[in->rs]); NEXT();
+    HANDLER(MFHI) regs[in->dst] = hi; pc += 4; NEXT();
+    HANDLER(MFLO) regs[in->dst] = lo; pc += 4; NEXT();
+
+    HANDLER(ADDI) regs[in->dst] = regs[in->rs] + in->imm; pc += 4; NEXT();
+    HANDLER(ANDI) regs[in->dst] = regs[in->rs] & in->imm; pc += 4; NEXT();
+    HANDLER(ORI)  regs[in->dst] = regs[in->rs] | in->imm; pc += 4; NEXT();
+    HANDLER(SLTI) regs[in->dst] = s32(regs[in->rs]) < s32(in->imm) ? 1u : 0u; pc += 4; NEXT();
+
+    HANDLER(LW) {
+        const uint32_t addr = regs[in->rs] + in->imm;
+        if constexpr (Warm) regs[in->dst] = memoryManager.read(addr, *warmMetrics);
+        else regs[in->dst] = memoryManager.peek(addr);
+        ++loads; pc += 4; NEXT();
+    }
+    HANDLER(SW) {
+        const uint32_t addr = regs[in->rs] + in->imm;
+        if constexpr (Warm) memoryManager.write(addr, regs[in->rt], *warmMetrics);
+        else memoryManager.poke(addr, regs[in->rt]);
+        if ((addr & 3u) == 0 && (addr >> 2) < tableSize) table[addr >> 2].generation = 0;
+        ++stores; pc += 4; NEXT();
+    }
+
+    HANDLER(BEQ) BRANCH(s32(regs[in->rs]) == s32(regs[in->rt]), in->imm); NEXT();
+    HANDLER(BNE) BRANCH(s32(regs[in->rs]) != s32(regs[in->rt]), in->imm); NEXT();
+    HANDLER(BGT) BRANCH(s32(regs[in->rs]) >  s32(regs[in->rt]), in->imm); NEXT();
+    HANDLER(BLT) BRANCH(s32(regs[in->rs]) <  s32(regs[in->rt]), in->imm); NEXT();
+    HANDLER(J)   BRANCH(true, in->imm); NEXT();
+    HANDLER(JAL) regs[RA] = pc + 4; BRANCH(true, in->imm); NEXT();
+
+    // Vetoriais: direto no banco vetorial do processo; vload/vstore contam
+    // um acesso por linha tocada, como MemoryManager::readVector/writeVector
+#define VECTOR_ALU(aluOp)                                                       \
+    vector_calculate(aluOp, bank.w[in->rs].data(), bank.w[in->rt].data(), bank.w[in->dst].data(), in->lanes); \
+    ++vectorOps; vectorLanes += in->lanes; pc += 4; NEXT();
+
+    HANDLER(VADD) VECTOR_ALU(ADD)
+    HANDLER(VSUB) VECTOR_ALU(SUB)
+    HANDLER(VMUL) VECTOR_ALU(MUL)
+#undef VECTOR_ALU
+    HANDLER(VLOAD) {
+        const uint32_t addr = regs[in->rs] + in->imm;
+        uint32_t *lanes = bank.w[in->rt].data();
+        if constexpr (Warm) memoryManager.readVector(addr, lanes, in->lanes, *warmMetrics);
+        else for (unsigned i = 0; i < in->lanes; ++i) lanes[i] = memoryManager.peek(addr + 4 * i);
+        loads += MemoryManager::vectorLines(addr, in->lanes);
+        ++vectorOps; vectorLanes += in->lanes; pc += 4; NEXT();
+    }
+    HANDLER(VSTORE) {
+        const uint32_t addr = regs[in->rs] + in->imm;
+        const uint32_t *lanes = bank.w[in->rt].data();
+        if constexpr (Warm) memoryManager.writeVector(addr, lanes, in->lanes, *warmMetrics);
+        else for (unsigned i = 0; i < in->lanes; ++i) memoryManager.poke(addr + 4 * i, lanes[i]);
+        for (unsigned i = 0; i < in->lanes; ++i) {
+            const uint32_t word = addr + 4 * i;
+            if ((word & 3u) == 0 && (word >> 2) < tableSize) table[word >> 2].generation = 0;
+        }
+        stores += MemoryManager::vectorLines(addr, in->lanes);
+        ++vectorOps; vectorLanes += in->lanes; pc += 4; NEXT();
+    }
+
+    // ll/sc e atômicas: as reservas ficam no MemoryManager (o núcleo rápido
+    // roda um processo por vez, então cada instrução já é indivisível)
+#define ATOMIC(reads, writes)                                                   \
+    {                                                                           \
+        const uint32_t addr = regs[in->rs] + in->imm;                           \
+        regs[in->dst] = memoryManager.atomic(in->op, addr, regs[in->rt], process, warmMetrics); \
+        if ((writes) && (addr & 3u) == 0 && (addr >> 2) < tableSize) table[addr >> 2].generation = 0; \
+        loads += (reads); stores += (writes); pc += 4; NEXT();                  \
+    }
+
+    HANDLER(LL)      ATOMIC(1, 0)
+    HANDLER(SC)      ATOMIC(0, 1)
+    HANDLER(AMOSWAP) ATOMIC(1, 1)
+    HANDLER(AMOADD)  ATOMIC(1, 1)
+#undef ATOMIC
+
+    HANDLER(PRINT) {
+        auto req = std::make_unique<IORequest>();
+        req->msg = std::to_string(static_cast<int>(regs[in->rt]));
+        req->process = &process;
+        ioRequests->push_back(std::move(req));
+        pc += 4;
+        if (printLock) {
+            process.state = State::Blocked;
+            goto out;
+        }
+        NEXT();
+    }
+
+    HANDLER(END)
+        // O PC fica no END, como no Fetch de Core()
+        process.state = State::Finished;
+        goto out;
+#if !FAST_CORE_COMPUTED_GOTO
+    }
+#endif
+
+#undef NEXT
+#undef BRANCH
+#undef DISPATCH
+#undef HANDLER
+
+out:
+    for (int i = 1; i < 32; ++i) (bank.*GPR[i]).value = regs[i];
+    bank.hi.write(hi);
+    bank.lo.write(lo);
+    bank.pc.write(pc);
+    if (executed > 0) {
+        bank.mar.write(lastPc);
+        bank.ir.write(in->word);
+    }
+
+    // Contadores em lote: cada instrução é uma busca e conta um ciclo
+    process.instructions_retired.fetch_add(executed);
+    process.pipeline_cycles.fetch_add(executed);
+    process.mem_reads.fetch_add(executed + loads);
+    process.mem_writes.fetch_add(stores);
+    process.mem_accesses_total.fetch_add(executed + loads + stores);
+    process.vector_instructions.fetch_add(vectorOps);
+    process.vector_lanes.fetch_add(vectorLanes);
+    return executed;
+}
+
+} // namespace
+
+uint64_t FastCoreRun(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests,
+                     bool &printLock, uint64_t maxInstructions) {
+    return interpret<false>(memoryManager, process, ioRequests, printLock, maxInstructions, nullptr);
+}
+
+uint64_t FastCoreWarm(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests,
+                      bool &printLock, uint64_t maxInstructions) {
+    PCB warmMetrics;
+    return interpret<true>(memoryManager, process, ioRequests, printLock, maxInstructions, &warmMetrics);
+}
+
+void* FastCore(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock) {
+    const uint64_t budget = process.quantum > 0 ? static_cast<uint64_t>(process.quantum) : 1;
+    FastCoreRun(memoryManager, process, ioRequests, printLock, budget);
+    return nullptr;
+}
+
+CoreFunction coreFor(Engine engine) {
+    switch (engine) {
+        case Engine::Fast:       return FastCore;
+        case Engine::OutOfOrder: return OooCore;
+        case Engine::Pipeline:   break;
+    }
+    return Core;
+}
@@ -0,0 +1,60 @@
+#ifndef FAST_CORE_HPP
+#define FAST_CORE_HPP
+/*
+  FAST_CORE.hpp
+  Núcleo funcional rápido: interpretador de código pré-decodificado, alternativa
+  ao pipeline de 5 estágios de Core() para simulações longas.
+
+  - Cada palavra é decodificada uma única vez (pela tabela ISA) para uma entrada
+    compacta {op, registradores, imediato/alvo}, guardada numa tabela indexada
+    por endereço/4. O despacho é um "computed goto" (labels-as-values do
+    GCC/Clang) direto para o tratador da instrução; em outros compiladores, ou
+    com FAST_CORE_NO_COMPUTED_GOTO definido, um switch faz o mesmo papel.
+  - Nada de strings, mapas ou chamadas virtuais por instrução: os registradores
+    são copiados do REGISTER_BANK para um vetor na entrada e devolvidos na saída,
+    e a memória é acessada por MemoryManager::peek/poke.
+  - Os contadores do PCB são atualizados em lote ao final da execução. O modelo
+    é funcional: cada instrução conta um ciclo de pipeline e a hierarquia de
+    memória (hits/misses, ciclos de memória) não é modelada.
+  - Estado arquitetural equivalente ao de Core() ao fim do programa:
+    registradores, memória, PC (no END) e requisições de I/O.
+
+  O quantum é contado em instruções. Um print com printLock bloqueia o processo
+  logo após a instrução (Core() ainda completa as instruções que estavam no
+  pipeline), então os pontos de parada intermediários não coincidem com os de
+  Core(), apenas o estado ao final de cada instrução.
+*/
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using std::unique_ptr;
+using std::vector;
+
+class MemoryManager;
+struct PCB;
+struct IORequest;
+
+// Mesma assinatura de Core(): executa até o fim do programa, um bloqueio por
+// I/O ou o fim do quantum (em instruções; quantum <= 0 executa uma instrução).
+void* FastCore(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock);
+
+// Executa no máximo 'maxInstructions' instruções. Retorna quantas executou.
+uint64_t FastCoreRun(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests,
+                     bool &printLock, uint64_t maxInstructions);
+
+// Como FastCoreRun, mas buscas e acessos de lw/sw passam pela cache e os
+// desvios treinam o preditor do processo (aquecimento funcional antes de uma
+// janela detalhada). As métricas de memória desses
+// acessos são descartadas; os contadores em lote do PCB são os mesmos.
+uint64_t FastCoreWarm(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests,
+                      bool &printLock, uint64_t maxInstructions);
+
+// Motor de execução, escolhido por execução do simulador
+enum class Engine { Pipeline, Fast, OutOfOrder };
+
+using CoreFunction = void* (*)(MemoryManager &, PCB &, vector<unique_ptr<IORequest>>*, bool &);
+
+CoreFunction coreFor(Engine engine);
+
+#endif // FAST_CORE_HPP
@@ -0,0 +1,59 @@
+#include "ISA.hpp"
+#include <sstream>
+
+namespace isa {
+
+std::string disassemble(uint32_t word, uint32_t address) {
+    const InstrDesc *d = decode(word);
+    std::ostringstream out;
+    if (!d) {
+        out << ".word 0x" << std::hex << word;
+        return out.str();
+    }
+
+    auto reg = [](uint32_t idx) { return REGISTER_NAMES[idx & 0x1F]; };
+    auto vreg = [](uint32_t idx) { return VECTOR_REGISTER_NAMES[idx % VECTOR_REGISTERS]; };
+    out << d->mnemonic;
+    switch (d->syntax) {
+        case Syntax::None:
+            break;
+        case Syntax::RdRsRt:
+            out << " " << reg(rdOf(word)) << ", " << reg(rsOf(word)) << ", " << reg(rtOf(word));
+            break;
+        case Syntax::RdRtShamt:
+            out << " " << reg(rdOf(word)) << ", " << reg(rtOf(word)) << ", " << shamtOf(word);
+            break;
+        case Syntax::Rs:
+            out << " " << reg(rsOf(word));
+            break;
+        case Syntax::Rd:
+            out << " " << reg(rdOf(word));
+            break;
+        case Syntax::RtRsImm:
+        case Syntax::RtImm:
+            out << " " << reg(rtOf(word)) << ", " << reg(rsOf(word)) << ", " << immOf(word);
+            break;
+        case Syntax::RtMem:
+            out << " " << reg(rtOf(word)) << ", " << immOf(word) << "(" << reg(rsOf(word)) << ")";
+            break;
+        case Syntax::RsRtLabel:
+            out << " " << reg(rsOf(word)) << ", " << reg(rtOf(word)) << ", " << immOf(word)
+                << "  # -> " << branchTarget(address, word);
+            break;
+        case Syntax::Target:
+            out << " " << targetOf(word);
+            break;
+        case Syntax::Rt:
+            out << " " << reg(rtOf(word));
+            break;
+        case Syntax::VdVsVt:
+            out << " " << vreg(rdOf(word)) << ", " << vreg(rsOf(word)) << ", " << vreg(rtOf(word));
+            break;
+        case Syntax::VtMem:
+            out << " " << vreg(rtOf(word)) << ", " << immOf(word) << "(" << reg(rsOf(word)) << ")";
+            break;
+    }
+    return out.str();
+}
+
+} // namespace isa
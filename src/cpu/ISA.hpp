@@ -0,0 +1,281 @@
+#ifndef ISA_HPP
+#define ISA_HPP
+/*
+  ISA.hpp
+  Descrição única do conjunto de instruções do simulador.
+
+  A tabela ISA_TABLE é a única fonte de verdade para:
+  - o montador (parser_json / parser_asm): opcodes, functs e sintaxe dos operandos;
+  - o decodificador da CPU: decode() é uma consulta a tabelas de 64 entradas
+    indexadas pelo opcode (e pelo funct no formato R), geradas em tempo de compilação;
+  - o disassembler (disassemble()).
+
+  Para criar uma instrução basta acrescentar uma linha à tabela (e, na CPU, a
+  semântica do novo Op). Opcodes ou functs repetidos são rejeitados em tempo
+  de compilação.
+
+  Convenções de codificação:
+  - desvios condicionais guardam no imediato o deslocamento em instruções a
+    partir da instrução seguinte (alvo = endereço + 4 + 4*imm);
+  - j/jal guardam o endereço absoluto do alvo (relocável, como os dados de lw/sw);
+  - instruções vetoriais (SIMD) têm o número de lanes no mnemônico (vadd.4,
+    vadd.8): cada variante tem o seu opcode. As aritméticas usam o formato V
+    (campos do formato R, decodificado pelo opcode); vload/vstore usam o
+    formato I, com o registrador vetorial no campo rt;
+  - ll/sc e as atômicas (amoswap, amoadd) usam a sintaxe de lw: rt é a
+    origem (sc, amoswap, amoadd) e recebe o resultado (sc: 1 se escreveu,
+    0 se perdeu a reserva; atômicas: o valor antigo da palavra).
+*/
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace isa {
+
+enum class Format : uint8_t { R, I, J, V };
+
+// Semântica da instrução (o que a CPU executa)
+enum class Op : uint8_t {
+    INVALID,
+    ADD, SUB, AND, OR, MULT, DIV, SLL, SRL, JR, MFHI, MFLO,
+    ADDI, ANDI, ORI, SLTI,
+    LW, SW,
+    BEQ, BNE, BGT, BLT,
+    J, JAL,
+    VADD, VSUB, VMUL, VLOAD, VSTORE,
+    LL, SC, AMOSWAP, AMOADD,
+    PRINT, END
+};
+
+// Sintaxe dos operandos (montador e disassembler)
+enum class Syntax : uint8_t {
+    None,       // end
+    RdRsRt,     // add $rd, $rs, $rt
+    RdRtShamt,  // sll $rd, $rt, shamt
+    Rs,         // jr $rs
+    Rd,         // mfhi $rd
+    RtRsImm,    // addi $rt, $rs, imm
+    RtImm,      // li $rt, imm            (pseudo: addi $rt, $zero, imm)
+    RtMem,      // lw $rt, off($rs) | lw $rt, rótulo
+    RsRtLabel,  // beq $rs, $rt, rótulo | deslocamento
+    Target,     // j rótulo | endereço
+    Rt,         // print $rt
+    VdVsVt,     // vadd.4 $wd, $ws, $wt
+    VtMem       // vload.4 $wt, off($rs) | vload.4 $wt, rótulo
+};
+
+// Classe de latência (usada pelos modelos de temporização)
+enum class LatencyClass : uint8_t { Alu, Mul, Div, Load, Store, Branch, Jump, Io, Control };
+
+struct InstrDesc {
+    std::string_view mnemonic;
+    Op op;
+    Format format;
+    uint8_t opcode;
+    uint8_t funct;     // só no formato R
+    Syntax syntax;
+    LatencyClass latency;
+    bool pseudo;       // expandida pelo montador, nunca decodificada
+    uint8_t lanes = 0; // instruções vetoriais: palavras por operação (0: escalar)
+};
+
+inline constexpr InstrDesc ISA_TABLE[] = {
+    // mnemônico  op         formato     opcode    funct     sintaxe             latência                 pseudo  lanes
+    {"add",   Op::ADD,   Format::R, 0x00, 0x20, Syntax::RdRsRt,    LatencyClass::Alu,     false},
+    {"sub",   Op::SUB,   Format::R, 0x00, 0x22, Syntax::RdRsRt,    LatencyClass::Alu,     false},
+    {"and",   Op::AND,   Format::R, 0x00, 0x24, Syntax::RdRsRt,    LatencyClass::Alu,     false},
+    {"or",    Op::OR,    Format::R, 0x00, 0x25, Syntax::RdRsRt,    LatencyClass::Alu,     false},
+    {"mult",  Op::MULT,  Format::R, 0x00, 0x18, Syntax::RdRsRt,    LatencyClass::Mul,     false},
+    {"div",   Op::DIV,   Format::R, 0x00, 0x1A, Syntax::RdRsRt,    LatencyClass::Div,     false},
+    {"sll",   Op::SLL,   Format::R, 0x00, 0x00, Syntax::RdRtShamt, LatencyClass::Alu,     false},
+    {"srl",   Op::SRL,   Format::R, 0x00, 0x02, Syntax::RdRtShamt, LatencyClass::Alu,     false},
+    {"jr",    Op::JR,    Format::R, 0x00, 0x08, Syntax::Rs,        LatencyClass::Jump,    false},
+    {"mfhi",  Op::MFHI,  Format::R, 0x00, 0x10, Syntax::Rd,        LatencyClass::Alu,     false},
+    {"mflo",  Op::MFLO,  Format::R, 0x00, 0x12, Syntax::Rd,        LatencyClass::Alu,     false},
+    {"addi",  Op::ADDI,  Format::I, 0x08, 0x00, Syntax::RtRsImm,   LatencyClass::Alu,     false},
+    {"andi",  Op::ANDI,  Format::I, 0x0C, 0x00, Syntax::RtRsImm,   LatencyClass::Alu,     false},
+    {"ori",   Op::ORI,   Format::I, 0x0D, 0x00, Syntax::RtRsImm,   LatencyClass::Alu,     false},
+    {"slti",  Op::SLTI,  Format::I, 0x0A, 0x00, Syntax::RtRsImm,   LatencyClass::Alu,     false},
+    {"li",    Op::ADDI,  Format::I, 0x08, 0x00, Syntax::RtImm,     LatencyClass::Alu,     true },
+    {"lw",    Op::LW,    Format::I, 0x23, 0x00, Syntax::RtMem,     LatencyClass::Load,    false},
+    {"sw",    Op::SW,    Format::I, 0x2B, 0x00, Syntax::RtMem,     LatencyClass::Store,   false},
+    {"beq",   Op::BEQ,   Format::I, 0x04, 0x00, Syntax::RsRtLabel, LatencyClass::Branch,  false},
+    {"bne",   Op::BNE,   Format::I, 0x05, 0x00, Syntax::RsRtLabel, LatencyClass::Branch,  false},
+    {"bgt",   Op::BGT,   Format::I, 0x07, 0x00, Syntax::RsRtLabel, LatencyClass::Branch,  false},
+    {"blt",   Op::BLT,   Format::I, 0x09, 0x00, Syntax::RsRtLabel, LatencyClass::Branch,  false},
+    {"j",     Op::J,     Format::J, 0x02, 0x00, Syntax::Target,    LatencyClass::Jump,    false},
+    {"jal",   Op::JAL,   Format::J, 0x03, 0x00, Syntax::Target,    LatencyClass::Jump,    false},
+    {"vadd.4",   Op::VADD,   Format::V, 0x18, 0x00, Syntax::VdVsVt, LatencyClass::Alu,   false, 4},
+    {"vadd.8",   Op::VADD,   Format::V, 0x19, 0x00, Syntax::VdVsVt, LatencyClass::Alu,   false, 8},
+    {"vsub.4",   Op::VSUB,   Format::V, 0x1A, 0x00, Syntax::VdVsVt, LatencyClass::Alu,   false, 4},
+    {"vsub.8",   Op::VSUB,   Format::V, 0x1B, 0x00, Syntax::VdVsVt, LatencyClass::Alu,   false, 8},
+    {"vmul.4",   Op::VMUL,   Format::V, 0x1C, 0x00, Syntax::VdVsVt, LatencyClass::Mul,   false, 4},
+    {"vmul.8",   Op::VMUL,   Format::V, 0x1D, 0x00, Syntax::VdVsVt, LatencyClass::Mul,   false, 8},
+    {"vload.4",  Op::VLOAD,  Format::I, 0x30, 0x00, Syntax::VtMem,  LatencyClass::Load,  false, 4},
+    {"vload.8",  Op::VLOAD,  Format::I, 0x31, 0x00, Syntax::VtMem,  LatencyClass::Load,  false, 8},
+    {"vstore.4", Op::VSTORE, Format::I, 0x38, 0x00, Syntax::VtMem,  LatencyClass::Store, false, 4},
+    {"vstore.8", Op::VSTORE, Format::I, 0x39, 0x00, Syntax::VtMem,  LatencyClass::Store, false, 8},
+    {"ll",      Op::LL,      Format::I, 0x32, 0x00, Syntax::RtMem, LatencyClass::Load,  false},
+    {"sc",      Op::SC,      Format::I, 0x3A, 0x00, Syntax::RtMem, LatencyClass::Store, false},
+    {"amoswap", Op::AMOSWAP, Format::I, 0x33, 0x00, Syntax::RtMem, LatencyClass::Load,  false},
+    {"amoadd",  Op::AMOADD,  Format::I, 0x3B, 0x00, Syntax::RtMem, LatencyClass::Load,  false},
+    {"print", Op::PRINT, Format::I, 0x3E, 0x00, Syntax::Rt,        LatencyClass::Io,      false},
+    {"end",   Op::END,   Format::I, 0x3F, 0x00, Syntax::None,      LatencyClass::Control, false},
+};
+
+inline constexpr std::size_t ISA_SIZE = sizeof(ISA_TABLE) / sizeof(ISA_TABLE[0]);
+inline constexpr uint8_t NO_ENTRY = 0xFF;
+
+inline constexpr std::array<std::string_view, 32> REGISTER_NAMES = {
+    "$zero", "$at", "$v0", "$v1", "$a0", "$a1", "$a2", "$a3",
+    "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
+    "$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+    "$t8", "$t9", "$k0", "$k1", "$gp", "$sp", "$fp", "$ra"
+};
+
+// Banco vetorial: VECTOR_REGISTERS registradores de VECTOR_LANES palavras
+inline constexpr unsigned VECTOR_REGISTERS = 8;
+inline constexpr unsigned VECTOR_LANES = 8;
+
+inline constexpr std::array<std::string_view, VECTOR_REGISTERS> VECTOR_REGISTER_NAMES = {
+    "$w0", "$w1", "$w2", "$w3", "$w4", "$w5", "$w6", "$w7"
+};
+
+namespace detail {
+    // Índice na ISA_TABLE por opcode (formatos I/J) ou por funct (formato R)
+    struct DecodeTables {
+        std::array<uint8_t, 64> byOpcode{};
+        std::array<uint8_t, 64> byFunct{};
+    };
+
+    constexpr DecodeTables buildDecodeTables() {
+        DecodeTables t{};
+        for (auto &e : t.byOpcode) e = NO_ENTRY;
+        for (auto &e : t.byFunct) e = NO_ENTRY;
+        for (std::size_t i = 0; i < ISA_SIZE; ++i) {
+            const InstrDesc &d = ISA_TABLE[i];
+            if (d.pseudo) continue;
+            auto &slot = d.format == Format::R ? t.byFunct[d.funct] : t.byOpcode[d.opcode];
+            if (slot != NO_ENTRY) throw "ISA_TABLE: opcode/funct repetido";
+            slot = static_cast<uint8_t>(i);
+        }
+        if (t.byOpcode[0] != NO_ENTRY) throw "ISA_TABLE: opcode 0 é reservado ao formato R";
+        return t;
+    }
+
+    inline constexpr DecodeTables DECODE = buildDecodeTables();
+}
+
+// Campos da palavra
+constexpr uint32_t opcodeOf(uint32_t w) { return (w >> 26) & 0x3Fu; }
+constexpr uint32_t rsOf(uint32_t w)     { return (w >> 21) & 0x1Fu; }
+constexpr uint32_t rtOf(uint32_t w)     { return (w >> 16) & 0x1Fu; }
+constexpr uint32_t rdOf(uint32_t w)     { return (w >> 11) & 0x1Fu; }
+constexpr uint32_t shamtOf(uint32_t w)  { return (w >> 6) & 0x1Fu; }
+constexpr uint32_t functOf(uint32_t w)  { return w & 0x3Fu; }
+constexpr int32_t  immOf(uint32_t w)    { return static_cast<int16_t>(w & 0xFFFFu); }
+constexpr uint32_t targetOf(uint32_t w) { return w & 0x03FFFFFFu; }
+
+// Decodificação: uma consulta de tabela. nullptr se a palavra não é uma instrução.
+constexpr const InstrDesc *decode(uint32_t word) {
+    const uint32_t opcode = opcodeOf(word);
+    const uint8_t idx = opcode == 0 ? detail::DECODE.byFunct[functOf(word)] : detail::DECODE.byOpcode[opcode];
+    return idx == NO_ENTRY ? nullptr : &ISA_TABLE[idx];
+}
+
+// Só a operação: Op::INVALID se a palavra não é uma instrução
+constexpr Op decodeOp(uint32_t word) {
+    const InstrDesc *d = decode(word);
+    return d ? d->op : Op::INVALID;
+}
+
+// Busca pelo mnemônico (montador). nullptr se não existir.
+constexpr const InstrDesc *find(std::string_view mnemonic) {
+    for (const InstrDesc &d : ISA_TABLE)
+        if (d.mnemonic == mnemonic) return &d;
+    return nullptr;
+}
+
+// Codificação dos três formatos
+constexpr uint32_t encodeR(const InstrDesc &d, uint32_t rs, uint32_t rt, uint32_t rd, uint32_t shamt) {
+    return (uint32_t(d.opcode) << 26) | ((rs & 0x1F) << 21) | ((rt & 0x1F) << 16) |
+           ((rd & 0x1F) << 11) | ((shamt & 0x1F) << 6) | (d.funct & 0x3Fu);
+}
+constexpr uint32_t encodeI(const InstrDesc &d, uint32_t rs, uint32_t rt, int32_t imm) {
+    return (uint32_t(d.opcode) << 26) | ((rs & 0x1F) << 21) | ((rt & 0x1F) << 16) |
+           (static_cast<uint32_t>(imm) & 0xFFFFu);
+}
+constexpr uint32_t encodeJ(const InstrDesc &d, uint32_t target) {
+    return (uint32_t(d.opcode) << 26) | (target & 0x03FFFFFFu);
+}
+
+// Alvo de um desvio condicional localizado em 'address'
+constexpr uint32_t branchTarget(uint32_t address, uint32_t word) {
+    return address + 4 + static_cast<uint32_t>(immOf(word) * 4);
+}
+
+// HI e LO (resultado de 64 bits de mult, quociente e resto de div) entram nas
+// dependências como os registradores 32 e 33, e os vetoriais como 34..41
+inline constexpr uint8_t REG_HI = 32;
+inline constexpr uint8_t REG_LO = 33;
+inline constexpr uint8_t REG_W0 = 34;
+inline constexpr unsigned REGISTER_IDS = REG_W0 + VECTOR_REGISTERS;
+
+constexpr bool isHiLo(uint8_t reg) { return reg == REG_HI || reg == REG_LO; }
+// Campo de registrador de uma instrução vetorial -> número nas dependências
+constexpr uint8_t vectorRegister(uint32_t field) { return static_cast<uint8_t>(REG_W0 + (field % VECTOR_REGISTERS)); }
+
+// Registradores lidos e escrito por uma instrução (0 = nenhum: $zero nunca
+// cria dependência). Usado pela detecção de hazards do pipeline; mult e div
+// também escrevem HI e LO (writesHiLo).
+struct RegisterUse {
+    uint8_t src1 = 0;
+    uint8_t src2 = 0;
+    uint8_t dst = 0;
+};
+
+constexpr RegisterUse registerUse(const InstrDesc &d, uint32_t word) {
+    const auto rs = static_cast<uint8_t>(rsOf(word));
+    const auto rt = static_cast<uint8_t>(rtOf(word));
+    switch (d.syntax) {
+        case Syntax::RdRsRt:    return {rs, rt, static_cast<uint8_t>(rdOf(word))};
+        case Syntax::RdRtShamt: return {rt, 0, static_cast<uint8_t>(rdOf(word))};
+        case Syntax::Rs:        return {rs, 0, 0};
+        case Syntax::Rd:        return {d.op == Op::MFHI ? REG_HI : REG_LO, 0, static_cast<uint8_t>(rdOf(word))};
+        case Syntax::RtRsImm:
+        case Syntax::RtImm:     return {rs, 0, rt};
+        case Syntax::RtMem:     return d.op == Op::SW                     ? RegisterUse{rs, rt, 0}
+                                     : d.op == Op::LW || d.op == Op::LL ? RegisterUse{rs, 0, rt}
+                                                                        : RegisterUse{rs, rt, rt};
+        case Syntax::RsRtLabel: return {rs, rt, 0};
+        case Syntax::Target:    return {0, 0, static_cast<uint8_t>(d.op == Op::JAL ? 31 : 0)};
+        case Syntax::Rt:        return {rt, 0, 0};
+        case Syntax::VdVsVt:    return {vectorRegister(rs), vectorRegister(rt), vectorRegister(rdOf(word))};
+        case Syntax::VtMem:     return d.op == Op::VSTORE ? RegisterUse{rs, vectorRegister(rt), 0}
+                                                          : RegisterUse{rs, 0, vectorRegister(rt)};
+        case Syntax::None:      return {};
+    }
+    return {};
+}
+
+constexpr bool writesHiLo(Op op) { return op == Op::MULT || op == Op::DIV; }
+constexpr bool isVector(Op op) { return op >= Op::VADD && op <= Op::VSTORE; }
+// ll, sc, amoswap, amoadd: uma leitura-modificação-escrita indivisível
+constexpr bool isAtomic(Op op) { return op >= Op::LL && op <= Op::AMOADD; }
+// lw/vload e as atômicas: o valor só existe no fim do MEM
+constexpr bool isLoad(Op op) { return op == Op::LW || op == Op::VLOAD || isAtomic(op); }
+constexpr bool accessesMemory(Op op) {
+    return op == Op::LW || op == Op::SW || op == Op::VLOAD || op == Op::VSTORE || isAtomic(op);
+}
+
+inline constexpr uint32_t END_WORD = uint32_t(0x3F) << 26;
+static_assert(decodeOp(END_WORD) == Op::END, "END_WORD deve decodificar como end");
+
+// Texto assembly da palavra (sintaxe aceita por parser_asm). 'address' é o
+// endereço da instrução, usado para mostrar o alvo absoluto dos desvios.
+std::string disassemble(uint32_t word, uint32_t address = 0);
+
+} // namespace isa
+
+#endif // ISA_HPP
@@ -0,0 +1,561 @@
+#include "OOO_CORE.hpp"
+#include "CONTROL_UNIT.hpp"
+#include "ISA.hpp"
+#include "ULA.hpp"
+#include "PCB.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../IO/IOManager.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+static_assert(UNIT_COUNT == 4, "OooConfig::units tem uma posição por UnitKind");
+
+// Ajustado antes de a simulação começar (linha de comando)
+static OooConfig oooModel;
+
+void setOooConfig(const OooConfig &config) {
+    if (config.width == 0 || config.robEntries == 0 || config.stations == 0 || config.lsqEntries == 0)
+        throw std::invalid_argument("Nucleo fora de ordem: largura, ROB, estacoes e LSQ devem ser maiores que zero");
+    for (unsigned n : config.units)
+        if (n == 0) throw std::invalid_argument("Nucleo fora de ordem: cada tipo precisa de ao menos uma unidade");
+    oooModel = config;
+}
+
+OooConfig oooConfig() { return oooModel; }
+
+const char *ooo_stall_name(OooStall cause) {
+    static constexpr const char *NAMES[OOO_STALL_CAUSES] = {"rob cheio", "estacoes cheias", "lsq cheia", "busca vazia"};
+    return NAMES[static_cast<unsigned>(cause)];
+}
+
+double OooStats::meanRobOccupancy() const {
+    uint64_t cycles = 0, sum = 0;
+    for (size_t n = 0; n < robOccupancy.size(); ++n) {
+        cycles += robOccupancy[n];
+        sum += robOccupancy[n] * n;
+    }
+    return cycles ? double(sum) / cycles : 0.0;
+}
+
+namespace {
+
+constexpr unsigned ARCH_REGS = hw::ARCH_REGISTERS;
+const auto &ARCH = hw::ARCH_REGISTER; // registradores na ordem da renomeação
+
+// Operando de uma estação: o valor, ou a entrada do ROB que vai produzi-lo
+struct Operand {
+    bool ready = true;
+    uint32_t value = 0;
+    int tag = -1;
+    uint8_t reg = 0; // registrador lido (escolhe entre resultado, HI e LO do produtor)
+};
+
+enum class Phase : uint8_t { Waiting, Executing, Done };
+
+struct RobEntry {
+    uint64_t seq = 0;
+    uint32_t pc = 0;
+    uint32_t word = 0;
+    const isa::InstrDesc *desc = nullptr;
+    isa::Op op = isa::Op::INVALID;   // INVALID (palavra desconhecida ou end inexato): não faz nada
+    isa::RegisterUse regs;
+    Phase phase = Phase::Waiting;
+    uint32_t result = 0, hi = 0, lo = 0;
+    bool taken = false;
+    uint32_t target = 0;
+    uint32_t nextPC = 0;             // próximo PC real
+    Prediction prediction;
+    bool mispredicted = false;
+    uint32_t address = 0;            // lw/sw
+    bool addressReady = false;
+    uint32_t storeData = 0;
+};
+
+// Estação de reserva ou entrada da LSQ: operandos da instrução em rob[rob]
+struct Station {
+    int rob = -1;
+    Operand a, b; // a: src1 (rs, ou rt nos shifts e no print), b: src2
+};
+
+struct InFlight {
+    int rob;
+    uint64_t seq;
+    uint64_t doneAt;
+};
+
+struct Fetched {
+    uint32_t pc = 0;
+    uint32_t word = 0;
+    Prediction prediction;
+};
+
+uint32_t valueOf(const RobEntry &e, uint8_t reg) {
+    return reg == isa::REG_HI ? e.hi : reg == isa::REG_LO ? e.lo : e.result;
+}
+
+// Bytes lidos ou escritos por um acesso à memória (vload/vstore: uma palavra por lane)
+uint32_t span(const RobEntry &e) {
+    return isa::isVector(e.op) ? 4u * e.desc->lanes : 4u;
+}
+
+bool overlaps(const RobEntry &x, const RobEntry &y) {
+    return x.address < y.address + span(y) && y.address < x.address + span(x);
+}
+
+uint32_t aluResult(operation op, uint32_t a, uint32_t b) {
+    ALU alu;
+    alu.A = a;
+    alu.B = b;
+    alu.op = op;
+    alu.calculate();
+    return static_cast<uint32_t>(alu.result);
+}
+
+// Executa na ALU com os operandos prontos (mesma semântica de Core())
+void execute(RobEntry &e, uint32_t a, uint32_t b) {
+    const uint32_t imm = static_cast<uint32_t>(isa::immOf(e.word));
+    switch (e.op) {
+        case isa::Op::ADD:  e.result = aluResult(ADD, a, b);    break;
+        case isa::Op::SUB:  e.result = aluResult(SUB, a, b);    break;
+        case isa::Op::AND:  e.result = aluResult(AND_OP, a, b); break;
+        case isa::Op::OR:   e.result = aluResult(OR_OP, a, b);  break;
+        case isa::Op::MULT: {
+            e.result = aluResult(MUL, a, b);
+            const uint64_t product = static_cast<uint64_t>(int64_t(int32_t(a)) * int64_t(int32_t(b)));
+            e.hi = static_cast<uint32_t>(product >> 32);
+            e.lo = static_cast<uint32_t>(product);
+            break;
+        }
+        case isa::Op::DIV: {
+            const int32_t x = static_cast<int32_t>(a), y = static_cast<int32_t>(b);
+            const bool overflow = x == std::numeric_limits<int32_t>::min() && y == -1;
+            e.result = e.lo = aluResult(DIV, a, b);
+            e.hi = static_cast<uint32_t>(y == 0 ? x : overflow ? 0 : x % y);
+            break;
+        }
+        case isa::Op::SLL:  e.result = aluResult(SLL, a, isa::shamtOf(e.word)); break;
+        case isa::Op::SRL:  e.result = aluResult(SRL, a, isa::shamtOf(e.word)); break;
+        case isa::Op::MFHI: case isa::Op::MFLO:
+            e.result = a;
+            break;
+        case isa::Op::ADDI: e.result = aluResult(ADD, a, imm);             break;
+        case isa::Op::ANDI: e.result = aluResult(AND_OP, a, imm & 0xFFFFu); break;
+        case isa::Op::ORI:  e.result = aluResult(OR_OP, a, imm & 0xFFFFu);  break;
+        case isa::Op::SLTI: e.result = static_cast<int32_t>(a) < static_cast<int32_t>(imm) ? 1u : 0u; break;
+        case isa::Op::BEQ: case isa::Op::BNE: case isa::Op::BGT: case isa::Op::BLT: {
+            const operation cmp = e.op == isa::Op::BEQ ? BEQ : e.op == isa::Op::BNE ? BNE
+                                : e.op == isa::Op::BGT ? BGT : BLT;
+            e.taken = aluResult(cmp, a, b) == 1;
+            e.target = isa::branchTarget(e.pc, e.word);
+            break;
+        }
+        case isa::Op::J:   e.taken = true; e.target = isa::targetOf(e.word); break;
+        case isa::Op::JAL: e.taken = true; e.target = isa::targetOf(e.word); e.result = e.pc + 4; break;
+        case isa::Op::JR:  e.taken = true; e.target = a; break;
+        case isa::Op::PRINT:
+            e.result = a;
+            break;
+        default:
+            break;
+    }
+    e.nextPC = e.taken ? e.target : e.pc + 4;
+}
+
+class OutOfOrderCore {
+public:
+    OutOfOrderCore(MemoryManager &memory, PCB &process, vector<unique_ptr<IORequest>> &io, bool printLock)
+        : cfg(oooModel), timing(pipelineConfig()), memory(memory), process(process), io(io),
+          printLock(printLock), rob(cfg.robEntries) {
+        hw::REGISTER_BANK &bank = process.regBank;
+        for (unsigned r = 0; r < ARCH_REGS; ++r) arch[r] = (bank.*ARCH[r]).value;
+        arch[0] = 0;
+        rename.fill(-1);
+        for (unsigned k = 0; k < UNIT_COUNT; ++k) unitFree[k].assign(cfg.units[k], 0);
+        fetchPC = commitPC = bank.pc.value;
+
+        OooStats &stats = process.ooo;
+        stats.robOccupancy.resize(std::max<size_t>(stats.robOccupancy.size(), cfg.robEntries + 1));
+        stats.committedPerCycle.resize(std::max<size_t>(stats.committedPerCycle.size(), cfg.width + 1));
+    }
+
+    void run() {
+        const uint64_t quantum = process.quantum > 0 ? static_cast<uint64_t>(process.quantum) : 0;
+        while (!stop) {
+            if (draining && count == 0 && fetchQueue.empty()) break;
+            const unsigned committed = commit();
+            if (!stop) {
+                complete();
+                issue();
+                dispatch();
+                fetch();
+            }
+            ++cycle;
+            process.pipeline_cycles.fetch_add(1);
+            process.instructions_retired.fetch_add(committed);
+            process.ooo.robOccupancy[count]++;
+            process.ooo.committedPerCycle[committed]++;
+            if (cycle >= quantum) draining = true;
+        }
+
+        hw::REGISTER_BANK &bank = process.regBank;
+        for (unsigned r = 1; r < ARCH_REGS; ++r) (bank.*ARCH[r]).value = arch[r];
+        bank.pc.write(commitPC);
+    }
+
+private:
+    const OooConfig cfg;
+    const PipelineConfig timing;
+    MemoryManager &memory;
+    PCB &process;
+    vector<unique_ptr<IORequest>> &io;
+    const bool printLock;
+
+    uint32_t arch[ARCH_REGS];
+    // Entrada do ROB que produz o registrador, ou -1. Os vetoriais ($w0..$w7)
+    // só são renomeados para a ordem: os valores são calculados no commit.
+    std::array<int, isa::REGISTER_IDS> rename;
+    vector<RobEntry> rob;
+    unsigned head = 0, count = 0;
+    uint64_t nextSeq = 0;
+    vector<Station> stations;                  // em ordem de despacho (a mais antiga primeiro)
+    std::deque<Station> lsq;                   // lw/sw em ordem de programa
+    vector<InFlight> inFlight;
+    std::array<vector<uint64_t>, UNIT_COUNT> unitFree; // ciclo em que cada unidade aceita outra operação
+    std::deque<Fetched> fetchQueue;
+    uint32_t fetchPC = 0, commitPC = 0;
+    unsigned fetchStall = 0;
+    bool fetchEnded = false;                   // buscou o END: nada mais a buscar
+    bool draining = false, stop = false;
+    uint64_t cycle = 0;
+
+    unsigned position(int index) const { return (static_cast<unsigned>(index) + cfg.robEntries - head) % cfg.robEntries; }
+    bool alive(int index, uint64_t seq) const { return position(index) < count && rob[index].seq == seq; }
+
+    Operand operand(uint8_t reg) const {
+        Operand op;
+        op.reg = reg;
+        if (reg == 0) return op;
+        const int tag = rename[reg];
+        if (tag < 0) {
+            if (reg < ARCH_REGS) op.value = arch[reg];
+        } else if (rob[tag].phase == Phase::Done) {
+            op.value = valueOf(rob[tag], reg);
+        } else {
+            op.ready = false;
+            op.tag = tag;
+        }
+        return op;
+    }
+
+    void claim(const RobEntry &e, int index) {
+        if (e.regs.dst != 0) rename[e.regs.dst] = index;
+        if (isa::writesHiLo(e.op)) rename[isa::REG_HI] = rename[isa::REG_LO] = index;
+    }
+
+    // Barramento comum: entrega o resultado a quem espera por ele
+    void broadcast(int index) {
+        const RobEntry &e = rob[index];
+        auto wake = [&](Operand &op) {
+            if (!op.ready && op.tag == index) {
+                op.ready = true;
+                op.value = valueOf(e, op.reg);
+            }
+        };
+        for (Station &s : stations) { wake(s.a); wake(s.b); }
+        for (Station &s : lsq) { wake(s.a); wake(s.b); }
+    }
+
+    // Descarta tudo o que é mais novo que 'seq' e refaz a renomeação com o que sobrou
+    void squashAfter(uint64_t seq) {
+        unsigned kept = 0;
+        while (kept < count && rob[(head + kept) % cfg.robEntries].seq <= seq) ++kept;
+        process.ooo.squashed += count - kept;
+        count = kept;
+        auto younger = [&](const Station &s) { return rob[s.rob].seq > seq || position(s.rob) >= count; };
+        stations.erase(std::remove_if(stations.begin(), stations.end(), younger), stations.end());
+        while (!lsq.empty() && younger(lsq.back())) lsq.pop_back();
+        inFlight.erase(std::remove_if(inFlight.begin(), inFlight.end(),
+                                      [&](const InFlight &f) { return !alive(f.rob, f.seq); }),
+                       inFlight.end());
+        fetchQueue.clear();
+        rename.fill(-1);
+        for (unsigned i = 0; i < count; ++i) {
+            const int index = static_cast<int>((head + i) % cfg.robEntries);
+            claim(rob[index], index);
+        }
+    }
+
+    // Confere o próximo PC previsto na busca; errou: descarta o caminho errado e redireciona
+    void resolve(int index) {
+        RobEntry &e = rob[index];
+        if (branch_kind_of(e.op) == BranchKind::None && !e.prediction.btbHit) return;
+        e.mispredicted = process.branchPredictor.update(e.pc, e.op, e.prediction, e.taken, e.target);
+        if (!e.mispredicted) return;
+        squashAfter(e.seq);
+        fetchPC = e.nextPC;
+        fetchEnded = false;
+        fetchStall = process.branchPredictor.config().mispredictPenalty;
+        process.branch_flush_cycles.fetch_add(1);
+    }
+
+    unsigned commit() {
+        unsigned committed = 0;
+        while (committed < cfg.width && count > 0 && rob[head].phase == Phase::Done) {
+            const int index = static_cast<int>(head);
+            const RobEntry &e = rob[index];
+            if (e.regs.dst != 0) {
+                if (e.regs.dst < ARCH_REGS) arch[e.regs.dst] = e.result;
+                if (rename[e.regs.dst] == index) rename[e.regs.dst] = -1;
+            }
+            if (isa::writesHiLo(e.op)) {
+                arch[isa::REG_HI] = e.hi;
+                arch[isa::REG_LO] = e.lo;
+                if (rename[isa::REG_HI] == index) rename[isa::REG_HI] = -1;
+                if (rename[isa::REG_LO] == index) rename[isa::REG_LO] = -1;
+            }
+            if (e.op == isa::Op::SW) memory.write(e.address, e.storeData, process);
+            if (isa::isVector(e.op)) commitVector(e);
+            if (isa::accessesMemory(e.op)) lsq.pop_front();
+            if (branch_kind_of(e.op) != BranchKind::None) {
+                process.branch_predictions.fetch_add(1);
+                if (e.mispredicted) process.branch_mispredictions.fetch_add(1);
+            }
+            commitPC = e.nextPC;
+            head = (head + 1) % cfg.robEntries;
+            --count;
+            ++committed;
+
+            if (e.op == isa::Op::END) {
+                // O PC fica no END, como em Core()
+                commitPC = e.pc;
+                process.state = State::Finished;
+                stop = true;
+            } else if (e.op == isa::Op::PRINT) {
+                auto req = std::make_unique<IORequest>();
+                req->msg = std::to_string(static_cast<int>(e.result));
+                req->process = &process;
+                io.push_back(std::move(req));
+                if (printLock) {
+                    process.state = State::Blocked;
+                    stop = true;
+                }
+            }
+            if (stop) {
+                squashAfter(e.seq);
+                break;
+            }
+        }
+        return committed;
+    }
+
+    // Instruções vetoriais: os valores saem na ordem do programa, direto no
+    // banco de registradores do processo (vload/vstore acessam a memória aqui)
+    void commitVector(const RobEntry &e) {
+        hw::REGISTER_BANK &bank = process.regBank;
+        auto vreg = [&](uint32_t field) -> hw::REGISTER_BANK::VECTOR & { return bank.w[field % isa::VECTOR_REGISTERS]; };
+        const unsigned lanes = e.desc->lanes;
+        switch (e.op) {
+            case isa::Op::VLOAD:  memory.readVector(e.address, vreg(isa::rtOf(e.word)).data(), lanes, process); break;
+            case isa::Op::VSTORE: memory.writeVector(e.address, vreg(isa::rtOf(e.word)).data(), lanes, process); break;
+            default: {
+                const operation op = e.op == isa::Op::VADD ? ADD : e.op == isa::Op::VSUB ? SUB : MUL;
+                vector_calculate(op, vreg(isa::rsOf(e.word)).data(), vreg(isa::rtOf(e.word)).data(),
+                                 vreg(isa::rdOf(e.word)).data(), lanes);
+                break;
+            }
+        }
+        process.vector_instructions.fetch_add(1);
+        process.vector_lanes.fetch_add(lanes);
+    }
+
+    // Resultados cuja latência terminou, do mais antigo para o mais novo
+    void complete() {
+        vector<InFlight> done;
+        for (auto it = inFlight.begin(); it != inFlight.end();) {
+            if (it->doneAt <= cycle) {
+                done.push_back(*it);
+                it = inFlight.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        std::sort(done.begin(), done.end(), [](const InFlight &x, const InFlight &y) { return x.seq < y.seq; });
+        for (const InFlight &f : done) {
+            if (!alive(f.rob, f.seq)) continue; // descartada por um desvio mais antigo
+            rob[f.rob].phase = Phase::Done;
+            broadcast(f.rob);
+            resolve(f.rob);
+        }
+    }
+
+    uint64_t *freeUnit(UnitKind kind) {
+        for (uint64_t &freeAt : unitFree[static_cast<unsigned>(kind)])
+            if (freeAt <= cycle) return &freeAt;
+        return nullptr;
+    }
+
+    void start(int index, UnitKind kind, unsigned extraLatency) {
+        uint64_t *unit = freeUnit(kind);
+        const FunctionalUnit &fu = timing.unit(kind);
+        *unit = cycle + fu.interval;
+        rob[index].phase = Phase::Executing;
+        inFlight.push_back({index, rob[index].seq, cycle + fu.latency + extraLatency});
+    }
+
+    void issue() {
+        unsigned issued = 0;
+
+        // lw/vload com endereço calculado num ciclo anterior. O vload só
+        // ocupa a porta aqui; as palavras são lidas no commit.
+        for (size_t i = 0; i < lsq.size() && issued < cfg.width; ++i) {
+            RobEntry &e = rob[lsq[i].rob];
+            if (!isa::isLoad(e.op) || e.phase != Phase::Waiting || !e.addressReady) continue;
+            bool unknown = false;
+            const RobEntry *source = nullptr;
+            if (isa::isAtomic(e.op)) continue;
+            for (size_t j = 0; j < i; ++j) {
+                const RobEntry &older = rob[lsq[j].rob];
+                if (isa::isAtomic(older.op)) {
+                    if (older.phase != Phase::Done) { unknown = true; break; }
+                    continue;
+                }
+                if (!isa::accessesMemory(older.op) || isa::isLoad(older.op)) continue;
+                if (!older.addressReady) { unknown = true; break; }
+                if (e.op != isa::Op::LW || !overlaps(older, e)) continue;
+                // lw sobre um vstore mais antigo: espera o vstore ir para a memória
+                if (older.op == isa::Op::VSTORE) { unknown = true; break; }
+                source = &older;
+            }
+            if (unknown || (source && source->phase != Phase::Done) || !freeUnit(UnitKind::LoadStore)) continue;
+            if (e.op == isa::Op::LW) e.result = source ? source->storeData : memory.read(e.address, process);
+            start(lsq[i].rob, UnitKind::LoadStore, 0);
+            ++issued;
+        }
+
+        // ll/sc e atômicas: só na cabeça do ROB (nada mais antigo pendente e
+        // nada especulativo), lendo e escrevendo a memória de uma vez
+        if (!lsq.empty() && issued < cfg.width) {
+            Station &s = lsq.front();
+            RobEntry &e = rob[s.rob];
+            if (isa::isAtomic(e.op) && e.phase == Phase::Waiting && position(s.rob) == 0 && e.addressReady &&
+                s.b.ready && freeUnit(UnitKind::LoadStore)) {
+                e.result = memory.atomic(e.op, e.address, s.b.value, process, &process);
+                start(s.rob, UnitKind::LoadStore, 0);
+                ++issued;
+            }
+        }
+
+        // Estações com os dois operandos prontos, das mais antigas para as mais novas
+        for (auto it = stations.begin(); it != stations.end() && issued < cfg.width;) {
+            RobEntry &e = rob[it->rob];
+            const UnitKind kind = unit_of(e.desc->latency);
+            if (!it->a.ready || !it->b.ready || !freeUnit(kind)) {
+                ++it;
+                continue;
+            }
+            execute(e, it->a.value, it->b.value);
+            start(it->rob, kind, 0);
+            it = stations.erase(it);
+            ++issued;
+        }
+
+        // Cálculo de endereço (vale a partir do próximo ciclo); sw/vstore fica
+        // pronto com endereço e dado
+        for (Station &s : lsq) {
+            RobEntry &e = rob[s.rob];
+            if (!e.addressReady && s.a.ready) {
+                e.address = aluResult(LW, s.a.value, static_cast<uint32_t>(isa::immOf(e.word)));
+                e.addressReady = true;
+            }
+            if (e.op == isa::Op::VSTORE && e.phase == Phase::Waiting && e.addressReady && s.b.ready) {
+                e.phase = Phase::Done;
+            } else if (e.op == isa::Op::SW && e.phase == Phase::Waiting && e.addressReady && s.b.ready) {
+                e.storeData = s.b.value;
+                e.phase = Phase::Done;
+            }
+        }
+    }
+
+    void dispatch() {
+        std::optional<OooStall> stall;
+        for (unsigned n = 0; n < cfg.width; ++n) {
+            if (fetchQueue.empty()) {
+                if (!fetchEnded && !draining) stall = OooStall::FrontEnd;
+                break;
+            }
+            const Fetched f = fetchQueue.front();
+            const isa::InstrDesc *desc = isa::decode(f.word);
+            isa::Op op = desc ? desc->op : isa::Op::INVALID;
+            if (op == isa::Op::END && f.word != isa::END_WORD) op = isa::Op::INVALID;
+            const bool memoryOp = isa::accessesMemory(op);
+            const bool needsStation = !memoryOp && op != isa::Op::INVALID && op != isa::Op::END;
+
+            if (count == cfg.robEntries) { stall = OooStall::RobFull; break; }
+            if (memoryOp && lsq.size() == cfg.lsqEntries) { stall = OooStall::LsqFull; break; }
+            if (needsStation && stations.size() == cfg.stations) { stall = OooStall::StationsFull; break; }
+            fetchQueue.pop_front();
+
+            const int index = static_cast<int>((head + count) % cfg.robEntries);
+            ++count;
+            RobEntry &e = rob[index];
+            e = RobEntry{};
+            e.seq = nextSeq++;
+            e.pc = f.pc;
+            e.word = f.word;
+            e.desc = desc;
+            e.op = op;
+            e.nextPC = f.pc + 4;
+            e.prediction = f.prediction;
+            if (op != isa::Op::INVALID) e.regs = isa::registerUse(*desc, f.word);
+
+            // Lê os operandos antes de renomear o destino
+            const Station station{index, operand(e.regs.src1), operand(e.regs.src2)};
+            claim(e, index);
+            if (memoryOp) {
+                lsq.push_back(station);
+            } else if (needsStation) {
+                stations.push_back(station);
+            } else {
+                e.phase = Phase::Done;
+                resolve(index); // entrada velha da BTB numa palavra que não é desvio
+            }
+        }
+        if (stall) process.ooo.dispatchStalls[static_cast<unsigned>(*stall)]++;
+    }
+
+    void fetch() {
+        if (fetchStall > 0) {
+            --fetchStall;
+            process.branch_flush_cycles.fetch_add(1);
+            return;
+        }
+        if (fetchEnded || draining) return;
+        for (unsigned n = 0; n < cfg.width && fetchQueue.size() < 2 * cfg.width; ++n) {
+            Fetched f;
+            f.pc = fetchPC;
+            f.word = memory.read(fetchPC, process);
+            if (f.word == isa::END_WORD) {
+                fetchQueue.push_back(f);
+                fetchEnded = true;
+                return;
+            }
+            f.prediction = process.branchPredictor.predict(fetchPC);
+            fetchPC = f.prediction.nextPC;
+            fetchQueue.push_back(f);
+            if (fetchPC != f.pc + 4) return; // o grupo de busca termina num desvio previsto como tomado
+        }
+    }
+};
+
+} // namespace
+
+void* OooCore(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock) {
+    OutOfOrderCore core(memoryManager, process, *ioRequests, printLock);
+    core.run();
+    return nullptr;
+}
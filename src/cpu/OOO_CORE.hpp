@@ -0,0 +1,72 @@
+#ifndef OOO_CORE_HPP
+#define OOO_CORE_HPP
+/*
+  OOO_CORE.hpp
+  Núcleo fora de ordem (Tomasulo com ROB), alternativa a Core() para medir
+  quanto paralelismo de instruções as cargas de trabalho têm.
+
+  - Front end de largura configurável: busca até 'width' instruções por ciclo
+    seguindo o preditor de desvios do processo (o grupo termina num desvio
+    previsto como tomado) e despacha até 'width' por ciclo.
+  - Renomeação pelo ROB: a tabela de renomeação aponta cada registrador
+    (inclusive HI e LO) para a entrada do ROB que vai produzi-lo.
+  - Estações de reserva comuns a todas as unidades. Latência e intervalo de
+    cada unidade vêm de PipelineConfig; 'units' diz quantas há de cada tipo.
+    Os resultados voltam pelo barramento comum e acordam quem espera por eles.
+  - Fila de loads/stores em ordem de programa: um lw espera os endereços dos
+    sw mais antigos e recebe o valor direto do sw mais novo no mesmo endereço.
+  - Commit em ordem, até 'width' por ciclo. Só o commit escreve no
+    REGISTER_BANK e na memória (sw) e faz print/end, então uma previsão errada
+    descarta as entradas mais novas sem deixar rastro.
+  - Instruções vetoriais passam pelas estações (vadd/vsub/vmul) e pela LSQ
+    (vload/vstore) só para o tempo; os valores são calculados no commit, em
+    ordem. Um lw espera os vstore mais antigos que cobrem o seu endereço.
+  - ll/sc e atômicas executam só na cabeça do ROB; os lw mais novos esperam.
+
+  Executa com a ALU e o MemoryManager, como Core(). O quantum é contado em
+  ciclos: quando acaba, a busca para e o que já foi buscado termina.
+*/
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using std::unique_ptr;
+using std::vector;
+
+class MemoryManager;
+struct PCB;
+struct IORequest;
+
+// Por que o despacho parou antes de completar a largura num ciclo
+enum class OooStall : uint8_t { RobFull, StationsFull, LsqFull, FrontEnd };
+inline constexpr unsigned OOO_STALL_CAUSES = 4;
+
+const char *ooo_stall_name(OooStall cause);
+
+struct OooConfig {
+    unsigned width = 2;        // busca, despacho, emissão e commit por ciclo
+    unsigned robEntries = 32;
+    unsigned stations = 16;    // estações de reserva (fora lw/sw, que ficam na LSQ)
+    unsigned lsqEntries = 8;
+    std::array<unsigned, 4> units{{2, 1, 1, 1}}; // quantas unidades de cada tipo, na ordem de UnitKind
+};
+
+// invalid_argument se algum tamanho ou número de unidades for zero
+void setOooConfig(const OooConfig &config);
+OooConfig oooConfig();
+
+// Histogramas acumulados no PCB (vazios se o processo nunca rodou fora de ordem)
+struct OooStats {
+    vector<uint64_t> robOccupancy;       // ciclos com N entradas ocupadas no ROB
+    vector<uint64_t> committedPerCycle;  // ciclos com N instruções confirmadas
+    std::array<uint64_t, OOO_STALL_CAUSES> dispatchStalls{};
+    uint64_t squashed = 0;               // instruções descartadas por previsão errada
+
+    double meanRobOccupancy() const;
+};
+
+// Mesma assinatura de Core()
+void* OooCore(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock);
+
+#endif // OOO_CORE_HPP
@@ -7,10 +7,13 @@
   contadores de instrumentação de pipeline/memória.
 */
 #include <string>
+#include <vector>
 #include <atomic>
 #include <cstdint>
 #include "memory/cache.hpp"
 #include "REGISTER_BANK.hpp" // necessidade de objeto completo dentro do PCB
+#include "BRANCH_PREDICTOR.hpp"
+#include "OOO_CORE.hpp"
 
 
 // Estados possíveis do processo (simplificado)
@@ -32,6 +35,7 @@ struct PCB {
     std::string name;
     int quantum = 0;
     int priority = 0;
+    uint64_t arrival_time = 0; // ciclo (do escalonador) em que o processo fica pronto
 
     State state = State::Ready;
     hw::REGISTER_BANK regBank;
@@ -46,18 +50,112 @@ struct PCB {
 
     // Instrumentação detalhada
     std::atomic<uint64_t> pipeline_cycles{0};
+    std::atomic<uint64_t> pipeline_drain_cycles{0}; // parte de pipeline_cycles esvaziando o pipeline no fim de Core()
     std::atomic<uint64_t> stage_invocations{0};
     std::atomic<uint64_t> mem_reads{0};
     std::atomic<uint64_t> mem_writes{0};
+    std::atomic<uint64_t> instructions_retired{0}; // instruções que completaram (bolhas não contam)
 
     // Novos contadores
     std::atomic<uint64_t> cache_hits{0};
     std::atomic<uint64_t> cache_misses{0};
     std::atomic<uint64_t> io_cycles{1};
+    std::atomic<uint64_t> io_ready_cycle{0}; // término do último I/O, em ciclos do escalonador (IOManager)
+
+    // Previsão de desvios
+    std::atomic<uint64_t> branch_predictions{0};    // desvios resolvidos no EX
+    std::atomic<uint64_t> branch_mispredictions{0};
+    std::atomic<uint64_t> branch_flush_cycles{0};   // bolhas de flush + Fetch parado pela penalidade
+
+    // Hazards do pipeline (ciclos parados por causa e operandos adiantados)
+    std::atomic<uint64_t> stall_raw_cycles{0};        // dependência sem caminho de adiantamento
+    std::atomic<uint64_t> stall_load_use_cycles{0};   // esperando o valor de um lw
+    std::atomic<uint64_t> stall_structural_cycles{0}; // Fetch sem a porta de memória (lw/sw no MEM)
+    std::atomic<uint64_t> forwards_ex_ex{0};
+    std::atomic<uint64_t> forwards_mem_ex{0};
+    std::atomic<uint64_t> stall_fu_latency_cycles{0}; // operando de mult/div/lw ainda na unidade funcional
+    std::atomic<uint64_t> stall_fu_busy_cycles{0};    // unidade não segmentada ocupada
+
+    // Emissão de várias instruções por ciclo (PipelineConfig::issueWidth)
+    std::atomic<uint64_t> issue_split_dependency{0}; // grupo separado por dependência
+    std::atomic<uint64_t> issue_split_structural{0}; // grupo separado por unidade ou desvio
+    std::vector<uint64_t> issue_width_cycles;        // ciclos em que N instruções saíram do Decode
+
+    // Store buffer (PipelineConfig::storeBufferEntries)
+    std::atomic<uint64_t> loads_forwarded{0};          // lw que recebeu o valor de um sw no buffer
+    std::atomic<uint64_t> store_buffer_full_stalls{0}; // sw que encontrou o buffer cheio
+
+    // Macro-fusão (PipelineConfig::macroFusion)
+    std::atomic<uint64_t> fused_pairs{0};              // pares que passaram pelo pipeline como uma instrução
+
+    // Instruções vetoriais (SIMD)
+    std::atomic<uint64_t> vector_instructions{0};      // vadd/vsub/vmul/vload/vstore completadas
+    std::atomic<uint64_t> vector_lanes{0};             // palavras processadas por elas
+
+    // Sincronização (ll/sc, amoswap, amoadd; MemoryManager::atomic)
+    std::atomic<uint64_t> atomic_operations{0};        // ll, sc e atômicas executadas
+    std::atomic<uint64_t> sc_failures{0};              // sc que perdeu a reserva e não escreveu
+    std::atomic<uint64_t> spin_iterations{0};          // tentativas repetidas sem progresso (ver MemoryManager)
 
     MemWeights memWeights;
+    BranchPredictor branchPredictor; // persiste entre as fatias do escalonador
+    OooStats ooo;                    // histogramas do núcleo fora de ordem (--engine=ooo)
 };
 
+// Copia o estado completo de um processo. O PCB em si não é copiável por
+// causa dos contadores atômicos; o REGISTER_BANK sabe se copiar.
+inline void copy_pcb_state(const PCB &from, PCB &to) {
+    to.pid = from.pid;
+    to.name = from.name;
+    to.quantum = from.quantum;
+    to.priority = from.priority;
+    to.arrival_time = from.arrival_time;
+    to.state = from.state;
+    to.regBank = from.regBank;
+
+    to.primary_mem_accesses = from.primary_mem_accesses.load();
+    to.secondary_mem_accesses = from.secondary_mem_accesses.load();
+    to.memory_cycles = from.memory_cycles.load();
+    to.mem_accesses_total = from.mem_accesses_total.load();
+    to.extra_cycles = from.extra_cycles.load();
+    to.cache_mem_accesses = from.cache_mem_accesses.load();
+    to.pipeline_cycles = from.pipeline_cycles.load();
+    to.pipeline_drain_cycles = from.pipeline_drain_cycles.load();
+    to.stage_invocations = from.stage_invocations.load();
+    to.mem_reads = from.mem_reads.load();
+    to.mem_writes = from.mem_writes.load();
+    to.instructions_retired = from.instructions_retired.load();
+    to.cache_hits = from.cache_hits.load();
+    to.cache_misses = from.cache_misses.load();
+    to.io_cycles = from.io_cycles.load();
+    to.io_ready_cycle = from.io_ready_cycle.load();
+    to.branch_predictions = from.branch_predictions.load();
+    to.branch_mispredictions = from.branch_mispredictions.load();
+    to.branch_flush_cycles = from.branch_flush_cycles.load();
+    to.stall_raw_cycles = from.stall_raw_cycles.load();
+    to.stall_load_use_cycles = from.stall_load_use_cycles.load();
+    to.stall_structural_cycles = from.stall_structural_cycles.load();
+    to.forwards_ex_ex = from.forwards_ex_ex.load();
+    to.forwards_mem_ex = from.forwards_mem_ex.load();
+    to.stall_fu_latency_cycles = from.stall_fu_latency_cycles.load();
+    to.stall_fu_busy_cycles = from.stall_fu_busy_cycles.load();
+    to.issue_split_dependency = from.issue_split_dependency.load();
+    to.issue_split_structural = from.issue_split_structural.load();
+    to.issue_width_cycles = from.issue_width_cycles;
+    to.loads_forwarded = from.loads_forwarded.load();
+    to.store_buffer_full_stalls = from.store_buffer_full_stalls.load();
+    to.fused_pairs = from.fused_pairs.load();
+    to.vector_instructions = from.vector_instructions.load();
+    to.vector_lanes = from.vector_lanes.load();
+    to.atomic_operations = from.atomic_operations.load();
+    to.sc_failures = from.sc_failures.load();
+    to.spin_iterations = from.spin_iterations.load();
+
+    to.memWeights = from.memWeights;
+    to.branchPredictor = from.branchPredictor;
+    to.ooo = from.ooo;
+}
+
 // Contabilizar cache
 inline void contabiliza_cache(PCB &pcb, bool hit) {
     if (hit) {
@@ -18,6 +18,18 @@ nome for inválido.
 
 namespace hw{
 
+REGISTER REGISTER_BANK::* const ARCH_REGISTER[ARCH_REGISTERS] = {
+    &REGISTER_BANK::zero, &REGISTER_BANK::at, &REGISTER_BANK::v0, &REGISTER_BANK::v1,
+    &REGISTER_BANK::a0, &REGISTER_BANK::a1, &REGISTER_BANK::a2, &REGISTER_BANK::a3,
+    &REGISTER_BANK::t0, &REGISTER_BANK::t1, &REGISTER_BANK::t2, &REGISTER_BANK::t3,
+    &REGISTER_BANK::t4, &REGISTER_BANK::t5, &REGISTER_BANK::t6, &REGISTER_BANK::t7,
+    &REGISTER_BANK::s0, &REGISTER_BANK::s1, &REGISTER_BANK::s2, &REGISTER_BANK::s3,
+    &REGISTER_BANK::s4, &REGISTER_BANK::s5, &REGISTER_BANK::s6, &REGISTER_BANK::s7,
+    &REGISTER_BANK::t8, &REGISTER_BANK::t9, &REGISTER_BANK::k0, &REGISTER_BANK::k1,
+    &REGISTER_BANK::gp, &REGISTER_BANK::sp, &REGISTER_BANK::fp, &REGISTER_BANK::ra,
+    &REGISTER_BANK::hi, &REGISTER_BANK::lo
+};
+
 REGISTER_BANK::REGISTER_BANK(){
     // --- Cada entrada no mapa chama o método read() do registrador correspondente ---
     acessoLeituraRegistradores = {
@@ -71,6 +83,26 @@ REGISTER_BANK::REGISTER_BANK(){
     };
 }
 
+REGISTER_BANK::REGISTER_BANK(const REGISTER_BANK &other) : REGISTER_BANK(){
+    *this = other;
+}
+
+REGISTER_BANK &REGISTER_BANK::operator=(const REGISTER_BANK &other){
+    pc = other.pc; mar = other.mar; cr = other.cr; epc = other.epc;
+    sr = other.sr; hi = other.hi; lo = other.lo; ir = other.ir;
+    zero = other.zero; at = other.at;
+    v0 = other.v0; v1 = other.v1;
+    a0 = other.a0; a1 = other.a1; a2 = other.a2; a3 = other.a3;
+    t0 = other.t0; t1 = other.t1; t2 = other.t2; t3 = other.t3; t4 = other.t4;
+    t5 = other.t5; t6 = other.t6; t7 = other.t7; t8 = other.t8; t9 = other.t9;
+    s0 = other.s0; s1 = other.s1; s2 = other.s2; s3 = other.s3;
+    s4 = other.s4; s5 = other.s5; s6 = other.s6; s7 = other.s7;
+    k0 = other.k0; k1 = other.k1;
+    gp = other.gp; sp = other.sp; fp = other.fp; ra = other.ra;
+    w = other.w;
+    return *this;
+}
+
 uint32_t REGISTER_BANK::readRegister(const string &name) const{
     auto it = acessoLeituraRegistradores.find(name);
 
@@ -95,6 +127,7 @@ void REGISTER_BANK::reset(){
     for (auto const& [name, func] : acessoEscritaRegistradores){
         func(0);
     }
+    w = {};
 }
 
 void REGISTER_BANK::print_registers() const{
@@ -20,7 +20,9 @@ faz e quais funções ela tem.
 #define REGISTER_BANK_HPP
 
 #include "REGISTER.hpp"
+#include "ISA.hpp"
 
+#include <array>
 #include <cstdint>
 #include <string>
 
@@ -52,6 +54,10 @@ namespace hw{
         REGISTER k0, k1;
         REGISTER gp, sp, fp, ra;
 
+        // --- Registradores vetoriais ($w0..$w7), usados pelas instruções SIMD ---
+        using VECTOR = std::array<uint32_t, isa::VECTOR_LANES>;
+        std::array<VECTOR, isa::VECTOR_REGISTERS> w{};
+
         // --- Mapas de acesso por nome (a interface principal para a Control_Unit) ---
         unordered_map<string, function<uint32_t()>> acessoLeituraRegistradores;
         unordered_map<string, function<void(uint32_t)>> acessoEscritaRegistradores;
@@ -59,6 +65,12 @@ namespace hw{
         // Construtor: Declarado aqui, implementado no .cpp
         REGISTER_BANK();
 
+        // Cópia: os mapas capturam 'this', então só os valores são copiados e
+        // cada objeto mantém os próprios mapas (a cópia padrão leria/escreveria
+        // nos registradores do original).
+        REGISTER_BANK(const REGISTER_BANK &other);
+        REGISTER_BANK &operator=(const REGISTER_BANK &other);
+
         // Leitura segura por nome.
         uint32_t readRegister(const string &name) const;
 
@@ -74,6 +86,11 @@ namespace hw{
 
     };
 
+    // Registradores arquiteturais por número (0..31, depois HI e LO), para os
+    // núcleos que guardam o estado num vetor (OOO_CORE, SMT_CORE)
+    inline constexpr unsigned ARCH_REGISTERS = 34;
+    extern REGISTER REGISTER_BANK::* const ARCH_REGISTER[ARCH_REGISTERS];
+
 } 
 
 #endif 
@@ -0,0 +1,334 @@
+#include "SMT_CORE.hpp"
+#include "CONTROL_UNIT.hpp"
+#include "ISA.hpp"
+#include "ULA.hpp"
+#include "PCB.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../IO/IOManager.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+SmtPolicy smt_policy_from_string(const std::string &name) {
+    if (name == "interleaved") return SmtPolicy::Interleaved;
+    if (name == "miss") return SmtPolicy::SwitchOnMiss;
+    throw std::invalid_argument("Politica de multithreading desconhecida: " + name + " (interleaved ou miss)");
+}
+
+const char *smt_policy_name(SmtPolicy policy) {
+    return policy == SmtPolicy::Interleaved ? "interleaved" : "miss";
+}
+
+uint64_t SmtReport::sequentialCycles() const {
+    uint64_t total = 0;
+    for (const SmtThreadStats &t : threads) total += t.aloneCycles;
+    return total;
+}
+
+double SmtReport::speedup() const {
+    const uint64_t sequential = sequentialCycles();
+    return sequential && cycles ? double(sequential) / cycles : 0.0;
+}
+
+namespace {
+
+constexpr unsigned NONE = std::numeric_limits<unsigned>::max();
+
+// Um contexto de hardware: o estado arquitetural do processo num vetor
+struct Context {
+    PCB *process = nullptr;
+    uint32_t regs[hw::ARCH_REGISTERS]{};
+    uint32_t pc = 0;
+    uint64_t readyAt = 0;   // ciclo em que a próxima instrução pode sair
+    bool waitingMemory = false;
+    bool done = false;
+    SmtThreadStats stats;
+    uint64_t scFailuresBefore = 0, spinsBefore = 0;
+};
+
+uint32_t aluResult(operation op, uint32_t a, uint32_t b) {
+    ALU alu;
+    alu.A = a;
+    alu.B = b;
+    alu.op = op;
+    alu.calculate();
+    return static_cast<uint32_t>(alu.result);
+}
+
+class MultithreadedCore {
+public:
+    MultithreadedCore(MemoryManager &memory, const std::vector<PCB*> &processes, const SmtConfig &config,
+                      std::vector<std::unique_ptr<IORequest>> &io)
+        : cfg(config), timing(pipelineConfig()), memory(memory), io(io), contexts(processes.size()) {
+        for (size_t i = 0; i < processes.size(); ++i) {
+            Context &c = contexts[i];
+            c.process = processes[i];
+            const hw::REGISTER_BANK &bank = c.process->regBank;
+            for (unsigned r = 0; r < hw::ARCH_REGISTERS; ++r) c.regs[r] = (bank.*hw::ARCH_REGISTER[r]).value;
+            c.regs[0] = 0;
+            c.pc = bank.pc.value;
+            c.done = c.process->state == State::Finished;
+            c.stats.pid = c.process->pid;
+            c.stats.finished = c.done;
+            c.scFailuresBefore = c.process->sc_failures.load();
+            c.spinsBefore = c.process->spin_iterations.load();
+        }
+        report.policy = cfg.policy;
+    }
+
+    SmtReport run() {
+        while (cycle < cfg.maxCycles && std::any_of(contexts.begin(), contexts.end(), [](const Context &c) { return !c.done; })) {
+            const unsigned chosen = pick();
+            if (chosen == NONE) {
+                report.idleCycles++;
+                ++cycle;
+                continue;
+            }
+            step(contexts[chosen]);
+            current = chosen;
+            ++cycle;
+        }
+        // A última instrução de cada contexto ainda termina
+        for (const Context &c : contexts) cycle = std::max(cycle, c.done ? c.stats.finishCycle : c.readyAt);
+
+        report.cycles = cycle;
+        for (Context &c : contexts) {
+            hw::REGISTER_BANK &bank = c.process->regBank;
+            for (unsigned r = 1; r < hw::ARCH_REGISTERS; ++r) (bank.*hw::ARCH_REGISTER[r]).value = c.regs[r];
+            bank.pc.write(c.pc);
+            if (!c.done) c.stats.finishCycle = cycle;
+            c.process->pipeline_cycles.fetch_add(c.stats.finishCycle);
+            c.stats.scFailures = c.process->sc_failures.load() - c.scFailuresBefore;
+            c.stats.spinIterations = c.process->spin_iterations.load() - c.spinsBefore;
+            report.instructions += c.stats.instructions;
+            report.threads.push_back(c.stats);
+        }
+        return report;
+    }
+
+private:
+    const SmtConfig cfg;
+    const PipelineConfig timing;
+    MemoryManager &memory;
+    std::vector<std::unique_ptr<IORequest>> &io;
+    std::vector<Context> contexts;
+    std::array<uint64_t, UNIT_COUNT> unitFree{};
+    unsigned current = 0;
+    uint64_t cycle = 0;
+    SmtReport report;
+
+    bool ready(const Context &c) const { return !c.done && c.readyAt <= cycle; }
+
+    // Próximo contexto pronto depois de 'from', em rodízio
+    unsigned nextReady(unsigned from) const {
+        const unsigned n = static_cast<unsigned>(contexts.size());
+        for (unsigned k = 1; k <= n; ++k) {
+            const unsigned i = (from + k) % n;
+            if (ready(contexts[i])) return i;
+        }
+        return NONE;
+    }
+
+    unsigned pick() {
+        if (cfg.policy == SmtPolicy::Interleaved) return nextReady(current);
+
+        const Context &c = contexts[current];
+        if (ready(c)) return current;
+        // Espera curta (unidade funcional): o contexto fica com o núcleo
+        if (!c.done && !c.waitingMemory) return NONE;
+        const unsigned other = nextReady(current);
+        if (other == NONE || other == current) return NONE;
+        // Troca: as instruções do contexto anterior saem do pipeline antes
+        report.switches++;
+        report.switchCycles += cfg.switchPenalty;
+        cycle += cfg.switchPenalty;
+        return other;
+    }
+
+    // Lê/escreve pela hierarquia de memória; devolve o que custou além de um acerto na cache
+    template <typename Access>
+    uint64_t timed(PCB &process, Access access) {
+        const uint64_t before = process.memory_cycles.load();
+        access();
+        const uint64_t cost = process.memory_cycles.load() - before;
+        return cost > process.memWeights.cache ? cost - process.memWeights.cache : 0;
+    }
+
+    // Busca e executa uma instrução do contexto (mesma semântica de Core())
+    void step(Context &c) {
+        PCB &process = *c.process;
+        uint32_t word = 0;
+        uint64_t memoryWait = timed(process, [&] { word = memory.read(c.pc, process); });
+
+        if (word == isa::END_WORD) {
+            // O PC fica no END, como em Core()
+            c.done = true;
+            c.stats.finished = true;
+            c.stats.finishCycle = cycle + 1 + memoryWait;
+            c.stats.memoryWaitCycles += memoryWait;
+            c.stats.instructions++;
+            process.instructions_retired.fetch_add(1);
+            process.state = State::Finished;
+            return;
+        }
+
+        const isa::InstrDesc *desc = isa::decode(word);
+        isa::Op op = desc ? desc->op : isa::Op::INVALID;
+        if (op == isa::Op::END) op = isa::Op::INVALID; // só a palavra END exata encerra
+        const isa::RegisterUse use = op != isa::Op::INVALID ? isa::registerUse(*desc, word) : isa::RegisterUse{};
+        // Os vetoriais ($w0..$w7) ficam direto no REGISTER_BANK do processo
+        auto scalar = [&](uint8_t reg) { return reg < hw::ARCH_REGISTERS ? c.regs[reg] : 0u; };
+        auto vreg = [&](uint32_t field) -> hw::REGISTER_BANK::VECTOR & {
+            return process.regBank.w[field % isa::VECTOR_REGISTERS];
+        };
+        const uint32_t a = scalar(use.src1), b = scalar(use.src2);
+        const uint32_t imm = static_cast<uint32_t>(isa::immOf(word));
+        uint32_t result = 0, nextPC = c.pc + 4;
+        bool writesHiLo = false;
+        uint32_t hi = 0, lo = 0;
+
+        switch (op) {
+            case isa::Op::ADD:  result = aluResult(ADD, a, b);    break;
+            case isa::Op::SUB:  result = aluResult(SUB, a, b);    break;
+            case isa::Op::AND:  result = aluResult(AND_OP, a, b); break;
+            case isa::Op::OR:   result = aluResult(OR_OP, a, b);  break;
+            case isa::Op::MULT: {
+                result = aluResult(MUL, a, b);
+                const uint64_t product = static_cast<uint64_t>(int64_t(int32_t(a)) * int64_t(int32_t(b)));
+                writesHiLo = true;
+                hi = static_cast<uint32_t>(product >> 32);
+                lo = static_cast<uint32_t>(product);
+                break;
+            }
+            case isa::Op::DIV: {
+                const int32_t x = static_cast<int32_t>(a), y = static_cast<int32_t>(b);
+                const bool overflow = x == std::numeric_limits<int32_t>::min() && y == -1;
+                result = lo = aluResult(DIV, a, b);
+                hi = static_cast<uint32_t>(y == 0 ? x : overflow ? 0 : x % y);
+                writesHiLo = true;
+                break;
+            }
+            case isa::Op::SLL:  result = aluResult(SLL, a, isa::shamtOf(word)); break;
+            case isa::Op::SRL:  result = aluResult(SRL, a, isa::shamtOf(word)); break;
+            case isa::Op::MFHI: case isa::Op::MFLO: result = a; break;
+            case isa::Op::ADDI: result = aluResult(ADD, a, imm);              break;
+            case isa::Op::ANDI: result = aluResult(AND_OP, a, imm & 0xFFFFu); break;
+            case isa::Op::ORI:  result = aluResult(OR_OP, a, imm & 0xFFFFu);  break;
+            case isa::Op::SLTI: result = static_cast<int32_t>(a) < static_cast<int32_t>(imm) ? 1u : 0u; break;
+            case isa::Op::LW:
+                memoryWait += timed(process, [&] { result = memory.read(aluResult(ADD, a, imm), process); });
+                break;
+            case isa::Op::SW:
+                memoryWait += timed(process, [&] { memory.write(aluResult(ADD, a, imm), b, process); });
+                break;
+            case isa::Op::LL: case isa::Op::SC: case isa::Op::AMOSWAP: case isa::Op::AMOADD:
+                // Uma instrução por ciclo: ll/sc e atômicas de contextos diferentes não se misturam
+                memoryWait += timed(process, [&] { result = memory.atomic(op, aluResult(ADD, a, imm), b, process, &process); });
+                break;
+            case isa::Op::VADD: case isa::Op::VSUB: case isa::Op::VMUL:
+                vector_calculate(op == isa::Op::VADD ? ADD : op == isa::Op::VSUB ? SUB : MUL, vreg(isa::rsOf(word)).data(),
+                                 vreg(isa::rtOf(word)).data(), vreg(isa::rdOf(word)).data(), desc->lanes);
+                break;
+            case isa::Op::VLOAD:
+                memoryWait += timed(process, [&] {
+                    memory.readVector(aluResult(ADD, a, imm), vreg(isa::rtOf(word)).data(), desc->lanes, process);
+                });
+                break;
+            case isa::Op::VSTORE:
+                memoryWait += timed(process, [&] {
+                    memory.writeVector(aluResult(ADD, a, imm), vreg(isa::rtOf(word)).data(), desc->lanes, process);
+                });
+                break;
+            case isa::Op::BEQ: case isa::Op::BNE: case isa::Op::BGT: case isa::Op::BLT: {
+                const operation cmp = op == isa::Op::BEQ ? BEQ : op == isa::Op::BNE ? BNE
+                                    : op == isa::Op::BGT ? BGT : BLT;
+                if (aluResult(cmp, a, b) == 1) nextPC = isa::branchTarget(c.pc, word);
+                break;
+            }
+            case isa::Op::J:   nextPC = isa::targetOf(word); break;
+            case isa::Op::JAL: nextPC = isa::targetOf(word); result = c.pc + 4; break;
+            case isa::Op::JR:  nextPC = a; break;
+            case isa::Op::PRINT: {
+                auto req = std::make_unique<IORequest>();
+                req->msg = std::to_string(static_cast<int>(a));
+                req->process = &process;
+                io.push_back(std::move(req));
+                break;
+            }
+            default:
+                break;
+        }
+        if (use.dst != 0 && use.dst < hw::ARCH_REGISTERS) c.regs[use.dst] = result;
+        if (isa::isVector(op)) {
+            process.vector_instructions.fetch_add(1);
+            process.vector_lanes.fetch_add(desc->lanes);
+        }
+        if (writesHiLo) {
+            c.regs[isa::REG_HI] = hi;
+            c.regs[isa::REG_LO] = lo;
+        }
+        c.pc = nextPC;
+
+        // A unidade começa quando fica livre (o divisor é um só para todos os contextos)
+        const UnitKind kind = desc ? unit_of(desc->latency) : UnitKind::Alu;
+        const FunctionalUnit &unit = timing.unit(kind);
+        uint64_t &freeAt = unitFree[static_cast<unsigned>(kind)];
+        const uint64_t start = std::max(cycle, freeAt);
+        freeAt = start + unit.interval;
+        c.readyAt = start + unit.latency + memoryWait;
+        c.waitingMemory = memoryWait > 0;
+
+        c.stats.instructions++;
+        c.stats.memoryWaitCycles += memoryWait;
+        process.instructions_retired.fetch_add(1);
+    }
+};
+
+} // namespace
+
+SmtReport run_smt(MemoryManager &memory, const std::vector<PCB*> &processes, const SmtConfig &config,
+                  std::vector<std::unique_ptr<IORequest>>* ioRequests) {
+    if (processes.empty()) throw std::invalid_argument("Multithreading: nenhum processo para os contextos");
+    std::vector<std::unique_ptr<IORequest>> localRequests;
+    MultithreadedCore core(memory, processes, config, ioRequests ? *ioRequests : localRequests);
+    return core.run();
+}
+
+SmtReport compare_smt(MemoryManager &memory, const std::vector<PCB*> &processes, const SmtConfig &config,
+                      std::vector<std::unique_ptr<IORequest>>* ioRequests) {
+    std::vector<uint64_t> alone;
+    for (PCB *process : processes) {
+        std::unique_ptr<MemoryManager> copy = memory.fork();
+        PCB single;
+        copy_pcb_state(*process, single);
+        alone.push_back(run_smt(*copy, {&single}, config).cycles);
+    }
+    SmtReport report = run_smt(memory, processes, config, ioRequests);
+    for (size_t i = 0; i < report.threads.size(); ++i) report.threads[i].aloneCycles = alone[i];
+    return report;
+}
+
+std::string format_smt_report(const SmtReport &report) {
+    std::ostringstream out;
+    out << report.threads.size() << " contextos (" << smt_policy_name(report.policy) << "), "
+        << report.instructions << " instrucoes em " << report.cycles << " ciclos, IPC " << report.ipc() << "\n";
+    out << "  Ciclos ociosos: " << report.idleCycles;
+    if (report.policy == SmtPolicy::SwitchOnMiss)
+        out << ", trocas de contexto: " << report.switches << " (" << report.switchCycles << " ciclos)";
+    out << "\n";
+    if (report.sequentialCycles() > 0)
+        out << "  Um contexto so (em sequencia): " << report.sequentialCycles() << " ciclos, ganho "
+            << report.speedup() << "x\n";
+    for (const SmtThreadStats &t : report.threads) {
+        out << "  Processo " << t.pid << ": " << t.instructions << " instrucoes, terminou no ciclo "
+            << t.finishCycle << (t.finished ? "" : " (limite atingido)") << ", espera de memoria "
+            << t.memoryWaitCycles;
+        if (t.aloneCycles > 0) out << ", sozinho " << t.aloneCycles << " (lentidao " << t.slowdown() << "x)";
+        if (t.scFailures > 0 || t.spinIterations > 0)
+            out << ", sc falhos " << t.scFailures << ", spins " << t.spinIterations;
+        out << "\n";
+    }
+    return out.str();
+}
@@ -0,0 +1,89 @@
+#ifndef SMT_CORE_HPP
+#define SMT_CORE_HPP
+/*
+  SMT_CORE.hpp
+  Multithreading de hardware num só núcleo: vários contextos (o REGISTER_BANK
+  e o PC de cada PCB) dividem a mesma unidade de busca, as mesmas unidades
+  funcionais e a mesma cache, para medir quanto da latência da memória a
+  troca de contexto esconde em relação a um contexto só.
+
+  - Núcleo escalar em ordem: no máximo uma instrução de um contexto sai por
+    ciclo. Cada contexto tem no máximo uma instrução em execução (a próxima
+    só é buscada quando a anterior termina), então desvios não precisam de
+    previsão e não há hazards entre contextos.
+  - Latência de uma instrução: a da unidade funcional (PipelineConfig) mais o
+    que a busca e o lw/sw custaram além de um acerto na cache
+    (memory_cycles - memWeights.cache, medido no próprio MemoryManager). O
+    divisor não segmentado é disputado pelos contextos.
+  - Política de escolha do contexto:
+      Interleaved   (barrel/fino): a cada ciclo, o próximo contexto pronto
+                    em rodízio;
+      SwitchOnMiss  (grosso): fica no mesmo contexto até ele esperar a
+                    memória; a troca custa 'switchPenalty' ciclos sem emissão.
+    Com um contexto as duas políticas são o núcleo de um contexto só.
+
+  Os processos rodam até o fim (ou maxCycles), sem quantum; print não
+  bloqueia. O estado arquitetural final é o mesmo do núcleo rápido.
+*/
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MemoryManager;
+struct PCB;
+struct IORequest;
+
+enum class SmtPolicy { Interleaved, SwitchOnMiss };
+
+SmtPolicy smt_policy_from_string(const std::string &name); // invalid_argument se desconhecida
+const char *smt_policy_name(SmtPolicy policy);
+
+struct SmtConfig {
+    SmtPolicy policy = SmtPolicy::Interleaved;
+    unsigned switchPenalty = 3;          // SwitchOnMiss: ciclos para esvaziar o pipeline na troca
+    uint64_t maxCycles = UINT64_MAX;     // limite (programas que não terminam)
+};
+
+struct SmtThreadStats {
+    int pid = 0;
+    uint64_t instructions = 0;
+    uint64_t finishCycle = 0;            // ciclo do núcleo em que o END saiu (ou o fim da execução)
+    uint64_t memoryWaitCycles = 0;       // latência de memória além dos acertos na cache
+    bool finished = false;
+    uint64_t aloneCycles = 0;            // sozinho no mesmo núcleo (compare_smt), 0 se não medido
+    uint64_t scFailures = 0;             // contenção nesta execução (PCB::sc_failures, spin_iterations)
+    uint64_t spinIterations = 0;
+
+    double slowdown() const { return aloneCycles ? double(finishCycle) / aloneCycles : 0.0; }
+};
+
+struct SmtReport {
+    SmtPolicy policy = SmtPolicy::Interleaved;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t idleCycles = 0;             // nenhum contexto pronto
+    uint64_t switches = 0;               // SwitchOnMiss
+    uint64_t switchCycles = 0;
+    std::vector<SmtThreadStats> threads;
+
+    double ipc() const { return cycles ? double(instructions) / cycles : 0.0; }
+    // Ciclos para rodar os mesmos processos um depois do outro num contexto só
+    uint64_t sequentialCycles() const;
+    double speedup() const;              // sequentialCycles / cycles (0 se não medido)
+};
+
+// Um contexto por processo (invalid_argument se a lista estiver vazia).
+// Atualiza registradores, PC, estado e contadores de cada PCB.
+SmtReport run_smt(MemoryManager &memory, const std::vector<PCB*> &processes, const SmtConfig &config = {},
+                  std::vector<std::unique_ptr<IORequest>>* ioRequests = nullptr);
+
+// Mede antes cada processo sozinho (cópias do PCB numa bifurcação da memória)
+// e depois roda todos juntos com run_smt, preenchendo aloneCycles.
+SmtReport compare_smt(MemoryManager &memory, const std::vector<PCB*> &processes, const SmtConfig &config = {},
+                      std::vector<std::unique_ptr<IORequest>>* ioRequests = nullptr);
+
+// Relatório legível (várias linhas)
+std::string format_smt_report(const SmtReport &report);
+
+#endif // SMT_CORE_HPP
@@ -1,6 +1,20 @@
 #include "ULA.hpp"
 #include <limits>
 
+#if !defined(ULA_NO_SIMD) && defined(__AVX2__)
+#define ULA_SIMD_AVX2 1
+#include <immintrin.h>
+#elif !defined(ULA_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define ULA_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#elif !defined(ULA_NO_SIMD) && defined(__ARM_NEON)
+#define ULA_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
 /*
   ULA.hpp (Provisório - JP)
   Observações:
@@ -105,6 +119,27 @@ void ALU::calculate(){
         break;
     }
 
+    case OR_OP:
+    {
+        // Operação bit a bit OR
+        result = static_cast<int32_t>(A | B);
+        break;
+    }
+
+    case SLL:
+    {
+        // Shift lógico à esquerda (B contém o shamt, 0..31)
+        result = static_cast<int32_t>(A << (B & 0x1Fu));
+        break;
+    }
+
+    case SRL:
+    {
+        // Shift lógico à direita: preenche com zeros (A tratado como unsigned)
+        result = static_cast<int32_t>(A >> (B & 0x1Fu));
+        break;
+    }
+
     case BEQ:
     {
         // Branch if equal: result = 1 se A == B, senão 0
@@ -183,3 +218,81 @@ void ALU::execute(operation ALUop, uint32_t a, uint32_t b, uint32_t shamt){
     calculate();
 }
 
+// ---- Operações vetoriais ----
+
+namespace {
+
+// Uma lane (também o caminho escalar): aritmética em 32 bits sem sinal, que
+// dá os mesmos bits baixos da conta com sinal de calculate()
+inline uint32_t lane(operation op, uint32_t a, uint32_t b) {
+    switch (op) {
+        case ADD: return a + b;
+        case SUB: return a - b;
+        case MUL: return static_cast<uint32_t>(static_cast<uint64_t>(a) * b);
+        default:  return 0;
+    }
+}
+
+#if defined(ULA_SIMD_AVX2)
+inline void lanes8(operation op, const uint32_t *a, const uint32_t *b, uint32_t *out) {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+    const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b));
+    const __m256i r = op == ADD ? _mm256_add_epi32(x, y) : op == SUB ? _mm256_sub_epi32(x, y) : _mm256_mullo_epi32(x, y);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), r);
+}
+#endif
+
+#if defined(ULA_SIMD_AVX2) || defined(ULA_SIMD_SSE2)
+inline __m128i mul4(__m128i x, __m128i y) {
+#if defined(__SSE4_1__)
+    return _mm_mullo_epi32(x, y);
+#else
+    // Sem SSE4.1: produtos de 64 bits das lanes pares e das ímpares, e os 32 bits baixos de cada um
+    const __m128i even = _mm_mul_epu32(x, y);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+
+inline void lanes4(operation op, const uint32_t *a, const uint32_t *b, uint32_t *out) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+    const __m128i r = op == ADD ? _mm_add_epi32(x, y) : op == SUB ? _mm_sub_epi32(x, y) : mul4(x, y);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), r);
+}
+#elif defined(ULA_SIMD_NEON)
+inline void lanes4(operation op, const uint32_t *a, const uint32_t *b, uint32_t *out) {
+    const uint32x4_t x = vld1q_u32(a), y = vld1q_u32(b);
+    vst1q_u32(out, op == ADD ? vaddq_u32(x, y) : op == SUB ? vsubq_u32(x, y) : vmulq_u32(x, y));
+}
+#endif
+
+} // namespace
+
+void vector_calculate(operation op, const uint32_t *a, const uint32_t *b, uint32_t *out, unsigned lanes) {
+    unsigned i = 0;
+    if (op == ADD || op == SUB || op == MUL) {
+#if defined(ULA_SIMD_AVX2)
+        for (; i + 8 <= lanes; i += 8) lanes8(op, a + i, b + i, out + i);
+#endif
+#if defined(ULA_SIMD_AVX2) || defined(ULA_SIMD_SSE2) || defined(ULA_SIMD_NEON)
+        for (; i + 4 <= lanes; i += 4) lanes4(op, a + i, b + i, out + i);
+#endif
+    }
+    for (; i < lanes; ++i) out[i] = lane(op, a[i], b[i]);
+}
+
+const char *vector_backend() {
+#if defined(ULA_SIMD_AVX2)
+    return "avx2";
+#elif defined(ULA_SIMD_SSE2) && defined(__SSE4_1__)
+    return "sse4.1";
+#elif defined(ULA_SIMD_SSE2)
+    return "sse2";
+#elif defined(ULA_SIMD_NEON)
+    return "neon";
+#else
+    return "escalar";
+#endif
+}
@@ -9,6 +9,7 @@ enum operation
     MUL,
     DIV,
     AND_OP,
+    OR_OP,
     BEQ,
     BNE,
     BLT,
@@ -17,7 +18,9 @@ enum operation
     BLTI, // BLTI immediate - Compara A < B (B é usado como imediato)
     LW,   // Load word - calcula endereço (base + offset)
     LA,   // Load adress - similar a LW (retorna enredeço efetivo)
-    ST    // Store - calcula endereço para gravação (base + offset)
+    ST,   // Store - calcula endereço para gravação (base + offset)
+    SLL,  // Shift lógico à esquerda - A << B (B = shamt)
+    SRL   // Shift lógico à direita - A >> B (B = shamt)
 };
 
 class ALU
@@ -36,4 +39,15 @@ public:
     void calculate();
     void execute(operation ALUop, uint32_t a, uint32_t b, uint32_t shamt = 0);
 };
+
+// Instruções vetoriais: out[i] = a[i] op b[i] para as 'lanes' primeiras
+// posições (op: ADD, SUB ou MUL). Cada lane fica com os 32 bits baixos do
+// resultado, como 'result' em calculate(); overflow não é sinalizado.
+// Usa as instruções SIMD do hospedeiro quando o compilador as habilita
+// (AVX2, SSE2/SSE4.1 ou NEON) e um laço escalar nos outros casos ou com
+// ULA_NO_SIMD definido.
+void vector_calculate(operation op, const uint32_t *a, const uint32_t *b, uint32_t *out, unsigned lanes);
+
+// Implementação escolhida na compilação: "avx2", "sse4.1", "sse2", "neon" ou "escalar"
+const char *vector_backend();
 #endif // ULA_HPP
\ No newline at end of file
@@ -0,0 +1,292 @@
+#include "checkpoint.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../IO/IOManager.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace {
+
+const char CHECKPOINT_MAGIC[4] = {'V', 'N', 'C', 'K'};
+
+using hw::REGISTER_BANK;
+
+// Todos os registradores, na ordem do arquivo ($zero é sempre 0 e fica de fora)
+constexpr REGISTER REGISTER_BANK::*REGISTERS[] = {
+    &REGISTER_BANK::pc, &REGISTER_BANK::mar, &REGISTER_BANK::cr, &REGISTER_BANK::epc,
+    &REGISTER_BANK::sr, &REGISTER_BANK::hi, &REGISTER_BANK::lo, &REGISTER_BANK::ir,
+    &REGISTER_BANK::at, &REGISTER_BANK::v0, &REGISTER_BANK::v1,
+    &REGISTER_BANK::a0, &REGISTER_BANK::a1, &REGISTER_BANK::a2, &REGISTER_BANK::a3,
+    &REGISTER_BANK::t0, &REGISTER_BANK::t1, &REGISTER_BANK::t2, &REGISTER_BANK::t3, &REGISTER_BANK::t4,
+    &REGISTER_BANK::t5, &REGISTER_BANK::t6, &REGISTER_BANK::t7, &REGISTER_BANK::t8, &REGISTER_BANK::t9,
+    &REGISTER_BANK::s0, &REGISTER_BANK::s1, &REGISTER_BANK::s2, &REGISTER_BANK::s3,
+    &REGISTER_BANK::s4, &REGISTER_BANK::s5, &REGISTER_BANK::s6, &REGISTER_BANK::s7,
+    &REGISTER_BANK::k0, &REGISTER_BANK::k1, &REGISTER_BANK::gp, &REGISTER_BANK::sp,
+    &REGISTER_BANK::fp, &REGISTER_BANK::ra,
+};
+
+// Contadores do PCB, na ordem do arquivo
+constexpr std::atomic<uint64_t> PCB::*COUNTERS[] = {
+    &PCB::primary_mem_accesses, &PCB::secondary_mem_accesses, &PCB::memory_cycles,
+    &PCB::mem_accesses_total, &PCB::extra_cycles, &PCB::cache_mem_accesses,
+    &PCB::pipeline_cycles, &PCB::stage_invocations, &PCB::mem_reads, &PCB::mem_writes,
+    &PCB::instructions_retired, &PCB::cache_hits, &PCB::cache_misses, &PCB::io_cycles,
+    &PCB::branch_predictions, &PCB::branch_mispredictions, &PCB::branch_flush_cycles,
+    &PCB::stall_raw_cycles, &PCB::stall_load_use_cycles, &PCB::stall_structural_cycles,
+    &PCB::forwards_ex_ex, &PCB::forwards_mem_ex,
+    &PCB::stall_fu_latency_cycles, &PCB::stall_fu_busy_cycles,
+    &PCB::issue_split_dependency, &PCB::issue_split_structural,
+    &PCB::loads_forwarded, &PCB::store_buffer_full_stalls, &PCB::fused_pairs,
+    &PCB::vector_instructions, &PCB::vector_lanes,
+    &PCB::atomic_operations, &PCB::sc_failures, &PCB::spin_iterations,
+    &PCB::pipeline_drain_cycles,
+};
+
+// Histograma (largura de emissão, núcleo fora de ordem): tamanho e contagens
+void saveHistogram(std::ostream &out, const std::vector<uint64_t> &histogram) {
+    ckpt::put<uint32_t>(out, static_cast<uint32_t>(histogram.size()));
+    for (uint64_t n : histogram) ckpt::put<uint64_t>(out, n);
+}
+
+void loadHistogram(std::istream &in, std::vector<uint64_t> &histogram) {
+    const uint32_t size = ckpt::get<uint32_t>(in);
+    if (size > (1u << 16)) throw std::runtime_error("Checkpoint corrompido (histograma)");
+    histogram.assign(size, 0);
+    for (uint64_t &n : histogram) n = ckpt::get<uint64_t>(in);
+}
+
+void savePCB(std::ostream &out, const PCB &p) {
+    ckpt::put<int32_t>(out, p.pid);
+    ckpt::putString(out, p.name);
+    ckpt::put<int32_t>(out, p.quantum);
+    ckpt::put<int32_t>(out, p.priority);
+    ckpt::put<uint64_t>(out, p.arrival_time);
+    ckpt::put<uint8_t>(out, static_cast<uint8_t>(p.state));
+    for (auto reg : REGISTERS) ckpt::put<uint32_t>(out, (p.regBank.*reg).read());
+    for (const auto &vector : p.regBank.w)
+        for (uint32_t lane : vector) ckpt::put<uint32_t>(out, lane);
+    for (auto counter : COUNTERS) ckpt::put<uint64_t>(out, (p.*counter).load());
+    ckpt::put<uint64_t>(out, p.memWeights.cache);
+    ckpt::put<uint64_t>(out, p.memWeights.primary);
+    ckpt::put<uint64_t>(out, p.memWeights.secondary);
+    p.branchPredictor.saveState(out);
+    saveHistogram(out, p.issue_width_cycles);
+    saveHistogram(out, p.ooo.robOccupancy);
+    saveHistogram(out, p.ooo.committedPerCycle);
+    for (uint64_t n : p.ooo.dispatchStalls) ckpt::put<uint64_t>(out, n);
+    ckpt::put<uint64_t>(out, p.ooo.squashed);
+}
+
+void loadPCB(std::istream &in, PCB &p) {
+    p.pid = ckpt::get<int32_t>(in);
+    p.name = ckpt::getString(in);
+    p.quantum = ckpt::get<int32_t>(in);
+    p.priority = ckpt::get<int32_t>(in);
+    p.arrival_time = ckpt::get<uint64_t>(in);
+    const uint8_t state = ckpt::get<uint8_t>(in);
+    if (state > static_cast<uint8_t>(State::Finished)) throw std::runtime_error("Checkpoint corrompido (estado de processo)");
+    p.state = static_cast<State>(state);
+    for (auto reg : REGISTERS) (p.regBank.*reg).write(ckpt::get<uint32_t>(in));
+    for (auto &vector : p.regBank.w)
+        for (uint32_t &lane : vector) lane = ckpt::get<uint32_t>(in);
+    for (auto counter : COUNTERS) (p.*counter) = ckpt::get<uint64_t>(in);
+    p.memWeights.cache = ckpt::get<uint64_t>(in);
+    p.memWeights.primary = ckpt::get<uint64_t>(in);
+    p.memWeights.secondary = ckpt::get<uint64_t>(in);
+    p.branchPredictor.loadState(in);
+    loadHistogram(in, p.issue_width_cycles);
+    loadHistogram(in, p.ooo.robOccupancy);
+    loadHistogram(in, p.ooo.committedPerCycle);
+    for (uint64_t &n : p.ooo.dispatchStalls) n = ckpt::get<uint64_t>(in);
+    p.ooo.squashed = ckpt::get<uint64_t>(in);
+}
+
+// Processos são referenciados pelo índice em SchedulerState::processes
+class ProcessIndex {
+public:
+    explicit ProcessIndex(const std::vector<std::unique_ptr<PCB>> &processes) {
+        for (uint32_t i = 0; i < processes.size(); ++i) index[processes[i].get()] = i;
+    }
+    void put(std::ostream &out, const PCB *p) const {
+        auto it = index.find(p);
+        if (it == index.end()) throw std::runtime_error("Checkpoint: processo fora da lista do escalonador");
+        ckpt::put<uint32_t>(out, it->second);
+    }
+    template <typename Range>
+    void putAll(std::ostream &out, const Range &range) const {
+        ckpt::put<uint32_t>(out, static_cast<uint32_t>(range.size()));
+        for (const PCB *p : range) put(out, p);
+    }
+
+private:
+    std::unordered_map<const PCB*, uint32_t> index;
+};
+
+PCB *getProcess(std::istream &in, const std::vector<std::unique_ptr<PCB>> &processes) {
+    const uint32_t i = ckpt::get<uint32_t>(in);
+    if (i >= processes.size()) throw std::runtime_error("Checkpoint corrompido (indice de processo)");
+    return processes[i].get();
+}
+
+template <typename Container>
+void getAll(std::istream &in, const std::vector<std::unique_ptr<PCB>> &processes, Container &into) {
+    into.clear();
+    for (uint32_t n = ckpt::get<uint32_t>(in); n > 0; --n) into.push_back(getProcess(in, processes));
+}
+
+} // namespace
+
+SchedulerState fork_scheduler(const SchedulerState &scheduler) {
+    SchedulerState copy;
+    std::unordered_map<const PCB*, PCB*> map;
+    for (const auto &p : scheduler.processes) {
+        auto clone = std::make_unique<PCB>();
+        copy_pcb_state(*p, *clone);
+        map[p.get()] = clone.get();
+        copy.processes.push_back(std::move(clone));
+    }
+    auto remap = [&map](const PCB *p) {
+        auto it = map.find(p);
+        if (it == map.end()) throw std::runtime_error("Bifurcacao: processo fora da lista do escalonador");
+        return it->second;
+    };
+    for (const PCB *p : scheduler.ready) copy.ready.push_back(remap(p));
+    for (const Event &e : scheduler.events.pending()) copy.events.schedule(e.cycle, e.kind, remap(e.process));
+    copy.blocked = scheduler.blocked;
+    copy.clock = scheduler.clock;
+    copy.finished = scheduler.finished;
+    return copy;
+}
+
+void save_checkpoint(const std::string &path, const MemoryManager &memory,
+                     const SchedulerState &scheduler, const IOManager &io) {
+    namespace fs = std::filesystem;
+    // O I/O é lido antes dos PCBs, numa cópia só: cada requisição aparece ou
+    // na fila ou entre as atendidas, junto com o gerador correspondente
+    const IOManager::PendingState pending = io.pendingState();
+    const std::vector<Event> events = scheduler.events.pending();
+    if (std::any_of(events.begin(), events.end(), [](const Event &e) { return e.kind == EventKind::SliceEnd; }))
+        throw std::logic_error("Checkpoint com uma fatia em andamento");
+
+    // Escreve num temporário e renomeia, como a imagem de programa
+    fs::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Nao foi possivel gravar o checkpoint: " + path);
+        out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        ckpt::put<uint32_t>(out, CHECKPOINT_VERSION);
+
+        memory.saveState(out);
+
+        const ProcessIndex index(scheduler.processes);
+        ckpt::put<uint32_t>(out, static_cast<uint32_t>(scheduler.processes.size()));
+        for (const auto &p : scheduler.processes) savePCB(out, *p);
+        ckpt::put<uint64_t>(out, scheduler.clock);
+        ckpt::put<int32_t>(out, scheduler.finished);
+        index.putAll(out, scheduler.ready);
+        ckpt::put<uint32_t>(out, static_cast<uint32_t>(events.size()));
+        for (const Event &e : events) {
+            ckpt::put<uint64_t>(out, e.cycle);
+            ckpt::put<uint8_t>(out, static_cast<uint8_t>(e.kind));
+            index.put(out, e.process);
+        }
+
+        ckpt::putString(out, pending.rng);
+        ckpt::put<uint32_t>(out, static_cast<uint32_t>(pending.devices.size()));
+        for (const auto &device : pending.devices) {
+            ckpt::putString(out, device.rng);
+            ckpt::put<uint32_t>(out, static_cast<uint32_t>(device.busy_until.size()));
+            for (uint64_t cycle : device.busy_until) ckpt::put<uint64_t>(out, cycle);
+            ckpt::put<uint32_t>(out, static_cast<uint32_t>(device.requests.size()));
+            for (const auto &req : device.requests) {
+                index.put(out, req.process);
+                ckpt::put<uint64_t>(out, req.submit_cycle);
+            }
+        }
+        ckpt::put<uint32_t>(out, static_cast<uint32_t>(pending.completed.size()));
+        for (const auto &done : pending.completed) {
+            index.put(out, done.process);
+            ckpt::put<uint64_t>(out, done.completion_cycle);
+        }
+        if (!out) throw std::runtime_error("Nao foi possivel gravar o checkpoint: " + path);
+    }
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        throw std::runtime_error("Nao foi possivel gravar o checkpoint: " + path);
+    }
+}
+
+void load_checkpoint(const std::string &path, MemoryManager &memory,
+                     SchedulerState &scheduler, IOManager &io) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Nao foi possivel abrir o checkpoint: " + path);
+
+    char magic[4];
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(std::begin(magic), std::end(magic), CHECKPOINT_MAGIC))
+        throw std::runtime_error("Arquivo nao e um checkpoint: " + path);
+    const uint32_t version = ckpt::get<uint32_t>(in);
+    if (version != CHECKPOINT_VERSION)
+        throw std::runtime_error("Versao de checkpoint " + std::to_string(version) +
+                                 " nao suportada (esperada " + std::to_string(CHECKPOINT_VERSION) + ")");
+
+    // Lê tudo em objetos novos; o estado do chamador só muda se o arquivo inteiro for válido
+    MemoryManager restoredMemory(0, 0);
+    restoredMemory.loadState(in);
+
+    SchedulerState restored;
+    const uint32_t count = ckpt::get<uint32_t>(in);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto p = std::make_unique<PCB>();
+        loadPCB(in, *p);
+        restored.processes.push_back(std::move(p));
+    }
+    restored.clock = ckpt::get<uint64_t>(in);
+    restored.finished = ckpt::get<int32_t>(in);
+    getAll(in, restored.processes, restored.ready);
+    for (uint32_t n = ckpt::get<uint32_t>(in); n > 0; --n) {
+        const uint64_t cycle = ckpt::get<uint64_t>(in);
+        const uint8_t kind = ckpt::get<uint8_t>(in);
+        if (kind > static_cast<uint8_t>(EventKind::IoCompletion) || kind == static_cast<uint8_t>(EventKind::SliceEnd))
+            throw std::runtime_error("Checkpoint corrompido (evento)");
+        restored.events.schedule(cycle, static_cast<EventKind>(kind), getProcess(in, restored.processes));
+    }
+
+    IOManager::PendingState pending;
+    pending.rng = ckpt::getString(in);
+    // Os tamanhos só são conferidos com a configuração do IOManager no fim
+    for (uint32_t d = ckpt::get<uint32_t>(in); d > 0; --d) {
+        IOManager::DeviceState device;
+        device.rng = ckpt::getString(in);
+        for (uint32_t n = ckpt::get<uint32_t>(in); n > 0; --n) device.busy_until.push_back(ckpt::get<uint64_t>(in));
+        for (uint32_t n = ckpt::get<uint32_t>(in); n > 0; --n) {
+            IORequest req;
+            req.process = getProcess(in, restored.processes);
+            req.submit_cycle = ckpt::get<uint64_t>(in);
+            req.process->state = State::Blocked;
+            device.requests.push_back(std::move(req));
+        }
+        pending.devices.push_back(std::move(device));
+    }
+    for (uint32_t n = ckpt::get<uint32_t>(in); n > 0; --n) {
+        IORequest done;
+        done.process = getProcess(in, restored.processes);
+        done.completion_cycle = ckpt::get<uint64_t>(in);
+        done.process->state = State::Blocked;
+        pending.completed.push_back(std::move(done));
+    }
+    if (in.peek() != std::char_traits<char>::eof()) throw std::runtime_error("Checkpoint corrompido (dados no fim)");
+    if (!io.compatible(pending))
+        throw std::runtime_error("Checkpoint de outra configuracao de dispositivos de I/O");
+    restored.blocked = pending.completed.size();
+    for (const auto &device : pending.devices) restored.blocked += device.requests.size();
+
+    memory = std::move(restoredMemory);
+    scheduler = std::move(restored);
+    io.restorePendingState(pending);
+}
@@ -0,0 +1,115 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+/*
+  checkpoint.hpp
+  Checkpoint binário da máquina inteira, para retomar uma simulação a partir
+  de um ponto já aquecido em vez de reexecutar desde a instrução zero.
+
+  O arquivo guarda:
+  - memória principal, secundária e a cache L1 (linhas, bits de validade e
+    sujeira, ordem FIFO e contadores);
+  - todos os PCBs (identificação, estado, registradores, contadores, pesos e
+    as tabelas do preditor de desvios);
+  - o estado do escalonador (relógio, fila de prontos e a fila de eventos:
+    chegadas e fins de I/O ainda no futuro);
+  - o estado do IOManager (gerador do sorteio de dispositivo e, por
+    dispositivo, gerador, ciclo em que cada canal fica livre e requisições
+    ainda sem resposta; e as atendidas que o escalonador ainda não recebeu).
+    Os processos bloqueados são exatamente esses; o contador do escalonador
+    é refeito a partir deles. Só restaura num IOManager com os mesmos
+    dispositivos e canais.
+
+  Formato: "VNCK", versão (uint32) e as seções acima, em binário nativo
+  (little-endian, como a imagem de programa em program_image). Referências a
+  processos são gravadas como índice em SchedulerState::processes. Um arquivo
+  de outra versão, truncado ou com lixo no fim é rejeitado com runtime_error.
+
+  O checkpoint é tirado entre duas fatias do escalonador, com a CPU livre:
+  Core() esvazia o pipeline ao fim de cada chamada, então não há estado de
+  pipeline nem evento de fim de fatia a guardar.
+  As reservas de ll não são gravadas: o primeiro sc depois de restaurar
+  falha e o programa refaz o ll (o ll/sc permite falhas espúrias).
+*/
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "PCB.hpp"
+#include "event_queue.hpp"
+
+class MemoryManager;
+class IOManager;
+
+constexpr uint32_t CHECKPOINT_VERSION = 15; // 2: preditor de desvios; 3: contadores de hazards; 4: unidades funcionais; 5: núcleo fora de ordem; 6: emissão múltipla; 7: store buffer; 8: macro-fusão; 9: registradores vetoriais; 10: contadores de sincronização; 11: fila de eventos e I/O em tempo virtual; 12: conclusões de I/O não entregues; 13: bloqueados contados pelo IOManager; 14: dispositivos de I/O com fila e canais próprios; 15: ciclos de esvaziamento do pipeline
+
+// Estado do laço de escalonamento Round-Robin de main.cpp
+struct SchedulerState {
+    std::vector<std::unique_ptr<PCB>> processes;
+    std::deque<PCB*> ready;
+    std::size_t blocked = 0;      // entregues ao IOManager, ainda sem ciclo de término
+    EventQueue events;            // chegadas, fins de fatia e fins de I/O
+    uint64_t clock = 0;           // tempo virtual (ciclos), inclusive o ocioso
+    int finished = 0;
+};
+
+// Cópia em memória: PCBs novos e filas apontando para eles. Junto com
+// MemoryManager::fork() (cópia na escrita), ramifica uma máquina em execução
+// em variantes independentes sem passar pelo disco.
+SchedulerState fork_scheduler(const SchedulerState &scheduler);
+
+// Lança runtime_error se não conseguir gravar/ler
+void save_checkpoint(const std::string &path, const MemoryManager &memory,
+                     const SchedulerState &scheduler, const IOManager &io);
+void load_checkpoint(const std::string &path, MemoryManager &memory,
+                     SchedulerState &scheduler, IOManager &io);
+
+// Leitura/escrita de campos, compartilhada pelos módulos que se serializam
+namespace ckpt {
+
+template <typename T>
+void put(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T get(std::istream &in) {
+    T value{};
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    if (!in) throw std::runtime_error("Checkpoint truncado");
+    return value;
+}
+
+inline void putString(std::ostream &out, const std::string &s) {
+    put<uint32_t>(out, static_cast<uint32_t>(s.size()));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+inline std::string getString(std::istream &in) {
+    std::string s(get<uint32_t>(in), '\0');
+    in.read(s.data(), static_cast<std::streamsize>(s.size()));
+    if (!in) throw std::runtime_error("Checkpoint truncado");
+    return s;
+}
+
+inline void putWords(std::ostream &out, const std::vector<uint32_t> &words) {
+    put<uint64_t>(out, words.size());
+    out.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+}
+
+inline std::vector<uint32_t> getWords(std::istream &in, std::size_t maxCount) {
+    const uint64_t count = get<uint64_t>(in);
+    if (count > maxCount) throw std::runtime_error("Checkpoint corrompido (tamanho de memoria invalido)");
+    std::vector<uint32_t> words(count);
+    in.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(count * sizeof(uint32_t)));
+    if (!in) throw std::runtime_error("Checkpoint truncado");
+    return words;
+}
+
+} // namespace ckpt
+
+#endif // CHECKPOINT_HPP
@@ -0,0 +1,74 @@
+#ifndef EVENT_QUEUE_HPP
+#define EVENT_QUEUE_HPP
+/*
+  event_queue.hpp
+  Fila de eventos do escalonador, em tempo virtual (ciclos). Chegadas de
+  processos, fins de fatia da CPU e fins de I/O entram com o ciclo em que
+  acontecem; o escalonador tira sempre o mais cedo e pula direto para ele,
+  então tempo ocioso não custa nada.
+
+  Eventos no mesmo ciclo saem na ordem em que foram agendados, o que deixa a
+  simulação determinística.
+*/
+#include <cstdint>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+struct PCB;
+
+enum class EventKind : uint8_t {
+    Arrival,      // processo chega (PCB::arrival_time)
+    SliceEnd,     // a fatia do processo na CPU termina
+    IoCompletion, // o I/O do processo termina e ele volta a ficar pronto
+};
+
+struct Event {
+    uint64_t cycle = 0;
+    uint64_t seq = 0;    // ordem de agendamento, desempata o mesmo ciclo
+    EventKind kind = EventKind::Arrival;
+    PCB *process = nullptr;
+};
+
+class EventQueue {
+public:
+    void schedule(uint64_t cycle, EventKind kind, PCB *process) {
+        heap.push(Event{cycle, nextSeq++, kind, process});
+    }
+
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+
+    // Ciclo do próximo evento (logic_error com a fila vazia)
+    uint64_t nextCycle() const {
+        if (heap.empty()) throw std::logic_error("Fila de eventos vazia");
+        return heap.top().cycle;
+    }
+
+    Event pop() {
+        if (heap.empty()) throw std::logic_error("Fila de eventos vazia");
+        Event e = heap.top();
+        heap.pop();
+        return e;
+    }
+
+    // Eventos pendentes na ordem em que sairiam (checkpoint, bifurcação).
+    // Reagendá-los nessa ordem numa fila vazia reproduz a fila.
+    std::vector<Event> pending() const {
+        std::vector<Event> events;
+        for (Heap copy = heap; !copy.empty(); copy.pop()) events.push_back(copy.top());
+        return events;
+    }
+
+private:
+    struct Later {
+        bool operator()(const Event &a, const Event &b) const {
+            return a.cycle != b.cycle ? a.cycle > b.cycle : a.seq > b.seq;
+        }
+    };
+    using Heap = std::priority_queue<Event, std::vector<Event>, Later>;
+    Heap heap;
+    uint64_t nextSeq = 0;
+};
+
+#endif // EVENT_QUEUE_HPP
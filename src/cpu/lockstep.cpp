@@ -0,0 +1,187 @@
+#include "lockstep.hpp"
+#include "CONTROL_UNIT.hpp"
+#include "FAST_CORE.hpp"
+#include "ISA.hpp"
+#include "PCB.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../IO/IOManager.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <sstream>
+
+namespace {
+
+constexpr std::size_t MAX_DIFFERENCES = 8;
+
+// Uma cópia independente da máquina vista por um processo
+struct Machine {
+    MemoryManager memory;
+    PCB process;
+    std::vector<std::string> output; // mensagens de print, em ordem
+
+    Machine(const MemoryManager &m, const PCB &p) : memory(m) { copy_pcb_state(p, process); }
+    Machine(const Machine &other) : memory(other.memory), output(other.output) {
+        copy_pcb_state(other.process, process);
+    }
+
+    bool finished() const { return process.state == State::Finished; }
+    uint64_t retired() const { return process.instructions_retired.load(); }
+};
+
+void collectOutput(Machine &m, std::vector<std::unique_ptr<IORequest>> &io) {
+    for (const auto &req : io) m.output.push_back(req->msg);
+}
+
+// Core() por 'cycles' ciclos (busca até 'cycles' instruções e esvazia o pipeline)
+void runCore(Machine &m, int cycles) {
+    std::vector<std::unique_ptr<IORequest>> io;
+    bool printLock = false;
+    m.process.quantum = cycles;
+    Core(m.memory, m.process, &io, printLock);
+    collectOutput(m, io);
+}
+
+void runEngine(Machine &m, EngineStepFunction engine, uint64_t instructions) {
+    std::vector<std::unique_ptr<IORequest>> io;
+    bool printLock = false;
+    engine(m.memory, m.process, &io, printLock, instructions);
+    collectOutput(m, io);
+}
+
+std::string hexWord(uint32_t v) {
+    std::ostringstream s;
+    s << "0x" << std::hex << v;
+    return s.str();
+}
+
+// Diferenças de estado arquitetural (no máximo MAX_DIFFERENCES)
+std::vector<std::string> compare(const Machine &core, const Machine &fast) {
+    std::vector<std::string> diffs;
+    auto add = [&](const std::string &what, const std::string &a, const std::string &b) {
+        if (diffs.size() < MAX_DIFFERENCES) diffs.push_back(what + ": core=" + a + " fast=" + b);
+    };
+
+    const auto &rc = core.process.regBank, &rf = fast.process.regBank;
+    for (const auto &name : isa::REGISTER_NAMES) {
+        const std::string n(name.substr(1));
+        const uint32_t a = rc.readRegister(n), b = rf.readRegister(n);
+        if (a != b) add(std::string(name), std::to_string(static_cast<int32_t>(a)), std::to_string(static_cast<int32_t>(b)));
+    }
+    if (rc.hi.read() != rf.hi.read()) add("hi", std::to_string(static_cast<int32_t>(rc.hi.read())), std::to_string(static_cast<int32_t>(rf.hi.read())));
+    if (rc.lo.read() != rf.lo.read()) add("lo", std::to_string(static_cast<int32_t>(rc.lo.read())), std::to_string(static_cast<int32_t>(rf.lo.read())));
+    for (unsigned v = 0; v < isa::VECTOR_REGISTERS; ++v)
+        for (unsigned lane = 0; lane < isa::VECTOR_LANES; ++lane)
+            if (rc.w[v][lane] != rf.w[v][lane])
+                add(std::string(isa::VECTOR_REGISTER_NAMES[v]) + "[" + std::to_string(lane) + "]",
+                    std::to_string(static_cast<int32_t>(rc.w[v][lane])), std::to_string(static_cast<int32_t>(rf.w[v][lane])));
+    if (rc.pc.read() != rf.pc.read()) add("pc", std::to_string(rc.pc.read()), std::to_string(rf.pc.read()));
+    if (core.finished() != fast.finished())
+        add("fim do programa", core.finished() ? "sim" : "nao", fast.finished() ? "sim" : "nao");
+
+    const size_t words = std::min(core.memory.addressSpaceSize(), fast.memory.addressSpaceSize());
+    for (uint32_t addr = 0; addr < words && diffs.size() < MAX_DIFFERENCES; ++addr) {
+        const uint32_t a = core.memory.peek(addr), b = fast.memory.peek(addr);
+        if (a != b) add("mem[" + std::to_string(addr) + "]", hexWord(a), hexWord(b));
+    }
+
+    if (core.output != fast.output) {
+        const size_t n = std::min(core.output.size(), fast.output.size());
+        size_t i = 0;
+        while (i < n && core.output[i] == fast.output[i]) ++i;
+        add("print #" + std::to_string(i + 1),
+            i < core.output.size() ? core.output[i] : "(nada)",
+            i < fast.output.size() ? fast.output[i] : "(nada)");
+    }
+    return diffs;
+}
+
+std::string traceLine(const Machine &m, uint32_t address) {
+    return std::to_string(address) + ": " + isa::disassemble(m.memory.peek(address), address);
+}
+
+// Reexecuta o intervalo [done, done + count) instrução por instrução a partir
+// do último estado em que os motores concordavam
+LockstepDivergence localize(const Machine &agreed, uint64_t done, uint64_t count,
+                            std::vector<std::string> checkpointDiffs, const LockstepOptions &options,
+                            EngineStepFunction engine) {
+    Machine core(agreed), fast(agreed);
+    std::deque<std::string> trace;
+    LockstepDivergence d;
+
+    for (uint64_t i = 1; i <= count; ++i) {
+        const uint32_t address = core.process.regBank.pc.read();
+        trace.push_back(traceLine(core, address));
+        if (trace.size() > options.traceLength) trace.pop_front();
+
+        runCore(core, 1);
+        runEngine(fast, engine, 1);
+
+        auto diffs = compare(core, fast);
+        d.instruction = done + i;
+        d.address = address;
+        if (!diffs.empty()) {
+            d.localized = true;
+            d.differences = std::move(diffs);
+            break;
+        }
+        if (core.finished()) break;
+    }
+
+    if (!d.localized) d.differences = std::move(checkpointDiffs);
+    d.trace.assign(trace.begin(), trace.end());
+    return d;
+}
+
+} // namespace
+
+LockstepReport run_lockstep(const MemoryManager &memory, const PCB &process, const LockstepOptions &options) {
+    const EngineStepFunction engine = options.engine ? options.engine : FastCoreRun;
+    const int interval = std::max(1, options.interval);
+
+    QuietCore quiet;
+    LockstepReport report;
+    Machine core(memory, process), fast(memory, process);
+    auto agreed = std::make_unique<Machine>(core);
+
+    while (!core.finished() && report.instructions < options.maxInstructions) {
+        const uint64_t before = core.retired();
+        runCore(core, interval);
+        const uint64_t count = core.retired() - before;
+        runEngine(fast, engine, count);
+        report.checkpoints++;
+
+        auto diffs = compare(core, fast);
+        if (!diffs.empty()) {
+            report.divergence = localize(*agreed, report.instructions, count, std::move(diffs), options, engine);
+            return report;
+        }
+        report.instructions += count;
+        agreed = std::make_unique<Machine>(core);
+    }
+    report.finished = core.finished();
+    return report;
+}
+
+std::string format_lockstep_report(const LockstepReport &report) {
+    std::ostringstream out;
+    if (report.ok()) {
+        out << "OK: " << report.instructions << " instrucoes, " << report.checkpoints
+            << " pontos de verificacao" << (report.finished ? ", programa terminou" : ", limite atingido") << "\n";
+        return out.str();
+    }
+
+    const LockstepDivergence &d = *report.divergence;
+    if (d.localized) {
+        out << "DIVERGENCIA apos a instrucao #" << d.instruction << " (endereco " << d.address << ")\n";
+    } else {
+        out << "DIVERGENCIA entre as instrucoes #" << report.instructions + 1 << " e #" << d.instruction
+            << " (so aparece com o pipeline cheio)\n";
+    }
+    for (const auto &diff : d.differences) out << "  " << diff << "\n";
+    if (!d.trace.empty()) {
+        out << "  ultimas instrucoes:\n";
+        for (const auto &line : d.trace) out << "    " << line << "\n";
+    }
+    return out.str();
+}
@@ -0,0 +1,66 @@
+#ifndef LOCKSTEP_HPP
+#define LOCKSTEP_HPP
+/*
+  lockstep.hpp
+  Verificação diferencial: executa o pipeline detalhado (Core()) e um motor
+  rápido (por padrão FastCoreRun) lado a lado, cada um sobre a sua cópia do
+  processo e da memória, e compara o estado arquitetural a cada ponto de
+  verificação: registradores de uso geral e PC (REGISTER_BANK), a memória
+  inteira (pega qualquer escrita divergente), o fim do programa e as
+  requisições de print.
+
+  A cada ponto, Core() roda 'interval' ciclos e esvazia o pipeline; o motor
+  rápido executa exatamente as instruções que Core() completou. Na primeira
+  divergência, os dois motores são reexecutados a partir do último ponto em
+  que concordavam, uma instrução por vez, para apontar a instrução culpada e
+  mostrar as instruções que a antecederam. Se a divergência só aparece com o
+  pipeline cheio (interação entre instruções em estágios diferentes), o
+  relatório informa apenas o intervalo.
+
+  A entrada não é modificada.
+*/
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+class MemoryManager;
+struct PCB;
+struct IORequest;
+
+// Motor comparado com Core(): executa no máximo N instruções e retorna quantas executou
+using EngineStepFunction = uint64_t (*)(MemoryManager &, PCB &, std::vector<std::unique_ptr<IORequest>>*,
+                                        bool &, uint64_t);
+
+struct LockstepOptions {
+    int interval = 16;                     // ciclos de Core() entre comparações (>= 1)
+    uint64_t maxInstructions = 10000000;   // limite (programas que não terminam)
+    std::size_t traceLength = 8;           // instruções mostradas até a divergência
+    EngineStepFunction engine = nullptr;   // nullptr = FastCoreRun
+};
+
+struct LockstepDivergence {
+    uint64_t instruction = 0;              // nº (a partir de 1) da instrução após a qual os estados diferem
+    uint32_t address = 0;                  // endereço dessa instrução
+    bool localized = false;                // false: só se sabe que está no último intervalo
+    std::vector<std::string> differences;  // "$t0: core=5 fast=6", "mem[40]: ...", "pc: ..."
+    std::vector<std::string> trace;        // "endereço: assembly", da mais antiga à divergente
+};
+
+struct LockstepReport {
+    uint64_t instructions = 0;             // instruções verificadas
+    uint64_t checkpoints = 0;
+    bool finished = false;                 // os dois motores chegaram ao END
+    std::optional<LockstepDivergence> divergence;
+
+    bool ok() const { return !divergence.has_value(); }
+};
+
+LockstepReport run_lockstep(const MemoryManager &memory, const PCB &process, const LockstepOptions &options = {});
+
+// Relatório legível (várias linhas)
+std::string format_lockstep_report(const LockstepReport &report);
+
+#endif // LOCKSTEP_HPP
@@ -8,20 +8,37 @@
 
 using json = nlohmann::json;
 
+void apply_pcb_settings(const json &j, PCB &pcb) {
+    pcb.pid = j.value("pid", 0);
+    pcb.name = j.value("name", std::string(""));
+    pcb.quantum = j.value("quantum", 0);
+    pcb.priority = j.value("priority", 0);
+    pcb.arrival_time = j.value("arrival_time", 0ULL);
+    if (j.contains("mem_weights")) {
+        auto &mw = j["mem_weights"];
+        pcb.memWeights.primary = mw.value("primary", 1ULL);
+        pcb.memWeights.secondary = mw.value("secondary", 10ULL);
+    }
+    if (j.contains("branch_predictor")) {
+        // Configuração inválida lança invalid_argument (cpu/BRANCH_PREDICTOR)
+        auto &bp = j["branch_predictor"];
+        BranchPredictorConfig config;
+        config.kind = predictor_kind_from_string(bp.value("kind", std::string("not-taken")));
+        config.tableBits = bp.value("table_bits", config.tableBits);
+        config.historyBits = bp.value("history_bits", config.historyBits);
+        config.btbEntries = bp.value("btb_entries", config.btbEntries);
+        config.rasEntries = bp.value("ras_entries", config.rasEntries);
+        config.mispredictPenalty = bp.value("mispredict_penalty", config.mispredictPenalty);
+        pcb.branchPredictor = BranchPredictor(config);
+    }
+}
+
 bool load_pcb_from_json(const std::string &path, PCB &pcb) {
     std::ifstream f(path);
     if (!f.is_open()) return false;
     try {
         json j; f >> j;
-        pcb.pid = j.value("pid", 0);
-        pcb.name = j.value("name", std::string(""));
-        pcb.quantum = j.value("quantum", 0);
-        pcb.priority = j.value("priority", 0);
-        if (j.contains("mem_weights")) {
-            auto &mw = j["mem_weights"];
-            pcb.memWeights.primary = mw.value("primary", 1ULL);
-            pcb.memWeights.secondary = mw.value("secondary", 10ULL);
-        }
+        apply_pcb_settings(j, pcb);
         return true;
     } catch (...) {
         return false;
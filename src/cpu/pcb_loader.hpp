@@ -7,7 +7,11 @@
 */
 #include <string>
 #include "PCB.hpp"
+#include "../nlohmann/json.hpp"
 
 bool load_pcb_from_json(const std::string &path, PCB &pcb);
 
+// Aplica os campos de PCB de um objeto JSON já lido (mesmas chaves do arquivo).
+void apply_pcb_settings(const nlohmann::json &j, PCB &pcb);
+
 #endif // PCB_LOADER_HPP
@@ -0,0 +1,110 @@
+#include "sampling.hpp"
+#include "CONTROL_UNIT.hpp"
+#include "FAST_CORE.hpp"
+#include "PCB.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../IO/IOManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace {
+
+SampleEstimate estimate(const std::vector<double> &values, double z) {
+    SampleEstimate e;
+    const size_t n = values.size();
+    if (n == 0) return e;
+    double sum = 0;
+    for (double v : values) sum += v;
+    e.mean = sum / n;
+    if (n < 2) return e;
+    double sq = 0;
+    for (double v : values) sq += (v - e.mean) * (v - e.mean);
+    e.halfWidth = z * std::sqrt(sq / (n - 1)) / std::sqrt(static_cast<double>(n));
+    return e;
+}
+
+SampleEstimate scaled(const SampleEstimate &perInstruction, double instructions, double offset) {
+    return {perInstruction.mean * instructions + offset, perInstruction.halfWidth * instructions};
+}
+
+} // namespace
+
+SamplingReport run_sampled(MemoryManager &memory, PCB &process, const SamplingOptions &options,
+                           std::vector<std::unique_ptr<IORequest>>* ioRequests) {
+    std::vector<std::unique_ptr<IORequest>> localRequests;
+    if (!ioRequests) ioRequests = &localRequests;
+    bool printLock = false;
+    const int originalQuantum = process.quantum;
+    const uint64_t start = process.instructions_retired.load();
+    auto retired = [&] { return process.instructions_retired.load() - start; };
+    auto done = [&] { return process.state == State::Finished || retired() >= options.maxInstructions; };
+
+    QuietCore quiet;
+    SamplingReport report;
+    while (!done()) {
+        if (options.fastForward > 0) FastCoreRun(memory, process, ioRequests, printLock, options.fastForward);
+        if (done()) break;
+        if (options.warmup > 0) FastCoreWarm(memory, process, ioRequests, printLock, options.warmup);
+        if (done()) break;
+
+        SampleWindow w;
+        w.firstInstruction = retired();
+        const uint64_t cycles = process.pipeline_cycles.load();
+        const uint64_t drainCycles = process.pipeline_drain_cycles.load();
+        const uint64_t memoryCycles = process.memory_cycles.load();
+        const uint64_t hits = process.cache_hits.load();
+        const uint64_t misses = process.cache_misses.load();
+
+        process.quantum = std::max(1, options.detail);
+        Core(memory, process, ioRequests, printLock);
+
+        w.instructions = retired() - w.firstInstruction;
+        w.drainCycles = process.pipeline_drain_cycles.load() - drainCycles;
+        w.cycles = process.pipeline_cycles.load() - cycles - w.drainCycles;
+        w.memoryCycles = process.memory_cycles.load() - memoryCycles;
+        w.cacheHits = process.cache_hits.load() - hits;
+        w.cacheMisses = process.cache_misses.load() - misses;
+        if (w.instructions > 0) {
+            report.windows.push_back(w);
+            report.detailedInstructions += w.instructions;
+        }
+    }
+    process.quantum = originalQuantum;
+
+    report.totalInstructions = retired();
+    report.finished = process.state == State::Finished;
+
+    std::vector<double> cpi, memCpi, missRate, drain;
+    for (const auto &w : report.windows) {
+        drain.push_back(static_cast<double>(w.drainCycles));
+        cpi.push_back(static_cast<double>(w.cycles) / w.instructions);
+        memCpi.push_back(static_cast<double>(w.memoryCycles) / w.instructions);
+        if (w.cacheHits + w.cacheMisses > 0)
+            missRate.push_back(static_cast<double>(w.cacheMisses) / (w.cacheHits + w.cacheMisses));
+    }
+    report.cpi = estimate(cpi, options.z);
+    report.memoryCyclesPerInstruction = estimate(memCpi, options.z);
+    report.cacheMissRate = estimate(missRate, options.z);
+    const double total = static_cast<double>(report.totalInstructions);
+    report.totalCycles = scaled(report.cpi, total, estimate(drain, options.z).mean);
+    report.totalMemoryCycles = scaled(report.memoryCyclesPerInstruction, total, 0);
+    return report;
+}
+
+std::string format_sampling_report(const SamplingReport &report) {
+    std::ostringstream out;
+    auto line = [&out](const char *name, const SampleEstimate &e) {
+        out << "  " << name << e.mean << " +- " << e.halfWidth << "\n";
+    };
+    out << report.totalInstructions << " instrucoes" << (report.finished ? "" : " (limite atingido)")
+        << ", " << report.windows.size() << " janelas, " << report.detailedInstructions
+        << " no pipeline detalhado\n";
+    line("CPI:                     ", report.cpi);
+    line("Ciclos de memoria/instr: ", report.memoryCyclesPerInstruction);
+    line("Taxa de miss da cache:   ", report.cacheMissRate);
+    line("Ciclos estimados:        ", report.totalCycles);
+    line("Ciclos de memoria est.:  ", report.totalMemoryCycles);
+    return out.str();
+}
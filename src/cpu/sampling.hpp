@@ -0,0 +1,80 @@
+#ifndef SAMPLING_HPP
+#define SAMPLING_HPP
+/*
+  sampling.hpp
+  Simulação por amostragem sistemática: em vez de levar o programa inteiro
+  pelo pipeline detalhado, o driver repete
+
+    1. avanço rápido: N instruções no núcleo funcional (FastCoreRun);
+    2. aquecimento: W instruções no núcleo funcional passando pela cache
+       (FastCoreWarm), para a janela começar com a cache "quente";
+    3. janela detalhada: Core() busca D instruções e esvazia o pipeline;
+       as métricas do PCB nessa janela viram uma amostra.
+
+  Cada janela dá valores por instrução (CPI, ciclos de memória por instrução)
+  e a taxa de miss da cache. A estimativa é a média das janelas com intervalo
+  de confiança z·s/√n; multiplicada pelo total de instruções (conhecido
+  exatamente, pois o avanço rápido executa todas), dá o total do programa.
+
+  Core() esvazia o pipeline no fim de cada chamada: os estágios depois da
+  última busca e as operações longas ainda nas unidades funcionais, medidos
+  em PCB::pipeline_drain_cycles. Na execução completa isso acontece uma vez
+  só, então esses ciclos são tirados de cada janela e a média deles é somada
+  uma vez à estimativa total.
+*/
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MemoryManager;
+struct PCB;
+struct IORequest;
+
+struct SamplingOptions {
+    uint64_t fastForward = 10000;           // N
+    uint64_t warmup = 1000;                 // W
+    int detail = 1000;                      // D (instruções buscadas por Core() em cada janela)
+    uint64_t maxInstructions = UINT64_MAX;  // limite (programas que não terminam)
+    double z = 1.96;                        // 1.96 = 95% de confiança
+};
+
+struct SampleWindow {
+    uint64_t firstInstruction = 0; // instruções completadas antes da janela
+    uint64_t instructions = 0;
+    uint64_t cycles = 0;           // sem os ciclos de esvaziamento do pipeline
+    uint64_t drainCycles = 0;      // os de esvaziamento, à parte
+    uint64_t memoryCycles = 0;
+    uint64_t cacheHits = 0;
+    uint64_t cacheMisses = 0;
+};
+
+struct SampleEstimate {
+    double mean = 0;
+    double halfWidth = 0;          // intervalo: mean ± halfWidth (0 com menos de 2 janelas)
+};
+
+struct SamplingReport {
+    std::vector<SampleWindow> windows;
+    uint64_t totalInstructions = 0;
+    uint64_t detailedInstructions = 0;
+    bool finished = false;
+
+    SampleEstimate cpi;
+    SampleEstimate memoryCyclesPerInstruction;
+    SampleEstimate cacheMissRate;
+    SampleEstimate totalCycles;        // estimativa para o programa inteiro
+    SampleEstimate totalMemoryCycles;
+};
+
+// Executa o processo até o fim (ou o limite) alternando os três modos. O
+// processo e a memória terminam no mesmo estado arquitetural de uma execução
+// completa; os contadores do PCB misturam os dois motores.
+SamplingReport run_sampled(MemoryManager &memory, PCB &process, const SamplingOptions &options = {},
+                           std::vector<std::unique_ptr<IORequest>>* ioRequests = nullptr);
+
+// Relatório legível (várias linhas)
+std::string format_sampling_report(const SamplingReport &report);
+
+#endif // SAMPLING_HPP
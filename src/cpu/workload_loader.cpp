@@ -0,0 +1,142 @@
+/*
+  workload_loader.cpp
+  Leitura do manifesto de carga de trabalho e carregamento paralelo dos processos.
+*/
+#include "workload_loader.hpp"
+#include "pcb_loader.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../parser_json/parser_json.hpp"
+#include "../parser_json/program_image.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+static json read_json(const fs::path &path) {
+    std::ifstream f(path);
+    if (!f.is_open()) throw std::runtime_error("Não foi possível abrir: " + path.string());
+    json j; f >> j;
+    return j;
+}
+
+// Converte uma entrada do manifesto em uma ou mais especificações de processo
+static void add_entry(const json &entry, const fs::path &baseDir, Workload &workload) {
+    if (!entry.is_object() || !entry.contains("program"))
+        throw std::runtime_error("Entrada de processo sem 'program' no manifesto");
+
+    json pcb = json::object();
+    if (entry.contains("pcb")) {
+        const json &ref = entry["pcb"];
+        pcb = ref.is_string() ? read_json(baseDir / ref.get<std::string>()) : ref;
+    }
+    for (auto it = entry.begin(); it != entry.end(); ++it) {
+        if (it.key() != "pcb" && it.key() != "program" && it.key() != "count") pcb[it.key()] = it.value();
+    }
+
+    const std::string program = (baseDir / entry["program"].get<std::string>()).string();
+    const int count = entry.value("count", 1);
+    for (int k = 0; k < count; ++k) {
+        ProcessSpec spec{pcb, program};
+        if (k > 0 && pcb.contains("pid")) spec.pcb["pid"] = pcb["pid"].get<int>() + k;
+        workload.processes.push_back(std::move(spec));
+    }
+}
+
+Workload read_workload_manifest(const std::string &path) {
+    Workload workload;
+    const fs::path p(path);
+
+    if (fs::is_directory(p)) {
+        std::vector<fs::path> files;
+        for (const auto &e : fs::directory_iterator(p)) {
+            if (e.is_regular_file() && e.path().extension() == ".json") files.push_back(e.path());
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto &file : files) {
+            json entry = read_json(file);
+            if (entry.is_object() && entry.contains("program")) add_entry(entry, p, workload);
+        }
+    } else {
+        json manifest = read_json(p);
+        const fs::path baseDir = p.has_parent_path() ? p.parent_path() : fs::path(".");
+        if (manifest.contains("memory")) {
+            workload.mainMemorySize = manifest["memory"].value("main", workload.mainMemorySize);
+            workload.secondaryMemorySize = manifest["memory"].value("secondary", workload.secondaryMemorySize);
+        }
+        for (const auto &entry : manifest.value("processes", json::array())) add_entry(entry, baseDir, workload);
+    }
+
+    if (workload.processes.empty()) throw std::runtime_error("Manifesto sem processos: " + path);
+    return workload;
+}
+
+// Pool simples: 'threads' trabalhadores retiram índices de um contador compartilhado
+template <typename Fn>
+static void parallel_for(std::size_t count, unsigned threads, Fn fn) {
+    std::atomic<std::size_t> next{0};
+    std::vector<std::exception_ptr> errors(count);
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            try { fn(i); } catch (...) { errors[i] = std::current_exception(); }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads && t < count; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool) t.join();
+
+    for (auto &e : errors) if (e) std::rethrow_exception(e);
+}
+
+std::vector<std::unique_ptr<PCB>> load_workload(const Workload &workload, MemoryManager &memManager,
+                                                unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // 1. Monta cada programa distinto uma única vez, em paralelo (base 0, relocado depois)
+    std::map<std::string, std::size_t> programIndex;
+    std::vector<std::string> programs;
+    for (const auto &spec : workload.processes) {
+        if (programIndex.emplace(spec.program, programs.size()).second) programs.push_back(spec.program);
+    }
+    std::vector<ProgramImage> images(programs.size());
+    parallel_for(programs.size(), threads, [&](std::size_t i) {
+        images[i] = compileProgramCached(programs[i], 0);
+    });
+
+    // 2. Cria os PCBs e posiciona as imagens uma após a outra
+    // lw/sw num rótulo de dado guardam o endereço absoluto num imediato de 16
+    // bits com sinal: relocateProgramImage recusa dados que passem de 0x7FFF
+    const std::size_t limit = memManager.addressSpaceSize();
+    std::vector<std::unique_ptr<PCB>> processes;
+    uint32_t nextBase = 0;
+    for (std::size_t i = 0; i < workload.processes.size(); ++i) {
+        const ProcessSpec &spec = workload.processes[i];
+        auto pcb = std::make_unique<PCB>();
+        apply_pcb_settings(spec.pcb, *pcb);
+        if (pcb->pid == 0) pcb->pid = static_cast<int>(i) + 1;
+
+        ProgramImage image = images[programIndex.at(spec.program)];
+        const std::string where = " (processo " + std::to_string(pcb->pid) + ", programa " + spec.program + ")";
+        try {
+            relocateProgramImage(image, nextBase);
+        } catch (const std::out_of_range &e) {
+            throw std::runtime_error("Carga de trabalho fora do alcance dos endereços" + where + ": " + e.what());
+        }
+        if (image.endAddr() > limit) throw std::runtime_error("Carga de trabalho não cabe na memória" + where);
+
+        writeProgramImage(image, memManager, *pcb);
+        pcb->regBank.pc.write(image.entryAddr());
+        nextBase = image.endAddr();
+        processes.push_back(std::move(pcb));
+    }
+    return processes;
+}
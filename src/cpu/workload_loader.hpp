@@ -0,0 +1,55 @@
+#ifndef WORKLOAD_LOADER_HPP
+#define WORKLOAD_LOADER_HPP
+/*
+  workload_loader.hpp
+  Carga de trabalho com vários processos, descrita por um manifesto.
+
+  O manifesto pode ser:
+  - um arquivo JSON:
+      {
+        "memory": { "main": 1024, "secondary": 8192 },        (opcional)
+        "processes": [
+          { "pcb": "process1.json", "program": "tasks.json", "arrival_time": 0 },
+          { "pid": 2, "name": "p2", "quantum": 50, "program": "tasks.json",
+            "arrival_time": 300, "count": 10 }
+        ]
+      }
+    Cada entrada traz os campos do PCB inline e/ou aponta para um arquivo de
+    PCB em "pcb" (campos inline têm precedência). "count" replica a entrada
+    com pids consecutivos. Caminhos são relativos ao diretório do manifesto.
+  - um diretório: cada *.json com a chave "program" é uma entrada no mesmo
+    formato acima (ordem alfabética de nome de arquivo).
+
+  Os programas são montados em paralelo (cada arquivo distinto uma única vez)
+  e cada processo é posicionado em seu próprio endereço base, um após o outro.
+*/
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "PCB.hpp"
+#include "../nlohmann/json.hpp"
+
+class MemoryManager;
+
+struct ProcessSpec {
+    nlohmann::json pcb;   // campos do PCB (pid, name, quantum, priority, mem_weights, arrival_time)
+    std::string program;  // caminho do programa (JSON ou texto .s)
+};
+
+struct Workload {
+    std::vector<ProcessSpec> processes;
+    std::size_t mainMemorySize = 1024;
+    std::size_t secondaryMemorySize = 8192;
+};
+
+// Lê o manifesto (arquivo ou diretório). Lança runtime_error se for inválido.
+Workload read_workload_manifest(const std::string &path);
+
+// Monta os programas com até 'threads' threads (0 = número de núcleos), escreve
+// cada imagem na memória em sua própria base e aponta o PC de cada processo
+// para a primeira instrução. Lança runtime_error se a carga não couber na memória.
+std::vector<std::unique_ptr<PCB>> load_workload(const Workload &workload, MemoryManager &memManager,
+                                                unsigned threads = 0);
+
+#endif // WORKLOAD_LOADER_HPP
@@ -1,16 +1,26 @@
 #include <iostream>
 #include <vector>
 #include <deque>
+#include <algorithm>
 #include <memory>
-#include <thread>
-#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <optional>
 
 
 #include "cpu/PCB.hpp"
 #include "cpu/pcb_loader.hpp"
+#include "cpu/workload_loader.hpp"
 #include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "cpu/OOO_CORE.hpp"
+#include "cpu/SMT_CORE.hpp"
+#include "cpu/lockstep.hpp"
+#include "cpu/sampling.hpp"
+#include "cpu/checkpoint.hpp"
 #include "memory/MemoryManager.hpp"
 #include "parser_json/parser_json.hpp"
 #include "IO/IOManager.hpp"
@@ -21,6 +31,7 @@ void print_metrics(const PCB& pcb) {
     std::cout << "Nome do Processo:       " << pcb.name << "\n";
     std::cout << "Estado Final:           " << (pcb.state == State::Finished ? "Finished" : "Incomplete") << "\n";
     std::cout << "Ciclos de Pipeline:     " << pcb.pipeline_cycles.load() << "\n";
+    std::cout << "Instrucoes Completadas: " << pcb.instructions_retired.load() << "\n";
     std::cout << "Total de Acessos a Mem: " << pcb.mem_accesses_total.load() << "\n";
     std::cout << "  - Leituras:             " << pcb.mem_reads.load() << "\n";
     std::cout << "  - Escritas:             " << pcb.mem_writes.load() << "\n";
@@ -28,6 +39,76 @@ void print_metrics(const PCB& pcb) {
     std::cout << "Acessos a Mem Principal:" << pcb.primary_mem_accesses.load() << "\n";
     std::cout << "Acessos a Mem Secundaria:" << pcb.secondary_mem_accesses.load() << "\n";
     std::cout << "Ciclos Totais de Memoria: " << pcb.memory_cycles.load() << "\n";
+    const uint64_t branches = pcb.branch_predictions.load();
+    const uint64_t mispredicted = pcb.branch_mispredictions.load();
+    std::cout << "Preditor de Desvios:    " << predictor_kind_name(pcb.branchPredictor.config().kind) << "\n";
+    std::cout << "  - Desvios Resolvidos:   " << branches << "\n";
+    std::cout << "  - Erros de Previsao:    " << mispredicted;
+    if (branches > 0) std::cout << " (acerto " << (100.0 * (branches - mispredicted) / branches) << "%)";
+    std::cout << "\n";
+    std::cout << "  - Ciclos de Flush:      " << pcb.branch_flush_cycles.load() << "\n";
+    if (pcb.instructions_retired.load() > 0)
+        std::cout << "CPI:                    " << (double(pcb.pipeline_cycles.load()) / pcb.instructions_retired.load()) << "\n";
+    std::cout << "Ciclos Parados:\n";
+    std::cout << "  - Dependencia (RAW):    " << pcb.stall_raw_cycles.load() << "\n";
+    std::cout << "  - Load-use:             " << pcb.stall_load_use_cycles.load() << "\n";
+    std::cout << "  - Estrutural (memoria): " << pcb.stall_structural_cycles.load() << "\n";
+    std::cout << "  - Latencia de unidade:  " << pcb.stall_fu_latency_cycles.load() << "\n";
+    std::cout << "  - Unidade ocupada:      " << pcb.stall_fu_busy_cycles.load() << "\n";
+    std::cout << "  - Controle (flush):     " << pcb.branch_flush_cycles.load() << "\n";
+    std::cout << "Adiantamentos EX->EX / MEM->EX: " << pcb.forwards_ex_ex.load() << " / " << pcb.forwards_mem_ex.load() << "\n";
+    if (pcb.fused_pairs.load() > 0) {
+        std::cout << "Macro-fusao:            " << pcb.fused_pairs.load() << " pares";
+        if (pcb.instructions_retired.load() > 0)
+            std::cout << " (" << 100.0 * 2 * pcb.fused_pairs.load() / pcb.instructions_retired.load()
+                      << "% das instrucoes)";
+        std::cout << "\n";
+    }
+    if (pcb.vector_instructions.load() > 0) {
+        std::cout << "SIMD (" << vector_backend() << "):\n";
+        std::cout << "  - Instrucoes Vetoriais: " << pcb.vector_instructions.load();
+        if (pcb.instructions_retired.load() > 0)
+            std::cout << " (" << 100.0 * pcb.vector_instructions.load() / pcb.instructions_retired.load()
+                      << "% das instrucoes)";
+        std::cout << "\n";
+        std::cout << "  - Lanes Processadas:    " << pcb.vector_lanes.load() << "\n";
+    }
+    if (pcb.atomic_operations.load() > 0) {
+        std::cout << "Sincronizacao (ll/sc, atomicas): " << pcb.atomic_operations.load() << " operacoes\n";
+        std::cout << "  - SC Falhos:            " << pcb.sc_failures.load() << "\n";
+        std::cout << "  - Iteracoes de Spin:    " << pcb.spin_iterations.load() << "\n";
+    }
+    if (pcb.loads_forwarded.load() > 0 || pcb.store_buffer_full_stalls.load() > 0) {
+        std::cout << "Store Buffer:\n";
+        std::cout << "  - Loads Adiantados:     " << pcb.loads_forwarded.load() << "\n";
+        std::cout << "  - Buffer Cheio:         " << pcb.store_buffer_full_stalls.load() << "\n";
+    }
+    if (pcb.issue_width_cycles.size() > 2) {
+        std::cout << "Emissao Multipla (largura " << pcb.issue_width_cycles.size() - 1 << "):\n";
+        if (pcb.pipeline_cycles.load() > 0)
+            std::cout << "  - IPC:                  " << (double(pcb.instructions_retired.load()) / pcb.pipeline_cycles.load()) << "\n";
+        std::cout << "  - Emitidas por Ciclo:   ";
+        for (size_t n = 0; n < pcb.issue_width_cycles.size(); ++n)
+            std::cout << (n ? " " : "") << n << ":" << pcb.issue_width_cycles[n];
+        std::cout << "\n";
+        std::cout << "  - Grupos Separados:     dependencia " << pcb.issue_split_dependency.load()
+                  << ", estrutural " << pcb.issue_split_structural.load() << "\n";
+    }
+    if (!pcb.ooo.robOccupancy.empty()) {
+        std::cout << "Nucleo Fora de Ordem:\n";
+        if (pcb.pipeline_cycles.load() > 0)
+            std::cout << "  - IPC:                  " << (double(pcb.instructions_retired.load()) / pcb.pipeline_cycles.load()) << "\n";
+        std::cout << "  - Ocupacao Media do ROB: " << pcb.ooo.meanRobOccupancy() << "\n";
+        std::cout << "  - Commits por Ciclo:    ";
+        for (size_t n = 0; n < pcb.ooo.committedPerCycle.size(); ++n)
+            std::cout << (n ? " " : "") << n << ":" << pcb.ooo.committedPerCycle[n];
+        std::cout << "\n";
+        std::cout << "  - Despacho Parado:      ";
+        for (unsigned c = 0; c < OOO_STALL_CAUSES; ++c)
+            std::cout << (c ? ", " : "") << ooo_stall_name(static_cast<OooStall>(c)) << " " << pcb.ooo.dispatchStalls[c];
+        std::cout << "\n";
+        std::cout << "  - Instrucoes Descartadas: " << pcb.ooo.squashed << "\n";
+    }
     std::cout << "------------------------------------------\n";
     // cria pasta "output" se não existir
     std::filesystem::create_directory("output");
@@ -47,6 +128,21 @@ void print_metrics(const PCB& pcb) {
         resultados << "Cache Hits: " << pcb.cache_hits << "\n";
         resultados << "Cache Misses: " << pcb.cache_misses << "\n";
         resultados << "Ciclos de IO: " << pcb.io_cycles << "\n";
+        resultados << "Desvios Resolvidos: " << pcb.branch_predictions << "\n";
+        resultados << "Erros de Previsao: " << pcb.branch_mispredictions << "\n";
+        resultados << "Ciclos Parados (RAW/load-use/estrutural): " << pcb.stall_raw_cycles << " / "
+                   << pcb.stall_load_use_cycles << " / " << pcb.stall_structural_cycles << "\n";
+        resultados << "Ciclos Parados (latencia/unidade ocupada): " << pcb.stall_fu_latency_cycles << " / "
+                   << pcb.stall_fu_busy_cycles << "\n";
+        resultados << "Loads Adiantados do Store Buffer: " << pcb.loads_forwarded << "\n";
+        resultados << "Pares Fundidos: " << pcb.fused_pairs << "\n";
+        resultados << "Instrucoes Vetoriais: " << pcb.vector_instructions << "\n";
+        resultados << "SC Falhos / Iteracoes de Spin: " << pcb.sc_failures << " / " << pcb.spin_iterations << "\n";
+        if (pcb.issue_width_cycles.size() > 2)
+            resultados << "Grupos Separados (dependencia/estrutural): " << pcb.issue_split_dependency << " / "
+                       << pcb.issue_split_structural << "\n";
+        if (!pcb.ooo.robOccupancy.empty())
+            resultados << "Ocupacao Media do ROB: " << pcb.ooo.meanRobOccupancy() << "\n";
     }
 
 
@@ -88,95 +184,369 @@ void print_metrics(const PCB& pcb) {
 }
 
 
-int main() {
-    // 1. Inicialização dos Módulos Principais
+int main(int argc, char* argv[]) {
+    // Uso: simulador [--engine=pipeline|fast|ooo] [--lockstep[=ciclos]] [--sample=N,W,D]
+    //                 [--bpred=tipo] [--bpred-penalty=ciclos] [--forwarding=modo] [--mem-ports=1|2]
+    //                 [--fu=unidade:latencia[,intervalo]]... [--issue=largura] [--store-buffer=entradas] [--fusion]
+    //                 [--ooo=largura,rob,estacoes,lsq] [--smt=contextos[,interleaved|miss]]
+    //                 [--io=dispositivo:canais[,min,max]]...
+    //                 [--save-checkpoint=arq [--checkpoint-at=ciclos]] [--restore=arq | manifesto]
+    const std::string usage = std::string("Uso: ") + argv[0] +
+        " [--engine=pipeline|fast|ooo] [--lockstep[=ciclos]] [--sample=N,W,D]"
+        " [--bpred=not-taken|static|bimodal|gshare|tournament] [--bpred-penalty=ciclos]"
+        " [--forwarding=full|ex|mem|none] [--mem-ports=1|2] [--fu=alu|mul|div|mem:latencia[,intervalo]]..."
+        " [--issue=largura] [--store-buffer=entradas] [--fusion] [--ooo=largura,rob,estacoes,lsq]"
+        " [--smt=contextos[,interleaved|miss]] [--io=printer|disk|network:canais[,min,max]]..."
+        " [--save-checkpoint=arq [--checkpoint-at=ciclos]] [--restore=arq | manifesto]\n";
+    Engine engine = Engine::Pipeline;
+    bool lockstep = false;
+    LockstepOptions lockstepOptions;
+    bool sampled = false;
+    SamplingOptions samplingOptions;
+    std::string manifest;
+    std::string saveCheckpoint;
+    uint64_t checkpointAt = 0;
+    std::string restoreCheckpoint;
+    std::optional<PredictorKind> bpredKind;     // sobrepõe o preditor de todos os processos
+    std::optional<unsigned> bpredPenalty;
+    PipelineConfig pipeline;
+    OooConfig ooo;
+    unsigned smtContexts = 0;                   // 0: sem multithreading
+    SmtConfig smt;
+    std::vector<IODeviceConfig> ioDevices = IOManager::defaultDevices();
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--engine=pipeline") {
+            engine = Engine::Pipeline;
+        } else if (arg == "--engine=fast") {
+            engine = Engine::Fast;
+        } else if (arg == "--engine=ooo") {
+            engine = Engine::OutOfOrder;
+        } else if (arg == "--lockstep") {
+            lockstep = true;
+        } else if (arg.rfind("--lockstep=", 0) == 0) {
+            lockstep = true;
+            lockstepOptions.interval = std::atoi(arg.c_str() + 11);
+        } else if (arg.rfind("--sample=", 0) == 0) {
+            unsigned long long n = 0, w = 0;
+            int d = 0;
+            if (std::sscanf(arg.c_str() + 9, "%llu,%llu,%d", &n, &w, &d) != 3 || d <= 0) {
+                std::cerr << "Formato invalido: " << arg << " (esperado --sample=N,W,D)\n" << usage;
+                return 1;
+            }
+            sampled = true;
+            samplingOptions.fastForward = n;
+            samplingOptions.warmup = w;
+            samplingOptions.detail = d;
+        } else if (arg.rfind("--bpred=", 0) == 0) {
+            try {
+                bpredKind = predictor_kind_from_string(arg.substr(8));
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << "\n" << usage;
+                return 1;
+            }
+        } else if (arg.rfind("--bpred-penalty=", 0) == 0) {
+            bpredPenalty = static_cast<unsigned>(std::strtoul(arg.c_str() + 16, nullptr, 10));
+        } else if (arg.rfind("--forwarding=", 0) == 0) {
+            const std::string mode = arg.substr(13);
+            if (mode != "full" && mode != "ex" && mode != "mem" && mode != "none") {
+                std::cerr << "Modo de adiantamento invalido: " << mode << "\n" << usage;
+                return 1;
+            }
+            pipeline.forwardExEx = mode == "full" || mode == "ex";
+            pipeline.forwardMemEx = mode == "full" || mode == "mem";
+        } else if (arg == "--mem-ports=1" || arg == "--mem-ports=2") {
+            pipeline.unifiedMemoryPort = arg == "--mem-ports=1";
+        } else if (arg.rfind("--fu=", 0) == 0) {
+            // Sem intervalo: unidade segmentada (aceita uma operação por ciclo)
+            const size_t colon = arg.find(':');
+            unsigned latency = 0, interval = 1;
+            const int fields = colon == std::string::npos ? 0
+                             : std::sscanf(arg.c_str() + colon + 1, "%u,%u", &latency, &interval);
+            try {
+                if (fields < 1 || latency == 0 || interval == 0)
+                    throw std::invalid_argument("Formato invalido: " + arg + " (esperado --fu=unidade:latencia[,intervalo])");
+                pipeline.unit(unit_kind_from_string(arg.substr(5, colon - 5))) = FunctionalUnit{latency, interval};
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << "\n" << usage;
+                return 1;
+            }
+        } else if (arg.rfind("--issue=", 0) == 0) {
+            pipeline.issueWidth = static_cast<unsigned>(std::strtoul(arg.c_str() + 8, nullptr, 10));
+            if (pipeline.issueWidth == 0) {
+                std::cerr << "Largura invalida: " << arg << " (esperado --issue=largura, maior que zero)\n" << usage;
+                return 1;
+            }
+        } else if (arg.rfind("--store-buffer=", 0) == 0) {
+            pipeline.storeBufferEntries = static_cast<unsigned>(std::strtoul(arg.c_str() + 15, nullptr, 10));
+        } else if (arg == "--fusion") {
+            pipeline.macroFusion = true;
+        } else if (arg.rfind("--ooo=", 0) == 0) {
+            // Uma ULA por instrução despachada no ciclo
+            if (std::sscanf(arg.c_str() + 6, "%u,%u,%u,%u", &ooo.width, &ooo.robEntries, &ooo.stations, &ooo.lsqEntries) != 4) {
+                std::cerr << "Formato invalido: " << arg << " (esperado --ooo=largura,rob,estacoes,lsq)\n" << usage;
+                return 1;
+            }
+            ooo.units[static_cast<unsigned>(UnitKind::Alu)] = ooo.width;
+        } else if (arg.rfind("--smt=", 0) == 0) {
+            const size_t comma = arg.find(',');
+            smtContexts = static_cast<unsigned>(std::strtoul(arg.c_str() + 6, nullptr, 10));
+            try {
+                if (smtContexts == 0)
+                    throw std::invalid_argument("Formato invalido: " + arg + " (esperado --smt=contextos[,politica])");
+                if (comma != std::string::npos) smt.policy = smt_policy_from_string(arg.substr(comma + 1));
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << "\n" << usage;
+                return 1;
+            }
+        } else if (arg.rfind("--io=", 0) == 0) {
+            // Sem min,max: mantém a distribuição de atendimento do dispositivo
+            const size_t colon = arg.find(':');
+            unsigned channels = 0;
+            unsigned long long minCycles = 0, maxCycles = 0;
+            const int fields = colon == std::string::npos ? 0
+                             : std::sscanf(arg.c_str() + colon + 1, "%u,%llu,%llu", &channels, &minCycles, &maxCycles);
+            try {
+                if ((fields != 1 && fields != 3) || channels == 0 || minCycles > maxCycles)
+                    throw std::invalid_argument("Formato invalido: " + arg + " (esperado --io=dispositivo:canais[,min,max])");
+                IODeviceConfig &device = io_device_by_name(ioDevices, arg.substr(5, colon - 5));
+                device.channels = channels;
+                if (fields == 3) {
+                    device.min_cycles = minCycles;
+                    device.max_cycles = maxCycles;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << "\n" << usage;
+                return 1;
+            }
+        } else if (arg.rfind("--save-checkpoint=", 0) == 0) {
+            saveCheckpoint = arg.substr(18);
+        } else if (arg.rfind("--checkpoint-at=", 0) == 0) {
+            checkpointAt = std::strtoull(arg.c_str() + 16, nullptr, 10);
+        } else if (arg.rfind("--restore=", 0) == 0) {
+            restoreCheckpoint = arg.substr(10);
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Opcao desconhecida: " << arg << "\n" << usage;
+            return 1;
+        } else {
+            manifest = arg;
+        }
+    }
+    if (!restoreCheckpoint.empty() && !manifest.empty()) {
+        std::cerr << "--restore e manifesto sao exclusivos\n" << usage;
+        return 1;
+    }
+    const CoreFunction runCore = coreFor(engine);
+    setPipelineConfig(pipeline);
+    try {
+        setOooConfig(ooo);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << usage;
+        return 1;
+    }
+
+    // 1. Carga de trabalho: manifesto passado na linha de comando, checkpoint ou o processo padrão
+    Workload workload;
+    if (!restoreCheckpoint.empty()) {
+        // Tamanhos de memória e processos vêm do checkpoint
+    } else if (!manifest.empty()) {
+        try {
+            workload = read_workload_manifest(manifest);
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao ler o manifesto '" << manifest << "': " << e.what() << "\n";
+            return 1;
+        }
+    } else {
+        nlohmann::json pcb;
+        std::ifstream f("process1.json");
+        if (!f.is_open()) {
+            std::cerr << "Erro ao carregar 'process1.json'. Certifique-se de que o arquivo está na pasta raiz do projeto.\n";
+            return 1;
+        }
+        f >> pcb;
+        workload.processes.push_back({pcb, "tasks.json"});
+    }
+
+    // 2. Inicialização dos Módulos Principais
     std::cout << "Inicializando o simulador...\n";
-    MemoryManager memManager(1024, 8192);
-    IOManager ioManager;
-
-    // 2. Carregamento dos Processos
-    std::vector<std::unique_ptr<PCB>> process_list;
-    std::deque<PCB*> ready_queue;
-    std::vector<PCB*> blocked_list;
-
-    // Carrega um processo a partir de um arquivo JSON
-    auto p1 = std::make_unique<PCB>();
-    // CORREÇÃO: Caminho simplificado
-    if (load_pcb_from_json("process1.json", *p1)) {
-        // CORREÇÃO: Caminho simplificado
-        std::cout << "Carregando programa 'tasks.json' para o processo " << p1->pid << "...\n";
-        loadJsonProgram("tasks.json", memManager, *p1, 0);
-        process_list.push_back(std::move(p1));
+    MemoryManager memManager(workload.mainMemorySize, workload.secondaryMemorySize);
+    IOManager ioManager(1, ioDevices);
+
+    // 3. Carregamento dos Processos (programas montados em paralelo) ou restauração
+    SchedulerState scheduler;
+    auto& process_list = scheduler.processes;
+    auto& ready_queue = scheduler.ready;
+    auto& blocked_count = scheduler.blocked;
+    auto& events = scheduler.events;
+    auto& clock = scheduler.clock;
+    auto& finished_processes = scheduler.finished;
+
+    if (!restoreCheckpoint.empty()) {
+        try {
+            load_checkpoint(restoreCheckpoint, memManager, scheduler, ioManager);
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao restaurar o checkpoint: " << e.what() << "\n";
+            return 1;
+        }
+        std::cout << "Checkpoint '" << restoreCheckpoint << "' restaurado: " << process_list.size()
+                  << " processo(s), ciclo " << clock << ".\n";
     } else {
-        std::cerr << "Erro ao carregar 'process1.json'. Certifique-se de que o arquivo está na pasta raiz do projeto.\n";
-        return 1;
+        std::cout << "Carregando " << workload.processes.size() << " processo(s)...\n";
+        try {
+            process_list = load_workload(workload, memManager);
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao carregar a carga de trabalho: " << e.what() << "\n";
+            return 1;
+        }
+
+        // Processos entram na fila de prontos quando o relógio alcança seu arrival_time
+        for (const auto& process : process_list) {
+            events.schedule(process->arrival_time, EventKind::Arrival, process.get());
+        }
+    }
+
+    // Preditor da linha de comando: troca o tipo (tabelas zeradas) e/ou a penalidade
+    if (bpredKind || bpredPenalty) {
+        for (const auto& process : process_list) {
+            BranchPredictorConfig config = process->branchPredictor.config();
+            if (bpredPenalty) config.mispredictPenalty = *bpredPenalty;
+            if (bpredKind) config.kind = *bpredKind;
+            process->branchPredictor = BranchPredictor(config);
+        }
+    }
+
+    // Modo de verificação: cada processo roda em Core() e no núcleo rápido, lado a lado
+    if (lockstep) {
+        int divergences = 0;
+        for (const auto& process : process_list) {
+            LockstepReport report = run_lockstep(memManager, *process, lockstepOptions);
+            std::cout << "[Lockstep] Processo " << process->pid << ": " << format_lockstep_report(report);
+            if (!report.ok()) divergences++;
+        }
+        return divergences == 0 ? 0 : 1;
     }
 
-    // Adiciona os processos na fila de prontos
-    for (const auto& process : process_list) {
-        ready_queue.push_back(process.get());
+    // Amostragem: cada processo roda até o fim, só janelas curtas no pipeline detalhado
+    if (sampled) {
+        for (const auto& process : process_list) {
+            SamplingReport report = run_sampled(memManager, *process, samplingOptions);
+            std::cout << "[Amostragem] Processo " << process->pid << ": " << format_sampling_report(report);
+        }
+        return 0;
+    }
+
+    // Multithreading: grupos de processos dividem um núcleo, cada um num contexto
+    if (smtContexts > 0) {
+        for (size_t first = 0; first < process_list.size(); first += smtContexts) {
+            std::vector<PCB*> group;
+            for (size_t i = first; i < std::min(process_list.size(), first + smtContexts); ++i)
+                group.push_back(process_list[i].get());
+            SmtReport report = compare_smt(memManager, group, smt);
+            std::cout << "[SMT] " << format_smt_report(report);
+        }
+        return 0;
     }
 
     int total_processes = process_list.size();
-    int finished_processes = 0;
 
-    // 3. Loop Principal do Escalonador
+    // 4. Loop Principal do Escalonador: simulação por eventos em tempo virtual.
+    // O relógio pula direto para o próximo evento (chegada, fim de fatia ou
+    // fim de I/O), então CPU ociosa e I/O não custam tempo real.
     std::cout << "\nIniciando escalonador Round-Robin...\n";
+    PCB* running = nullptr; // processo com a fatia em andamento (SliceEnd agendado)
     while (finished_processes < total_processes) {
-        // Verifica se há processos que foram desbloqueados pelo IOManager
-        for (auto it = blocked_list.begin(); it != blocked_list.end(); ) {
-            if ((*it)->state == State::Ready) {
-                std::cout << "[Scheduler] Processo " << (*it)->pid << " desbloqueado e movido para a fila de prontos.\n";
-                ready_queue.push_back(*it);
-                it = blocked_list.erase(it);
-            } else {
-                ++it;
+        // O IOManager atende em outra thread e devolve os processos pela fila
+        // de conclusões (sem travas, O(conclusões)): o relógio só avança
+        // depois que todo processo bloqueado tem o seu ciclo de término
+        // (dorme até lá, sem consultar)
+        if (blocked_count > 0) {
+            for (PCB* process : ioManager.takeCompletions(blocked_count)) {
+                events.schedule(process->io_ready_cycle.load(), EventKind::IoCompletion, process);
+                blocked_count--;
             }
         }
 
-        if (ready_queue.empty()) {
-            if (blocked_list.empty()) {
-                break;
+        // CPU livre e todos os eventos deste ciclo tratados: próxima fatia
+        if (!running && (events.empty() || events.nextCycle() > clock)) {
+            // Checkpoint entre duas fatias, assim que o relógio alcança o ciclo pedido
+            if (!saveCheckpoint.empty() && clock >= checkpointAt) {
+                try {
+                    save_checkpoint(saveCheckpoint, memManager, scheduler, ioManager);
+                } catch (const std::exception& e) {
+                    std::cerr << "Erro ao gravar o checkpoint: " << e.what() << "\n";
+                    return 1;
+                }
+                std::cout << "\n[Scheduler] Checkpoint gravado em '" << saveCheckpoint << "' no ciclo " << clock << ".\n";
+                return 0;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            continue;
-        }
 
-        PCB* current_process = ready_queue.front();
-        ready_queue.pop_front();
+            if (!ready_queue.empty()) {
+                running = ready_queue.front();
+                ready_queue.pop_front();
 
-        std::cout << "\n[Scheduler] Executando processo " << current_process->pid << " (Quantum: " << current_process->quantum << ").\n";
-        current_process->state = State::Running;
+                std::cout << "\n[Scheduler] Executando processo " << running->pid << " (Quantum: " << running->quantum << ").\n";
+                running->state = State::Running;
 
-        std::vector<std::unique_ptr<IORequest>> io_requests;
-        bool print_lock = true;
+                std::vector<std::unique_ptr<IORequest>> io_requests;
+                bool print_lock = true;
 
-        // Executa o núcleo da CPU
-        Core(memManager, *current_process, &io_requests, print_lock);
+                // Executa o núcleo da CPU (pipeline detalhado ou interpretador rápido);
+                // a fatia termina depois dos ciclos que ela gastou
+                uint64_t cycles_before = running->pipeline_cycles.load();
+                runCore(memManager, *running, &io_requests, print_lock);
+                events.schedule(clock + (running->pipeline_cycles.load() - cycles_before), EventKind::SliceEnd, running);
+                continue;
+            }
+        }
+
+        // Nada pronto, nada agendado e ninguém esperando I/O
+        if (events.empty()) break;
 
-        // Avalia o estado do processo após a execução
-        switch (current_process->state) {
-            case State::Blocked:
-                std::cout << "[Scheduler] Processo " << current_process->pid << " bloqueado por I/O. Entregando ao IOManager.\n";
-                ioManager.registerProcessWaitingForIO(current_process);
-                blocked_list.push_back(current_process);
+        const Event event = events.pop();
+        clock = std::max(clock, event.cycle);
+        PCB* process = event.process;
+        switch (event.kind) {
+            case EventKind::Arrival:
+                ready_queue.push_back(process);
                 break;
 
-            case State::Finished:
-                std::cout << "[Scheduler] Processo " << current_process->pid << " finalizado.\n";
-                print_metrics(*current_process);
-                finished_processes++;
+            case EventKind::IoCompletion:
+                std::cout << "[Scheduler] Processo " << process->pid << " desbloqueado e movido para a fila de prontos.\n";
+                process->state = State::Ready;
+                ready_queue.push_back(process);
                 break;
 
-            default:
-                std::cout << "[Scheduler] Quantum do processo " << current_process->pid << " expirou. Voltando para a fila.\n";
-                current_process->state = State::Ready;
-                ready_queue.push_back(current_process);
+            case EventKind::SliceEnd:
+                running = nullptr;
+                // Avalia o estado do processo após a execução
+                switch (process->state) {
+                    case State::Blocked:
+                        std::cout << "[Scheduler] Processo " << process->pid << " bloqueado por I/O. Entregando ao IOManager.\n";
+                        ioManager.registerProcessWaitingForIO(process, clock);
+                        blocked_count++;
+                        break;
+
+                    case State::Finished:
+                        std::cout << "[Scheduler] Processo " << process->pid << " finalizado.\n";
+                        print_metrics(*process);
+                        finished_processes++;
+                        break;
+
+                    default:
+                        std::cout << "[Scheduler] Quantum do processo " << process->pid << " expirou. Voltando para a fila.\n";
+                        process->state = State::Ready;
+                        ready_queue.push_back(process);
+                        break;
+                }
                 break;
         }
     }
 
-    std::cout << "\nTodos os processos foram finalizados. Encerrando o simulador.\n";
+    std::cout << "\nTodos os processos foram finalizados no ciclo " << clock << ". Encerrando o simulador.\n";
+    if (!saveCheckpoint.empty()) {
+        std::cerr << "Checkpoint nao gravado: a simulacao terminou antes do ciclo " << checkpointAt << ".\n";
+        return 1;
+    }
 
     
 
@@ -1,38 +1,33 @@
 #include "MAIN_MEMORY.hpp"
 
 MAIN_MEMORY::MAIN_MEMORY(size_t size)
+    : size(size > MAX_MEMORY_SIZE ? MAX_MEMORY_SIZE : size),
+      ram(this->size, MEMORY_ACCESS_ERROR)
 {
-    if (size > MAX_MEMORY_SIZE)
-        this->size = MAX_MEMORY_SIZE;
-    else
-        this->size = size;
-
-    this->ram.resize(this->size, MEMORY_ACCESS_ERROR);
 }
 
 MAIN_MEMORY::~MAIN_MEMORY()
 {
-    this->ram.clear();
 }
 
 bool MAIN_MEMORY::isEmpty()
 {
-    for (auto &val : ram)
-        if (val != MEMORY_ACCESS_ERROR) return false;
+    for (size_t i = 0; i < size; ++i)
+        if (ram.get(i) != MEMORY_ACCESS_ERROR) return false;
     return true;
 }
 
 bool MAIN_MEMORY::notFull()
 {
-    for (auto &val : ram)
-        if (val == MEMORY_ACCESS_ERROR) return true;
+    for (size_t i = 0; i < size; ++i)
+        if (ram.get(i) == MEMORY_ACCESS_ERROR) return true;
     return false;
 }
 
 uint32_t MAIN_MEMORY::ReadMem(uint32_t address)
 {
     if (address < this->size)
-        return ram[address];
+        return ram.get(address);
     return MEMORY_ACCESS_ERROR;
 }
 
@@ -40,18 +35,18 @@ uint32_t MAIN_MEMORY::WriteMem(uint32_t address, uint32_t data)
 {
     if (address < this->size)
     {
-        ram[address] = data;
-        return ram[address];
+        ram.set(address, data);
+        return data;
     }
     return MEMORY_ACCESS_ERROR;
 }
 
 uint32_t MAIN_MEMORY::DeleteData(uint32_t address)
 {
-    if (address < this->size && ram[address] != MEMORY_ACCESS_ERROR)
+    if (address < this->size && ram.get(address) != MEMORY_ACCESS_ERROR)
     {
-        uint32_t deletedData = ram[address];
-        ram[address] = MEMORY_ACCESS_ERROR;
+        uint32_t deletedData = ram.get(address);
+        ram.set(address, MEMORY_ACCESS_ERROR);
         return deletedData;
     }
     return MEMORY_ACCESS_ERROR;
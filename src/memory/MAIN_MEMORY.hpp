@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <vector>
+#include "PagedStorage.hpp"
 
 #define MEMORY_ACCESS_ERROR UINT32_MAX
 #define MAX_MEMORY_SIZE 1024
@@ -15,7 +16,7 @@ class MAIN_MEMORY
 {
 private:
     size_t size;
-    vector<uint32_t> ram;
+    PagedStorage ram; // páginas com cópia na escrita: copiar a memória é barato
     bool notFull();
     bool isEmpty();
 
@@ -25,6 +26,7 @@ public:
     uint32_t ReadMem(uint32_t address);
     uint32_t WriteMem(uint32_t address, uint32_t data);
     uint32_t DeleteData(uint32_t address);
+    const PagedStorage &pages() const { return ram; }
 };
 
 #endif
\ No newline at end of file
@@ -1,48 +1,132 @@
 #include "MemoryManager.hpp"
+#include "../cpu/checkpoint.hpp"
+#include <algorithm>
+#include <atomic>
+
+uint64_t MemoryManager::nextVersion() {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
 
 MemoryManager::MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize) {
     mainMemory = std::make_unique<MAIN_MEMORY>(mainMemorySize);
     secondaryMemory = std::make_unique<SECONDARY_MEMORY>(secondaryMemorySize);
     L1_cache = std::make_unique<Cache>();
-    mainMemoryLimit = mainMemorySize;
+    // Os módulos limitam o tamanho pedido; os limites aqui seguem o tamanho real
+    mainMemoryLimit = std::min<size_t>(mainMemorySize, MAX_MEMORY_SIZE);
+    secondaryMemoryLimit = std::min<size_t>(secondaryMemorySize, MAX_SECONDARY_MEMORY_SIZE);
+    codeWords.assign((addressSpaceSize() + 3) / 4, false);
 }
 
-uint32_t MemoryManager::read(uint32_t address, PCB& process) {
-    process.mem_accesses_total.fetch_add(1);
-    process.mem_reads.fetch_add(1);
+MemoryManager::MemoryManager(const MemoryManager &other)
+    : mainMemory(std::make_unique<MAIN_MEMORY>(*other.mainMemory)),
+      secondaryMemory(std::make_unique<SECONDARY_MEMORY>(*other.secondaryMemory)),
+      L1_cache(std::make_unique<Cache>(*other.L1_cache)),
+      mainMemoryLimit(other.mainMemoryLimit),
+      secondaryMemoryLimit(other.secondaryMemoryLimit),
+      codeWords((addressSpaceSize() + 3) / 4, false) {}
+
+MemoryManager::PageStats MemoryManager::pageStats() const {
+    PageStats stats;
+    for (const PagedStorage *p : {&mainMemory->pages(), &secondaryMemory->pages()}) {
+        stats.pages += p->pageCount();
+        stats.shared += p->sharedPages();
+        stats.copied += p->copiedPages();
+    }
+    return stats;
+}
 
+uint32_t MemoryManager::fetch(uint32_t address, Level &level) {
     // 1. Tenta ler da Cache
     size_t cache_data = L1_cache->get(address);
-    if (cache_data != CACHE_MISS) {
-        process.cache_mem_accesses.fetch_add(1);
-        process.memory_cycles.fetch_add(process.memWeights.cache);
-
-        contabiliza_cache(process, true);  // HIT
-        return cache_data;
-    }
+    if (cache_data != CACHE_MISS) return cache_data;
 
     // 2. Cache Miss: busca na memória correta
-    contabiliza_cache(process, false); // MISS
-
     uint32_t data_from_mem;
     if (address < mainMemoryLimit) {
-        process.primary_mem_accesses.fetch_add(1);
-        process.memory_cycles.fetch_add(process.memWeights.primary);
+        level = std::max(level, Level::Primary);
         data_from_mem = mainMemory->ReadMem(address);
     } else {
-        process.secondary_mem_accesses.fetch_add(1);
-        process.memory_cycles.fetch_add(process.memWeights.secondary);
+        level = Level::Secondary;
         uint32_t secondaryAddress = address - mainMemoryLimit;
         data_from_mem = secondaryMemory->ReadMem(secondaryAddress);
     }
 
     // 3. Após a busca, armazena o dado na cache
     L1_cache->put(address, data_from_mem, this);
-
     return data_from_mem;
 }
 
+void MemoryManager::chargeRead(PCB &process, Level level) const {
+    process.mem_accesses_total.fetch_add(1);
+    process.mem_reads.fetch_add(1);
+    contabiliza_cache(process, level == Level::Cache);
+    switch (level) {
+        case Level::Cache:
+            process.cache_mem_accesses.fetch_add(1);
+            process.memory_cycles.fetch_add(process.memWeights.cache);
+            break;
+        case Level::Primary:
+            process.primary_mem_accesses.fetch_add(1);
+            process.memory_cycles.fetch_add(process.memWeights.primary);
+            break;
+        case Level::Secondary:
+            process.secondary_mem_accesses.fetch_add(1);
+            process.memory_cycles.fetch_add(process.memWeights.secondary);
+            break;
+    }
+}
+
+uint32_t MemoryManager::read(uint32_t address, PCB& process) {
+    Level level = Level::Cache;
+    const uint32_t data = fetch(address, level);
+    chargeRead(process, level);
+    return data;
+}
+
+unsigned MemoryManager::vectorLines(uint32_t address, unsigned lanes) {
+    if (lanes == 0) return 0;
+    const uint32_t last = address + 4 * (lanes - 1);
+    return last / LINE_BYTES - address / LINE_BYTES + 1;
+}
+
+void MemoryManager::readVector(uint32_t address, uint32_t *values, unsigned lanes, PCB& process) {
+    for (unsigned lane = 0; lane < lanes;) {
+        const uint32_t line = (address + 4 * lane) / LINE_BYTES;
+        Level level = Level::Cache;
+        for (; lane < lanes && (address + 4 * lane) / LINE_BYTES == line; ++lane)
+            values[lane] = fetch(address + 4 * lane, level);
+        chargeRead(process, level);
+    }
+}
+
+void MemoryManager::writeVector(uint32_t address, const uint32_t *values, unsigned lanes, PCB& process) {
+    size_t cached;
+    for (unsigned lane = 0; lane < lanes;) {
+        const uint32_t line = (address + 4 * lane) / LINE_BYTES;
+        unsigned end = lane;
+        bool hit = true;
+        for (; end < lanes && (address + 4 * end) / LINE_BYTES == line; ++end)
+            if (!L1_cache->peek(address + 4 * end, cached)) hit = false;
+
+        // Como em write(): a linha entra na cache (write-allocate) e fica suja
+        process.mem_accesses_total.fetch_add(1);
+        process.mem_writes.fetch_add(1);
+        contabiliza_cache(process, hit);
+        Level level = Level::Cache;
+        for (; lane < end; ++lane) {
+            invalidate(address + 4 * lane);
+            fetch(address + 4 * lane, level);
+            L1_cache->update(address + 4 * lane, values[lane]);
+        }
+        if (!hit) chargeRead(process, level);
+        process.cache_mem_accesses.fetch_add(1);
+        process.memory_cycles.fetch_add(process.memWeights.cache);
+    }
+}
+
 void MemoryManager::write(uint32_t address, uint32_t data, PCB& process) {
+    invalidate(address);
     process.mem_accesses_total.fetch_add(1);
     process.mem_writes.fetch_add(1);
 
@@ -61,6 +145,62 @@ void MemoryManager::write(uint32_t address, uint32_t data, PCB& process) {
     process.memory_cycles.fetch_add(process.memWeights.cache);
 }
 
+uint32_t MemoryManager::atomic(isa::Op op, uint32_t address, uint32_t operand, PCB &process, PCB *metrics) {
+    auto load = [&] { return metrics ? read(address, *metrics) : peek(address); };
+    auto store = [&](uint32_t value) {
+        if (metrics) write(address, value, *metrics);
+        else poke(address, value);
+    };
+    auto mine = std::find_if(reservations.begin(), reservations.end(),
+                             [&](const Reservation &r) { return r.owner == &process; });
+    process.atomic_operations.fetch_add(1);
+
+    switch (op) {
+        case isa::Op::LL: {
+            if (mine == reservations.end()) {
+                reservations.push_back({&process, address, false});
+                mine = reservations.end() - 1;
+            } else if (mine->address == address) {
+                process.spin_iterations.fetch_add(1); // outro ll sem sc: a trava estava tomada
+            }
+            const uint32_t value = load();
+            mine->address = address;
+            mine->valid = true;
+            return value;
+        }
+        case isa::Op::SC: {
+            const bool ok = mine != reservations.end() && mine->valid && mine->address == address;
+            if (mine != reservations.end()) reservations.erase(mine);
+            if (!ok) {
+                process.sc_failures.fetch_add(1);
+                process.spin_iterations.fetch_add(1);
+                return 0;
+            }
+            store(operand);
+            return 1;
+        }
+        case isa::Op::AMOSWAP: {
+            const uint32_t old = load();
+            store(operand);
+            if (old == operand) process.spin_iterations.fetch_add(1);
+            return old;
+        }
+        case isa::Op::AMOADD: {
+            const uint32_t old = load();
+            store(old + operand);
+            return old;
+        }
+        default:
+            throw std::invalid_argument("MemoryManager::atomic: instrucao nao atomica");
+    }
+}
+
+bool MemoryManager::reserved(const PCB &process, uint32_t address) const {
+    for (const Reservation &r : reservations)
+        if (r.owner == &process) return r.valid && r.address == address;
+    return false;
+}
+
 // Função chamada pela cache para escrever dados "sujos" de volta na memória
 void MemoryManager::writeToFile(uint32_t address, uint32_t data) {
     if (address < mainMemoryLimit) {
@@ -69,4 +209,50 @@ void MemoryManager::writeToFile(uint32_t address, uint32_t data) {
         uint32_t secondaryAddress = address - mainMemoryLimit;
         secondaryMemory->WriteMem(secondaryAddress, data);
     }
-}
\ No newline at end of file
+}
+
+uint32_t MemoryManager::peek(uint32_t address) const {
+    size_t cached;
+    if (L1_cache->peek(address, cached)) return static_cast<uint32_t>(cached);
+    if (address < mainMemoryLimit) return mainMemory->ReadMem(address);
+    return secondaryMemory->PeekMem(address - mainMemoryLimit);
+}
+
+void MemoryManager::poke(uint32_t address, uint32_t data) {
+    invalidate(address);
+    size_t cached;
+    if (L1_cache->peek(address, cached)) {
+        L1_cache->update(address, data); // fica suja, como numa escrita normal
+    } else if (address < mainMemoryLimit) {
+        mainMemory->WriteMem(address, data);
+    } else {
+        secondaryMemory->PokeMem(address - mainMemoryLimit, data);
+    }
+}
+
+void MemoryManager::saveState(std::ostream &out) const {
+    std::vector<uint32_t> words(mainMemoryLimit);
+    for (uint32_t a = 0; a < mainMemoryLimit; ++a) words[a] = mainMemory->ReadMem(a);
+    ckpt::putWords(out, words);
+    words.assign(secondaryMemoryLimit, 0);
+    for (uint32_t a = 0; a < secondaryMemoryLimit; ++a) words[a] = secondaryMemory->PeekMem(a);
+    ckpt::putWords(out, words);
+    L1_cache->saveState(out);
+}
+
+void MemoryManager::loadState(std::istream &in) {
+    const std::vector<uint32_t> main = ckpt::getWords(in, MAX_MEMORY_SIZE);
+    const std::vector<uint32_t> secondary = ckpt::getWords(in, MAX_SECONDARY_MEMORY_SIZE);
+    auto cache = std::make_unique<Cache>();
+    cache->loadState(in);
+
+    mainMemory = std::make_unique<MAIN_MEMORY>(main.size());
+    for (uint32_t a = 0; a < main.size(); ++a) mainMemory->WriteMem(a, main[a]);
+    secondaryMemory = std::make_unique<SECONDARY_MEMORY>(secondary.size());
+    for (uint32_t a = 0; a < secondary.size(); ++a) secondaryMemory->PokeMem(a, secondary[a]);
+    L1_cache = std::move(cache);
+    mainMemoryLimit = main.size();
+    secondaryMemoryLimit = secondary.size();
+    version = nextVersion();
+    codeWords.assign((addressSpaceSize() + 3) / 4, false);
+}
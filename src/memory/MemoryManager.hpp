@@ -2,7 +2,9 @@
 #define MEMORY_MANAGER_HPP
 
 #include <memory>
+#include <iosfwd>
 #include <stdexcept>
+#include <vector>
 #include "MAIN_MEMORY.hpp"
 #include "SECONDARY_MEMORY.hpp"
 #include "cache.hpp" // Incluir a cache
@@ -13,20 +15,111 @@ const size_t MAIN_MEMORY_SIZE = 1024;
 class MemoryManager {
 public:
     MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize);
+    // Cópia independente do original: a cache (inclusive linhas sujas) é
+    // copiada e as memórias compartilham páginas com cópia na escrita
+    // (PagedStorage), então copiar custa só as tabelas de páginas
+    MemoryManager(const MemoryManager &other);
+    MemoryManager &operator=(MemoryManager &&other) = default;
 
     // Métodos unificados agora recebem o PCB para as métricas
     uint32_t read(uint32_t address, PCB& process);
     void write(uint32_t address, uint32_t data, PCB& process);
     
+    // Acesso funcional: enxerga o mesmo valor que read()/write() (inclusive o que
+    // está sujo na cache), mas sem métricas e sem alocar linhas na cache.
+    // Usado pelo núcleo rápido (cpu/FAST_CORE), que contabiliza em lote.
+    uint32_t peek(uint32_t address) const;
+    void poke(uint32_t address, uint32_t data);
+
+    // Acesso vetorial (vload/vstore): 'lanes' palavras consecutivas a partir de
+    // 'address'. Cada palavra passa pela cache, mas as métricas contam um
+    // acesso por linha de LINE_BYTES tocada, com o custo do nível mais lento
+    // entre as palavras da linha.
+    static constexpr uint32_t LINE_BYTES = 16;
+    static unsigned vectorLines(uint32_t address, unsigned lanes);
+    void readVector(uint32_t address, uint32_t *values, unsigned lanes, PCB& process);
+    void writeVector(uint32_t address, const uint32_t *values, unsigned lanes, PCB& process);
+
+    // Sincronização: ll, sc, amoswap e amoadd (isa::isAtomic) numa só chamada,
+    // sem nada no meio. Devolve o valor que vai para rt. 'operand' é o rt lido
+    // pela instrução; as métricas de memória vão para 'metrics' (nullptr: só
+    // funcional, como peek/poke), os contadores de contenção para 'process'.
+    //
+    // Cada processo tem no máximo uma reserva, a do último ll. Qualquer
+    // escrita na palavra reservada (write, writeVector, poke, atômicas de outro
+    // processo) a invalida e o sc seguinte falha sem acessar a memória.
+    // Contam como spin_iterations: um ll repetido na mesma palavra sem sc no
+    // meio, um sc que falhou e um amoswap que não mudou a palavra (trava já
+    // tomada). As reservas não são copiadas nem gravadas no checkpoint.
+    uint32_t atomic(isa::Op op, uint32_t address, uint32_t operand, PCB &process, PCB *metrics);
+    bool reserved(const PCB &process, uint32_t address) const;
+
     // Função auxiliar para o write-back da cache
     void writeToFile(uint32_t address, uint32_t data);
 
+    // Checkpoint (cpu/checkpoint): tamanhos, conteúdo das duas memórias e a
+    // cache. loadState recria as memórias com os tamanhos gravados.
+    void saveState(std::ostream &out) const;
+    void loadState(std::istream &in);
+
+    // Bifurcação da memória: mesmo que a cópia, para ramificar uma máquina em
+    // execução em várias variantes (cada página é copiada só quando escrita)
+    std::unique_ptr<MemoryManager> fork() const { return std::make_unique<MemoryManager>(*this); }
+
+    struct PageStats {
+        size_t pages = 0;    // páginas das duas memórias
+        size_t shared = 0;   // ainda compartilhadas com outra cópia
+        uint64_t copied = 0; // duplicadas por escrita desde que esta cópia foi criada
+    };
+    PageStats pageStats() const;
+
+    // Total de endereços utilizáveis (principal + secundária, já limitadas)
+    size_t addressSpaceSize() const { return mainMemoryLimit + secondaryMemoryLimit; }
+
+    // Versão do código, para a tabela de pré-decodificação do núcleo rápido:
+    // muda quando uma escrita (write, writeVector, poke, atômicas) atinge uma
+    // palavra marcada com markCode, e a cada cópia ou loadState. Os valores
+    // nunca se repetem entre instâncias, então uma tabela guardada com a
+    // versão só vale para esta memória com este código.
+    uint64_t codeVersion() const { return version; }
+    void markCode(uint32_t address) {
+        if ((address & 3u) == 0 && (address >> 2) < codeWords.size()) codeWords[address >> 2] = true;
+    }
+
 private:
+    // De onde veio uma leitura (o mais lento, numa linha)
+    enum class Level : uint8_t { Cache, Primary, Secondary };
+    // Lê pela cache, trazendo a palavra em caso de miss, sem métricas
+    uint32_t fetch(uint32_t address, Level &level);
+    // Métricas de uma leitura servida pelo nível 'level'
+    void chargeRead(PCB &process, Level level) const;
+    // Escrita na palavra: as reservas de ll nela deixam de valer e, se ela
+    // já foi decodificada como instrução, o código muda de versão
+    void invalidate(uint32_t address) {
+        if ((address & 3u) == 0 && (address >> 2) < codeWords.size() && codeWords[address >> 2])
+            version = nextVersion();
+        if (reservations.empty()) return;
+        for (Reservation &r : reservations)
+            if (r.address == address) r.valid = false;
+    }
+
+    struct Reservation {
+        const PCB *owner = nullptr;
+        uint32_t address = 0;
+        bool valid = false; // invalidada: o ll ainda conta para detectar a repetição
+    };
+    std::vector<Reservation> reservations;
+
     std::unique_ptr<MAIN_MEMORY> mainMemory;
     std::unique_ptr<SECONDARY_MEMORY> secondaryMemory;
     std::unique_ptr<Cache> L1_cache; // Adiciona a Cache L1
 
     size_t mainMemoryLimit;
+    size_t secondaryMemoryLimit;
+
+    static uint64_t nextVersion();
+    uint64_t version = nextVersion();
+    std::vector<bool> codeWords; // uma por palavra alinhada (endereço/4)
 };
 
 #endif // MEMORY_MANAGER_HPP
\ No newline at end of file
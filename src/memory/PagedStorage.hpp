@@ -0,0 +1,80 @@
+#ifndef PAGED_STORAGE_HPP
+#define PAGED_STORAGE_HPP
+/*
+  PagedStorage.hpp
+  Vetor de palavras dividido em páginas compartilhadas com cópia na escrita
+  (copy-on-write). É o armazenamento da MAIN_MEMORY e da SECONDARY_MEMORY.
+
+  - Copiar um PagedStorage copia só a tabela de páginas: as duas cópias
+    enxergam as mesmas páginas até uma delas escrever. A primeira escrita numa
+    página compartilhada duplica apenas aquela página (PAGE_WORDS palavras).
+  - Páginas nunca escritas apontam todas para a mesma página de preenchimento.
+  - Cópias podem ser usadas em threads diferentes (a contagem de referências
+    do shared_ptr é atômica). O que não pode é copiar um PagedStorage enquanto
+    outra thread escreve nele.
+*/
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class PagedStorage {
+public:
+    static constexpr std::size_t PAGE_BITS = 6;
+    static constexpr std::size_t PAGE_WORDS = std::size_t(1) << PAGE_BITS; // 64 palavras
+    static constexpr std::size_t PAGE_MASK = PAGE_WORDS - 1;
+
+    PagedStorage(std::size_t words, uint32_t fill) : words(words) {
+        auto page = std::make_shared<Page>();
+        page->fill(fill);
+        pages.assign((words + PAGE_MASK) >> PAGE_BITS, page);
+    }
+
+    // Cópia barata: compartilha todas as páginas; os contadores recomeçam
+    PagedStorage(const PagedStorage &other) : pages(other.pages), words(other.words) {}
+    PagedStorage &operator=(const PagedStorage &other) {
+        pages = other.pages;
+        words = other.words;
+        copies = 0;
+        return *this;
+    }
+
+    std::size_t size() const { return words; }
+
+    // Sem checagem de limites: quem chama garante address < size()
+    uint32_t get(std::size_t address) const {
+        return (*pages[address >> PAGE_BITS])[address & PAGE_MASK];
+    }
+    void set(std::size_t address, uint32_t value) {
+        writablePage(address >> PAGE_BITS)[address & PAGE_MASK] = value;
+    }
+
+    std::size_t pageCount() const { return pages.size(); }
+    // Páginas ainda compartilhadas com outra cópia (ou com a página de preenchimento)
+    std::size_t sharedPages() const {
+        std::size_t n = 0;
+        for (const auto &p : pages) n += p.use_count() > 1;
+        return n;
+    }
+    // Páginas que esta cópia precisou duplicar desde que foi criada
+    uint64_t copiedPages() const { return copies; }
+
+private:
+    using Page = std::array<uint32_t, PAGE_WORDS>;
+
+    Page &writablePage(std::size_t index) {
+        std::shared_ptr<Page> &page = pages[index];
+        if (page.use_count() > 1) {
+            page = std::make_shared<Page>(*page);
+            ++copies;
+        }
+        return *page;
+    }
+
+    std::vector<std::shared_ptr<Page>> pages;
+    std::size_t words;
+    uint64_t copies = 0;
+};
+
+#endif // PAGED_STORAGE_HPP
@@ -1,17 +1,10 @@
 #include "SECONDARY_MEMORY.hpp"
 
-SECONDARY_MEMORY::SECONDARY_MEMORY(size_t size) {
-    if (size > MAX_SECONDARY_MEMORY_SIZE) {
-        this->size = MAX_SECONDARY_MEMORY_SIZE;
-    } else {
-        this->size = size;
-    }
-    this->storage.resize(this->size, MEMORY_ACCESS_ERROR);
-}
+SECONDARY_MEMORY::SECONDARY_MEMORY(size_t size)
+    : size(size > MAX_SECONDARY_MEMORY_SIZE ? MAX_SECONDARY_MEMORY_SIZE : size),
+      storage(this->size, MEMORY_ACCESS_ERROR) {}
 
-SECONDARY_MEMORY::~SECONDARY_MEMORY() {
-    this->storage.clear();
-}
+SECONDARY_MEMORY::~SECONDARY_MEMORY() {}
 
 // Simulação de acesso lento
 uint32_t SECONDARY_MEMORY::ReadMem(uint32_t address) {
@@ -19,7 +12,7 @@ uint32_t SECONDARY_MEMORY::ReadMem(uint32_t address) {
         // Varredura simulada: percorre o vetor para encontrar o endereço
         for (uint32_t i = 0; i < this->size; ++i) {
             if (i == address) {
-                return storage[i];
+                return storage.get(i);
             }
         }
     }
@@ -32,7 +25,7 @@ uint32_t SECONDARY_MEMORY::WriteMem(uint32_t address, uint32_t data) {
         // Varredura simulada: percorre o vetor para encontrar o endereço
         for (uint32_t i = 0; i < this->size; ++i) {
             if (i == address) {
-                storage[i] = data;
+                storage.set(i, data);
                 return data;
             }
         }
@@ -40,25 +33,33 @@ uint32_t SECONDARY_MEMORY::WriteMem(uint32_t address, uint32_t data) {
     return MEMORY_ACCESS_ERROR;
 }
 
+uint32_t SECONDARY_MEMORY::PeekMem(uint32_t address) const {
+    return address < this->size ? storage.get(address) : MEMORY_ACCESS_ERROR;
+}
+
+void SECONDARY_MEMORY::PokeMem(uint32_t address, uint32_t data) {
+    if (address < this->size) storage.set(address, data);
+}
+
 uint32_t SECONDARY_MEMORY::DeleteData(uint32_t address) {
     if (address < this->size) {
-        uint32_t deletedData = storage[address];
-        storage[address] = MEMORY_ACCESS_ERROR;
+        uint32_t deletedData = storage.get(address);
+        storage.set(address, MEMORY_ACCESS_ERROR);
         return deletedData;
     }
     return MEMORY_ACCESS_ERROR;
 }
 
 bool SECONDARY_MEMORY::isEmpty() {
-    for (const auto &val : storage) {
-        if (val != MEMORY_ACCESS_ERROR) return false;
+    for (size_t i = 0; i < size; ++i) {
+        if (storage.get(i) != MEMORY_ACCESS_ERROR) return false;
     }
     return true;
 }
 
 bool SECONDARY_MEMORY::notFull() {
-    for (const auto &val : storage) {
-        if (val == MEMORY_ACCESS_ERROR) return true;
+    for (size_t i = 0; i < size; ++i) {
+        if (storage.get(i) == MEMORY_ACCESS_ERROR) return true;
     }
     return false;
 }
\ No newline at end of file
@@ -4,9 +4,10 @@
 #include <cstdint>
 #include <vector>
 #include <cstddef>
+#include "PagedStorage.hpp"
 
 #define MEMORY_ACCESS_ERROR UINT32_MAX
-#define MAX_SECONDARY_MEMORY_SIZE 8192
+#define MAX_SECONDARY_MEMORY_SIZE 65536
 
 using std::size_t;
 using std::uint32_t;
@@ -15,7 +16,7 @@ using std::vector;
 class SECONDARY_MEMORY {
 private:
     size_t size;
-    vector<uint32_t> storage; // Alterado para um vetor simples
+    PagedStorage storage; // páginas com cópia na escrita: copiar a memória é barato
 
     bool notFull();
     bool isEmpty();
@@ -26,6 +27,10 @@ public:
     uint32_t ReadMem(uint32_t address);
     uint32_t WriteMem(uint32_t address, uint32_t data);
     uint32_t DeleteData(uint32_t address);
+    // Acesso direto, sem a varredura simulada (usado pelo acesso funcional)
+    uint32_t PeekMem(uint32_t address) const;
+    void PokeMem(uint32_t address, uint32_t data);
+    const PagedStorage &pages() const { return storage; }
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "cache.hpp"
 #include "cachePolicy.hpp"
 #include "MemoryManager.hpp" // Necessário para a lógica de write-back
+#include "../cpu/checkpoint.hpp"
 
 Cache::Cache() {
     this->capacity = CACHE_CAPACITY;
@@ -23,6 +24,13 @@ size_t Cache::get(size_t address) {
     return CACHE_MISS; // Cache miss
 }
 
+bool Cache::peek(size_t address, size_t &data) const {
+    auto it = cacheMap.find(address);
+    if (it == cacheMap.end() || !it->second.isValid) return false;
+    data = it->second.data;
+    return true;
+}
+
 void Cache::put(size_t address, size_t data, MemoryManager* memManager) {
     // Se a cache está cheia, precisamos remover um item
     if (cacheMap.size() >= capacity) {
@@ -96,4 +104,39 @@ int Cache::get_misses(){
 int Cache::get_hits(){
        // Retorna o número de cache hits
     return cache_hits;
-}
\ No newline at end of file
+}
+
+void Cache::saveState(std::ostream &out) const {
+    ckpt::put<uint64_t>(out, capacity);
+    ckpt::put<int32_t>(out, cache_hits);
+    ckpt::put<int32_t>(out, cache_misses);
+    ckpt::put<uint32_t>(out, static_cast<uint32_t>(cacheMap.size()));
+    for (const auto &c : cacheMap) {
+        ckpt::put<uint64_t>(out, c.first);
+        ckpt::put<uint64_t>(out, c.second.data);
+        ckpt::put<uint8_t>(out, c.second.isValid);
+        ckpt::put<uint8_t>(out, c.second.isDirty);
+    }
+    // A fila não é iterável: percorre uma cópia
+    std::queue<size_t> order = fifo_queue;
+    ckpt::put<uint32_t>(out, static_cast<uint32_t>(order.size()));
+    for (; !order.empty(); order.pop()) ckpt::put<uint64_t>(out, order.front());
+}
+
+void Cache::loadState(std::istream &in) {
+    capacity = ckpt::get<uint64_t>(in);
+    cache_hits = ckpt::get<int32_t>(in);
+    cache_misses = ckpt::get<int32_t>(in);
+    cacheMap.clear();
+    for (uint32_t n = ckpt::get<uint32_t>(in); n > 0; --n) {
+        const size_t address = ckpt::get<uint64_t>(in);
+        CacheEntry entry;
+        entry.data = ckpt::get<uint64_t>(in);
+        entry.isValid = ckpt::get<uint8_t>(in) != 0;
+        entry.isDirty = ckpt::get<uint8_t>(in) != 0;
+        cacheMap[address] = entry;
+    }
+    std::queue<size_t> order;
+    for (uint32_t n = ckpt::get<uint32_t>(in); n > 0; --n) order.push(ckpt::get<uint64_t>(in));
+    fifo_queue.swap(order);
+}
@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <vector>
 #include <queue> // Adicionado para FIFO
+#include <iosfwd>
 
 #define CACHE_CAPACITY 16
 #define CACHE_MISS UINT32_MAX
@@ -31,11 +32,16 @@ public:
     int get_misses();
     int get_hits();
     size_t get(size_t address);
+    // Consulta sem contar hit/miss: true e 'data' preenchido se o endereço está na cache
+    bool peek(size_t address, size_t &data) const;
     // O método put agora precisa interagir com o MemoryManager para o write-back
     void put(size_t address, size_t data, MemoryManager* memManager);
     void update(size_t address, size_t data);
     void invalidate();
     std::vector<std::pair<size_t, size_t>> dirtyData(); // Mantido para possíveis outras lógicas
+    // Checkpoint (cpu/checkpoint): linhas, ordem FIFO e contadores
+    void saveState(std::ostream &out) const;
+    void loadState(std::istream &in);
 };
 
 #endif
\ No newline at end of file
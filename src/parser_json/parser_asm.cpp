@@ -0,0 +1,268 @@
+#include "parser_asm.hpp"
+#include "parser_json.hpp"
+#include "../cpu/ISA.hpp"
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Uma instrução da seção .text, guardada até todos os rótulos serem conhecidos
+struct AsmStatement {
+    int line;
+    string mnem;
+    vector<string> ops;
+};
+
+string trim(const string &s){
+    size_t b = 0, e = s.size();
+    while (b < e && isspace(static_cast<unsigned char>(s[b]))) ++b;
+    while (e > b && isspace(static_cast<unsigned char>(s[e-1]))) --e;
+    return s.substr(b, e - b);
+}
+
+vector<string> splitOperands(const string &s){
+    vector<string> ops;
+    if (trim(s).empty()) return ops;
+    size_t start = 0;
+    for (size_t i = 0; i <= s.size(); ++i){
+        if (i == s.size() || s[i] == ','){
+            ops.push_back(trim(s.substr(start, i - start)));
+            start = i + 1;
+        }
+    }
+    return ops;
+}
+
+[[noreturn]] void fail(int line, const string &msg){
+    throw runtime_error("linha " + to_string(line) + ": " + msg);
+}
+
+// Números como no JSON: decimal ou 0x.., com sinal
+long parseNumber(int line, const string &s){
+    try {
+        size_t used = 0;
+        long v = stol(s, &used, 0);
+        if (used == s.size()) return v;
+    } catch (const exception &) {}
+    fail(line, "número inválido: " + s);
+}
+
+bool isNumber(const string &s){
+    size_t i = (!s.empty() && (s[0] == '-' || s[0] == '+')) ? 1 : 0;
+    return i < s.size() && isdigit(static_cast<unsigned char>(s[i]));
+}
+
+class AsmAssembler {
+public:
+    explicit AsmAssembler(int startAddr) : data{image, ctx, startAddr, {}} {
+        image.startAddr = static_cast<uint32_t>(startAddr);
+    }
+
+    ProgramImage run(const string &source){
+        istringstream in(source);
+        string raw;
+        int line = 0;
+        while (getline(in, raw)) statement(++line, raw);
+
+        // Layout igual ao do loader JSON: dados primeiro, depois o código
+        data.flushBytes();
+        image.words.resize(static_cast<size_t>(data.addr - static_cast<int>(image.startAddr)) / 4, 0);
+        image.codeOffset = static_cast<uint32_t>(image.words.size());
+        ctx.codeBase = static_cast<int>(image.entryAddr());
+        for (size_t i = 0; i < text.size(); ++i){
+            if (isDataReference(text[i]) || isCodeReference(text[i])) image.relocations.push_back(image.codeOffset + static_cast<uint32_t>(i));
+            image.words.push_back(encode(text[i], static_cast<int>(i)));
+        }
+        return std::move(image);
+    }
+
+private:
+    ProgramImage image;
+    AssemblerContext ctx;
+    DataWriter data;
+    vector<AsmStatement> text;
+    bool inData = false;
+
+    void statement(int line, string s){
+        auto hash = s.find('#');
+        if (hash != string::npos) s.erase(hash);
+        s = trim(s);
+
+        // Rótulos no início da linha (podem ser vários)
+        for (auto colon = s.find(':'); colon != string::npos; colon = s.find(':')){
+            string lbl = trim(s.substr(0, colon));
+            if (lbl.empty() || lbl.find_first_of(" \t,($") != string::npos) break;
+            if (inData) {
+                try { data.label(lbl); } catch (const exception &e) { fail(line, e.what()); }
+            } else if (!ctx.labelMap.emplace(lbl, static_cast<int>(text.size())).second)
+                fail(line, "rótulo repetido: " + lbl);
+            s = trim(s.substr(colon + 1));
+        }
+        if (s.empty()) return;
+
+        size_t sp = s.find_first_of(" \t");
+        string mnem = toLower(s.substr(0, sp));
+        string rest = sp == string::npos ? string() : s.substr(sp + 1);
+
+        if (mnem[0] == '.') directive(line, mnem, splitOperands(rest));
+        else if (inData) fail(line, "instrução na seção .data: " + mnem);
+        else if (!isa::find(mnem)) fail(line, "instrução desconhecida: " + mnem);
+        else text.push_back({line, mnem, splitOperands(rest)});
+    }
+
+    void directive(int line, const string &name, const vector<string> &ops){
+        if (name == ".data") { inData = true; return; }
+        if (name == ".text") { inData = false; return; }
+        if (!inData) fail(line, name + " fora da seção .data");
+        if (ops.empty()) fail(line, name + " sem valores");
+
+        if (name == ".word"){
+            data.flushBytes();
+            for (auto &v : ops) data.word(static_cast<int>(parseNumber(line, v)));
+        } else if (name == ".byte"){
+            for (auto &v : ops) data.byte(static_cast<uint8_t>(parseNumber(line, v)));
+        } else {
+            fail(line, "diretiva desconhecida: " + name);
+        }
+    }
+
+    static bool isDataReference(const AsmStatement &st){
+        const isa::InstrDesc *d = isa::find(st.mnem);
+        return (d->syntax == isa::Syntax::RtMem || d->syntax == isa::Syntax::VtMem) &&
+               st.ops.size() == 2 && st.ops[1].find('(') == string::npos && !isNumber(st.ops[1]);
+    }
+
+    static bool isCodeReference(const AsmStatement &st){
+        const isa::InstrDesc *d = isa::find(st.mnem);
+        return d->syntax == isa::Syntax::Target && st.ops.size() == 1 && !isNumber(st.ops[0]);
+    }
+
+    static void expect(const AsmStatement &st, size_t count){
+        if (st.ops.size() != count)
+            fail(st.line, st.mnem + " espera " + to_string(count) + " operando(s)");
+    }
+
+    int reg(const AsmStatement &st, size_t i) const {
+        auto it = registerMap.find(toLower(st.ops[i]));
+        if (it == registerMap.end()) fail(st.line, "registrador desconhecido: " + st.ops[i]);
+        return it->second;
+    }
+
+    int vreg(const AsmStatement &st, size_t i) const {
+        auto it = vectorRegisterMap.find(toLower(st.ops[i]));
+        if (it == vectorRegisterMap.end()) fail(st.line, "registrador vetorial desconhecido: " + st.ops[i]);
+        return it->second;
+    }
+
+    int codeLabel(const AsmStatement &st, const string &lbl) const {
+        auto it = ctx.labelMap.find(lbl);
+        if (it == ctx.labelMap.end()) fail(st.line, "rótulo desconhecido: " + lbl);
+        return it->second;
+    }
+
+    int16_t imm16(const AsmStatement &st, size_t i) const {
+        return static_cast<int16_t>(parseNumber(st.line, st.ops[i]));
+    }
+
+    // Operandos conforme a sintaxe da tabela ISA (mesmas regras dos encoders JSON)
+    uint32_t encode(const AsmStatement &st, int pcIdx) const {
+        const isa::InstrDesc &d = *isa::find(st.mnem);
+
+        switch (d.syntax){
+            case isa::Syntax::None:
+                expect(st, 0);
+                return isa::encodeI(d, 0, 0, 0);
+
+            case isa::Syntax::Rt:
+                expect(st, 1);
+                return isa::encodeI(d, 0, reg(st, 0), 0);
+
+            case isa::Syntax::RdRsRt:
+                expect(st, 3);
+                return isa::encodeR(d, reg(st, 1), reg(st, 2), reg(st, 0), 0);
+
+            case isa::Syntax::RdRtShamt:
+                expect(st, 3);
+                return isa::encodeR(d, 0, reg(st, 1), reg(st, 0), imm16(st, 2));
+
+            case isa::Syntax::Rs:
+                expect(st, 1);
+                return isa::encodeR(d, reg(st, 0), 0, 0, 0);
+
+            case isa::Syntax::Rd:
+                expect(st, 1);
+                return isa::encodeR(d, 0, 0, reg(st, 0), 0);
+
+            case isa::Syntax::RtRsImm:
+                expect(st, 3);
+                return isa::encodeI(d, reg(st, 1), reg(st, 0), imm16(st, 2));
+
+            case isa::Syntax::RtImm: // li -> addi rt, $zero, imm
+                expect(st, 2);
+                return isa::encodeI(d, 0, reg(st, 0), imm16(st, 1));
+
+            case isa::Syntax::RtMem:
+            case isa::Syntax::VtMem: {
+                expect(st, 2);
+                const int rt = d.syntax == isa::Syntax::VtMem ? vreg(st, 0) : reg(st, 0);
+                if (isDataReference(st)){
+                    auto it = ctx.dataMap.find(st.ops[1]);
+                    if (it == ctx.dataMap.end()) fail(st.line, "rótulo de dados desconhecido: " + st.ops[1]);
+                    return isa::encodeI(d, 0, rt, it->second & 0xFFFF);
+                }
+                if (st.ops[1].find('(') == string::npos) return isa::encodeI(d, 0, rt, imm16(st, 1)); // endereço absoluto = n($zero)
+                pair<int16_t,int> pr;
+                try { pr = parseOffsetBase(st.ops[1]); }
+                catch (const exception &e) { fail(st.line, e.what()); }
+                return isa::encodeI(d, pr.second, rt, pr.first);
+            }
+
+            case isa::Syntax::VdVsVt:
+                expect(st, 3);
+                return isa::encodeR(d, vreg(st, 1), vreg(st, 2), vreg(st, 0), 0);
+
+            case isa::Syntax::RsRtLabel: {
+                expect(st, 3);
+                const string &target = st.ops[2];
+                int16_t imm = isNumber(target) ? imm16(st, 2)
+                                               : static_cast<int16_t>(codeLabel(st, target) - (pcIdx + 1));
+                return isa::encodeI(d, reg(st, 0), reg(st, 1), imm);
+            }
+
+            case isa::Syntax::Target: {
+                expect(st, 1);
+                long addr = isCodeReference(st) ? ctx.codeBase + codeLabel(st, st.ops[0]) * 4
+                                                : parseNumber(st.line, st.ops[0]);
+                return isa::encodeJ(d, static_cast<uint32_t>(addr));
+            }
+        }
+        fail(st.line, "sintaxe não suportada: " + st.mnem);
+    }
+};
+
+} // namespace
+
+ProgramImage compileAsmSource(const string &source, int startAddr){
+    AsmAssembler assembler(startAddr);
+    return assembler.run(source);
+}
+
+ProgramImage compileAsmProgram(const string &filename, int startAddr){
+    ifstream f(filename, ios::binary);
+    if (!f) throw runtime_error("Não foi possível abrir: " + filename);
+    ostringstream buf;
+    buf << f.rdbuf();
+    return compileAsmSource(buf.str(), startAddr);
+}
+
+bool isAsmFile(const string &filename){
+    auto dot = filename.rfind('.');
+    if (dot == string::npos) return false;
+    const string ext = toLower(filename.substr(dot));
+    return ext == ".s" || ext == ".asm";
+}
@@ -0,0 +1,43 @@
+#pragma once
+/*
+  parser_asm.hpp
+  Montador de texto estilo MIPS (.s), alternativa ao formato JSON.
+
+  Usa a tabela ISA (cpu/ISA.hpp) e as tabelas de parser_json.cpp, então um programa
+  escrito em texto gera exatamente as mesmas palavras (e a mesma imagem:
+  dados primeiro, depois o código, com as mesmas relocações).
+
+  Sintaxe:
+      # comentário até o fim da linha
+      .data
+      x:       .word 15
+      nums:    .word 5, 10, 0x0F
+      bytes:   .byte 1, 2, 3
+      .text
+      start:   li   $t0, 100
+               add  $t2, $t0, $t1
+               sll  $t3, $t2, 2
+               lw   $s0, x            # rótulo de dado: endereço absoluto (relocável)
+               lw   $s1, 4($sp)       # offset(base)
+               lw   $s2, 100          # número: endereço absoluto, como 100($zero)
+               vload.4 $w0, nums      # 4 palavras de nums para $w0 (SIMD, 4 ou 8 lanes)
+               vadd.4  $w2, $w0, $w1
+      loop:    beq  $t8, $zero, fim   # rótulo ou offset numérico
+               j    loop
+      fim:     print $t8
+               end
+
+  As seções .data e .text podem aparecer em qualquer ordem e repetidas.
+  Erros lançam runtime_error com o número da linha.
+*/
+#include <string>
+#include "program_image.hpp"
+
+// Monta o texto de um programa (conteúdo já em memória).
+ProgramImage compileAsmSource(const std::string &source, int startAddr);
+
+// Lê e monta um arquivo .s. Reentrante, como compileJsonProgram.
+ProgramImage compileAsmProgram(const std::string &filename, int startAddr);
+
+// true para arquivos com extensão .s ou .asm
+bool isAsmFile(const std::string &filename);
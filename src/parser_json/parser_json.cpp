@@ -1,42 +1,51 @@
 #include "parser_json.hpp"
-#include "../memory/MemoryManager.hpp" // Alterado de MainMemory.hpp
-#include "../cpu/PCB.hpp"              // Incluído para a função write
+#include "program_image.hpp"
+#include "parser_asm.hpp"
+#include "../cpu/ISA.hpp"
 #include <unordered_map>
 #include <fstream>
 #include <algorithm>
 #include <cctype>
 #include <vector>
+#include <map>
 #include <stdexcept>
 
 using namespace std;
 using nlohmann::json;
 
-// ======= Tabelas (sem alterações) =======
-const unordered_map<string, int> instructionMap = {
-    {"add",0}, {"sub",0}, {"and",0}, {"or",0}, {"mult",0}, {"div",0}, {"sll",0}, {"srl",0}, {"jr",0},
-    {"addi",0b001000}, {"andi",0b001100}, {"ori",0b001101}, {"slti",0b001010},
-    {"lw",0b100011}, {"sw",0b101011}, {"beq",0b000100}, {"bne",0b000101},
-    {"bgt",0b000111}, {"blt",0b001001}, {"li",0b001111}, {"print",0b111110}, {"end",0b111111},
-    {"j",0b000010}, {"jal",0b000011}
-};
+// ======= Tabelas (geradas a partir de cpu/ISA.hpp) =======
+static unordered_map<string, int> buildInstructionMap(){
+    unordered_map<string, int> m;
+    for (const auto &d : isa::ISA_TABLE) m.emplace(string(d.mnemonic), d.opcode);
+    return m;
+}
 
-const unordered_map<string, int> functMap = {
-    {"add",0b100000}, {"sub",0b100010}, {"and",0b100100}, {"or",0b100101},
-    {"mult",0b011000}, {"div",0b011010}, {"sll",0b000000}, {"srl",0b000010}, {"jr",0b001000}
-};
+static unordered_map<string, int> buildFunctMap(){
+    unordered_map<string, int> m;
+    for (const auto &d : isa::ISA_TABLE)
+        if (d.format == isa::Format::R) m.emplace(string(d.mnemonic), d.funct);
+    return m;
+}
 
-const unordered_map<string, int> registerMap = {
-    {"$zero",0},{"$at",1},{"$v0",2},{"$v1",3},
-    {"$a0",4},{"$a1",5},{"$a2",6},{"$a3",7},
-    {"$t0",8},{"$t1",9},{"$t2",10},{"$t3",11},{"$t4",12},{"$t5",13},{"$t6",14},{"$t7",15},
-    {"$s0",16},{"$s1",17},{"$s2",18},{"$s3",19},{"$s4",20},{"$s5",21},{"$s6",22},{"$s7",23},
-    {"$t8",24},{"$t9",25},{"$k0",26},{"$k1",27},{"$gp",28},{"$sp",29},{"$fp",30},{"$ra",31}
-};
+static unordered_map<string, int> buildRegisterMap(){
+    unordered_map<string, int> m;
+    for (size_t i = 0; i < isa::REGISTER_NAMES.size(); ++i) m.emplace(string(isa::REGISTER_NAMES[i]), static_cast<int>(i));
+    return m;
+}
+
+static unordered_map<string, int> buildVectorRegisterMap(){
+    unordered_map<string, int> m;
+    for (size_t i = 0; i < isa::VECTOR_REGISTER_NAMES.size(); ++i) m.emplace(string(isa::VECTOR_REGISTER_NAMES[i]), static_cast<int>(i));
+    return m;
+}
+
+const unordered_map<string, int> instructionMap = buildInstructionMap();
+const unordered_map<string, int> functMap = buildFunctMap();
+const unordered_map<string, int> registerMap = buildRegisterMap();
+const unordered_map<string, int> vectorRegisterMap = buildVectorRegisterMap();
 
-static unordered_map<string, int> dataMap;
-static unordered_map<string, int> labelMap;
 
-// ======= Utils e Helpers (sem alterações) =======
+// ======= Utils e Helpers =======
 string toLower(string s){
     transform(s.begin(), s.end(), s.begin(), [](unsigned char c){return std::tolower(c);});
     return s;
@@ -69,6 +78,12 @@ int getRegisterCode(const string &reg){
     throw runtime_error("Registrador desconhecido: " + reg);
 }
 
+int getVectorRegisterCode(const string &reg){
+    auto it = vectorRegisterMap.find(toLower(reg));
+    if (it!=vectorRegisterMap.end()) return it->second;
+    throw runtime_error("Registrador vetorial desconhecido: " + reg);
+}
+
 int getOpcode(const string &instr){
     auto it = instructionMap.find(toLower(instr));
     if (it!=instructionMap.end()) return it->second;
@@ -80,6 +95,12 @@ int getFunct(const string &instr){
     return (it!=functMap.end())? it->second : 0;
 }
 
+static const isa::InstrDesc &getInstrDesc(const string &instr){
+    const isa::InstrDesc *d = isa::find(toLower(instr));
+    if (!d) throw runtime_error("Instrução desconhecida: " + instr);
+    return *d;
+}
+
 uint32_t buildBinaryInstruction(int opcode, int rs, int rt, int rd, int shamt, int funct,
                                 int immediate, int address)
 {
@@ -107,89 +128,106 @@ uint32_t buildBinaryInstruction(int opcode, int rs, int rt, int rd, int shamt, i
     }
 }
 
-// ======= Encoders (sem alterações) =======
+// ======= Encoders (operandos conforme a sintaxe da tabela ISA) =======
 uint32_t encodeRType(const json &j){
-    const string mnem = j.at("instruction").get<string>();
-    int opcode = getOpcode(mnem);
-    int funct  = getFunct(mnem);
+    const isa::InstrDesc &d = getInstrDesc(j.at("instruction").get<string>());
     int rs=0, rt=0, rd=0, sh=0;
 
-    if (mnem=="sll" || mnem=="srl"){
-        rd = getRegisterCode(j.at("rd").get<string>());
-        rt = getRegisterCode(j.at("rt").get<string>());
-        sh = parseImmediate(j.at("shamt"));
-    } else if (mnem=="jr"){
-        rs = getRegisterCode(j.at("rs").get<string>());
-    } else {
-        rd = getRegisterCode(j.at("rd").get<string>());
-        rs = getRegisterCode(j.at("rs").get<string>());
-        rt = getRegisterCode(j.at("rt").get<string>());
+    switch (d.syntax){
+        case isa::Syntax::RdRtShamt:
+            rd = getRegisterCode(j.at("rd").get<string>());
+            rt = getRegisterCode(j.at("rt").get<string>());
+            sh = parseImmediate(j.at("shamt"));
+            break;
+        case isa::Syntax::Rs:
+            rs = getRegisterCode(j.at("rs").get<string>());
+            break;
+        case isa::Syntax::Rd:
+            rd = getRegisterCode(j.at("rd").get<string>());
+            break;
+        case isa::Syntax::VdVsVt:
+            rd = getVectorRegisterCode(j.at("rd").get<string>());
+            rs = getVectorRegisterCode(j.at("rs").get<string>());
+            rt = getVectorRegisterCode(j.at("rt").get<string>());
+            break;
+        default:
+            rd = getRegisterCode(j.at("rd").get<string>());
+            rs = getRegisterCode(j.at("rs").get<string>());
+            rt = getRegisterCode(j.at("rt").get<string>());
+            break;
     }
-    return buildBinaryInstruction(opcode, rs, rt, rd, sh, funct, 0, 0);
+    return isa::encodeR(d, rs, rt, rd, sh);
 }
 
-uint32_t encodeIType(const json &j, int pcIdx){
-    string mnem = j.at("instruction").get<string>();
-    int opcode  = getOpcode(mnem);
+uint32_t encodeIType(const json &j, int pcIdx, const AssemblerContext &ctx){
+    const string mnem = j.at("instruction").get<string>();
+    const isa::InstrDesc &d = getInstrDesc(mnem);
     int rs=0, rt=0; int16_t imm=0;
 
-    if (mnem=="li"){
-        opcode = getOpcode("addi");
-        rt = getRegisterCode(j.at("rt").get<string>());
-        rs = getRegisterCode("$zero");
-        imm = parseImmediate(j.at("immediate"));
-        return buildBinaryInstruction(opcode, rs, rt, 0, 0, 0, imm, 0);
-    }
-
-    if (mnem=="lw" || mnem=="sw"){
-        rt = getRegisterCode(j.at("rt").get<string>());
-        if (j.contains("addr")){
-            auto pr = parseOffsetBase(j.at("addr").get<string>());
-            imm = pr.first; rs = pr.second;
-        } else if (j.contains("baseReg")){
-            rs = getRegisterCode(j.at("baseReg").get<string>());
-            imm = j.contains("offset") ? parseImmediate(j.at("offset")) : 0;
-        } else if (j.contains("base")){
-            rs = getRegisterCode("$zero");
-            const string lbl = j.at("base").get<string>();
-            if (!dataMap.count(lbl)) throw runtime_error("Label de dados desconhecida: " + lbl);
-            imm = static_cast<int16_t>(dataMap[lbl] & 0xFFFF);
-        } else {
-            throw runtime_error("lw/sw precisam de 'addr' ou 'baseReg' ou 'base'");
-        }
-        return buildBinaryInstruction(opcode, rs, rt, 0, 0, 0, imm, 0);
-    }
+    switch (d.syntax){
+        case isa::Syntax::None:
+            return isa::encodeI(d, 0, 0, 0);
+
+        case isa::Syntax::Rt:
+            rt = j.contains("rt") ? getRegisterCode(j.at("rt").get<string>()) : 0;
+            return isa::encodeI(d, 0, rt, 0);
+
+        case isa::Syntax::RtImm: // li -> addi rt, $zero, imm
+            rt = getRegisterCode(j.at("rt").get<string>());
+            imm = parseImmediate(j.at("immediate"));
+            return isa::encodeI(d, 0, rt, imm);
+
+        case isa::Syntax::RtMem:
+        case isa::Syntax::VtMem:
+            rt = d.syntax == isa::Syntax::VtMem ? getVectorRegisterCode(j.at("rt").get<string>())
+                                                : getRegisterCode(j.at("rt").get<string>());
+            if (j.contains("addr")){
+                auto pr = parseOffsetBase(j.at("addr").get<string>());
+                imm = pr.first; rs = pr.second;
+            } else if (j.contains("baseReg")){
+                rs = getRegisterCode(j.at("baseReg").get<string>());
+                imm = j.contains("offset") ? parseImmediate(j.at("offset")) : 0;
+            } else if (j.contains("base")){
+                const string lbl = j.at("base").get<string>();
+                auto it = ctx.dataMap.find(lbl);
+                if (it == ctx.dataMap.end()) throw runtime_error("Label de dados desconhecida: " + lbl);
+                imm = static_cast<int16_t>(it->second & 0xFFFF);
+            } else {
+                throw runtime_error(mnem + " precisa de 'addr' ou 'baseReg' ou 'base'");
+            }
+            return isa::encodeI(d, rs, rt, imm);
+
+        case isa::Syntax::RsRtLabel:
+            rs = getRegisterCode(j.at("rs").get<string>());
+            rt = getRegisterCode(j.at("rt").get<string>());
+            if (j.contains("label")){
+                const string lbl = j.at("label").get<string>();
+                auto it = ctx.labelMap.find(lbl);
+                if (it == ctx.labelMap.end()) throw runtime_error("Label desconhecida: " + lbl);
+                imm = static_cast<int16_t>(it->second - (pcIdx + 1));
+            } else if (j.contains("offset")){
+                imm = parseImmediate(j.at("offset"));
+            } else {
+                throw runtime_error(mnem + " requer 'label' ou 'offset'");
+            }
+            return isa::encodeI(d, rs, rt, imm);
 
-    if (mnem=="beq" || mnem=="bne" || mnem=="bgt" || mnem=="blt"){
-        rs = getRegisterCode(j.at("rs").get<string>());
-        rt = getRegisterCode(j.at("rt").get<string>());
-        if (j.contains("label")){
-            const string lbl = j.at("label").get<string>();
-            if (!labelMap.count(lbl)) throw runtime_error("Label desconhecida: " + lbl);
-            imm = static_cast<int16_t>(labelMap[lbl] - (pcIdx + 1));
-        } else if (j.contains("offset")){
-            imm = parseImmediate(j.at("offset"));
-        } else {
-            throw runtime_error(mnem + " requer 'label' ou 'offset'");
-        }
-        return buildBinaryInstruction(opcode, rs, rt, 0, 0, 0, imm, 0);
+        default: // RtRsImm
+            rt  = getRegisterCode(j.at("rt").get<string>());
+            rs  = getRegisterCode(j.at("rs").get<string>());
+            imm = parseImmediate(j.at("immediate"));
+            return isa::encodeI(d, rs, rt, imm);
     }
-
-    rt  = getRegisterCode(j.at("rt").get<string>());
-    rs  = getRegisterCode(j.at("rs").get<string>());
-    imm = parseImmediate(j.at("immediate"));
-    return buildBinaryInstruction(opcode, rs, rt, 0, 0, 0, imm, 0);
 }
 
-uint32_t encodeJType(const json &j){
-    const string mnem = j.at("instruction").get<string>();
-    int opcode = getOpcode(mnem);
+uint32_t encodeJType(const json &j, const AssemblerContext &ctx){
+    const isa::InstrDesc &d = getInstrDesc(j.at("instruction").get<string>());
 
     if (j.contains("label")){
         const string lbl = j.at("label").get<string>();
-        if (!labelMap.count(lbl)) throw runtime_error("Label desconhecida (J): " + lbl);
-        int addr = labelMap[lbl] & 0x03FFFFFF;
-        return buildBinaryInstruction(opcode, 0,0,0,0,0, 0, addr);
+        auto it = ctx.labelMap.find(lbl);
+        if (it == ctx.labelMap.end()) throw runtime_error("Label desconhecida (J): " + lbl);
+        return isa::encodeJ(d, static_cast<uint32_t>(ctx.codeBase + it->second * 4));
     }
     if (j.contains("address")){
         uint32_t addr=0;
@@ -199,112 +237,139 @@ uint32_t encodeJType(const json &j){
         } else {
             addr = j["address"].get<uint32_t>();
         }
-        return buildBinaryInstruction(opcode, 0,0,0,0,0, 0, (addr & 0x03FFFFFF));
+        return isa::encodeJ(d, addr);
     }
     throw runtime_error("J-type requer 'label' ou 'address'");
 }
 
-uint32_t parseInstruction(const json &instrJson, int currentInstrIndex){
-    const string mnem = instrJson.at("instruction").get<string>();
-    if (mnem=="end" || mnem=="print")
-        return static_cast<uint32_t>(getOpcode(mnem)) << 26;
+uint32_t parseInstruction(const json &instrJson, int currentInstrIndex, const AssemblerContext &ctx){
+    const isa::InstrDesc &d = getInstrDesc(instrJson.at("instruction").get<string>());
+    switch (d.format){
+        case isa::Format::R:
+        case isa::Format::V: return encodeRType(instrJson);
+        case isa::Format::J: return encodeJType(instrJson, ctx);
+        default:             return encodeIType(instrJson, currentInstrIndex, ctx);
+    }
+}
 
-    if (functMap.count(mnem))              return encodeRType(instrJson);
-    if (mnem=="j" || mnem=="jal")          return encodeJType(instrJson);
-    return encodeIType(instrJson, currentInstrIndex);
+// ======= Seções (montam a imagem; a escrita na memória fica com writeProgramImage) =======
+static void emitWord(ProgramImage &image, int addr, uint32_t w){
+    size_t idx = static_cast<size_t>(addr - static_cast<int>(image.startAddr)) / 4;
+    if (idx >= image.words.size()) image.words.resize(idx + 1, 0);
+    image.words[idx] = w;
 }
 
-// ======= Seções (Alteradas para usar MemoryManager) =======
-int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int startAddr){
-    int addr = startAddr;
+static int dataWordValue(const json &v){
+    return v.is_string()? static_cast<int>(std::stoul(v.get<string>(),nullptr,0)) : v.get<int>();
+}
+
+static uint8_t dataByteValue(const json &v){
+    return v.is_string()? static_cast<uint8_t>(std::stoul(v.get<string>(),nullptr,0))
+                        : static_cast<uint8_t>(v.get<int>());
+}
+
+void DataWriter::label(const string &name){
+    if (!ctx.dataMap.emplace(name, addr).second) throw runtime_error("rótulo repetido: " + name);
+}
+void DataWriter::word(int w){ emitWord(image, addr, static_cast<uint32_t>(w)); addr += 4; }
+void DataWriter::byte(uint8_t b){ bytes.push_back(b); }
+
+void DataWriter::flushBytes(){
+    for (size_t i=0;i<bytes.size(); i+=4){
+        uint32_t w=0;
+        for (size_t j=0;j<4 && i+j<bytes.size(); ++j) w = (w<<8) | bytes[i+j];
+        word(static_cast<int>(w));
+    }
+    bytes.clear();
+}
+
+void DataWriter::item(const json &item){
+    string type = toLower(item.value("type","word"));
+    string lbl = item.value("label", string());
+    if (!lbl.empty()) label(lbl);
+
+    const json &value = item.at("value");
+    if (type=="word"){
+        flushBytes();
+        if (value.is_array()) for (auto &v : value) word(dataWordValue(v));
+        else word(dataWordValue(value));
+    } else if (type=="byte"){
+        if (value.is_array()) for (auto &v : value) byte(dataByteValue(v));
+        else byte(dataByteValue(value));
+    }
+}
+
+int parseData(const json &dataJson, ProgramImage &image, int startAddr, AssemblerContext &ctx){
+    DataWriter out{image, ctx, startAddr, {}};
 
     if (dataJson.is_object()){
         for (auto it = dataJson.begin(); it != dataJson.end(); ++it){
-            const string key = it.key();
-            const json& val  = it.value();
-            dataMap[key] = addr;
-            if (val.is_array()){
-                for (auto &e : val){
-                    int w = e.is_string()? static_cast<int>(std::stoul(e.get<string>(),nullptr,0))
-                                          : e.get<int>();
-                    memManager.write(addr, w, pcb); // Alterado aqui
-                    addr += 4;
-                }
-            } else {
-                int w = val.is_string()? static_cast<int>(std::stoul(val.get<string>(),nullptr,0))
-                                        : val.get<int>();
-                memManager.write(addr, w, pcb); // Alterado aqui
-                addr += 4;
-            }
+            const json& val = it.value();
+            out.label(it.key());
+            if (val.is_array()) for (auto &e : val) out.word(dataWordValue(e));
+            else out.word(dataWordValue(val));
         }
-        return addr;
+        return out.addr;
     }
 
     if (dataJson.is_array()){
-        vector<uint8_t> bytes;
-        auto flushBytes = [&](){
-            for (size_t i=0;i<bytes.size(); i+=4){
-                uint32_t w=0;
-                for (size_t j=0;j<4 && i+j<bytes.size(); ++j) w = (w<<8) | bytes[i+j];
-                memManager.write(addr, w, pcb); // Alterado aqui
-                addr += 4;
-            }
-            bytes.clear();
-        };
-        for (const auto &item : dataJson){
-            string type = toLower(item.value("type","word"));
-            string label = item.value("label", string());
-            if (!label.empty()) dataMap[label] = addr;
-
-            if (type=="word"){
-                flushBytes();
-                if (item["value"].is_array()){
-                    for (auto &v : item["value"]){
-                        int w = v.is_string()? static_cast<int>(std::stoul(v.get<string>(),nullptr,0))
-                                             : v.get<int>();
-                        memManager.write(addr, w, pcb); // Alterado aqui
-                        addr += 4;
-                    }
-                } else {
-                    int w = item["value"].is_string()? static_cast<int>(std::stoul(item["value"].get<string>(),nullptr,0))
-                                                      : item["value"].get<int>();
-                    memManager.write(addr, w, pcb); // Alterado aqui
-                    addr += 4;
-                }
-            } else if (type=="byte"){
-                if (item["value"].is_array()){
-                    for (auto &v : item["value"]){
-                        uint8_t b = v.is_string()? static_cast<uint8_t>(std::stoul(v.get<string>(),nullptr,0))
-                                                  : static_cast<uint8_t>(v.get<int>());
-                        bytes.push_back(b);
-                    }
-                } else {
-                    uint8_t b = item["value"].is_string()? static_cast<uint8_t>(std::stoul(item["value"].get<string>(),nullptr,0))
-                                                          : static_cast<uint8_t>(item["value"].get<int>());
-                    bytes.push_back(b);
-                }
-            }
-        }
-        flushBytes();
+        for (const auto &item : dataJson) out.item(item);
+        out.flushBytes();
     }
-    return addr;
+    return out.addr;
 }
 
-int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, int startAddr) {
+// Em j/jal/beq/bne/bgt/blt o campo "label" é o destino do salto; nos demais
+// nós ele define um rótulo na posição da instrução.
+static bool labelIsTarget(const json &node){
+    if (!node.contains("instruction")) return false;
+    const string mnem = toLower(node["instruction"].get<string>());
+    return mnem=="j" || mnem=="jal" || mnem=="beq" || mnem=="bne" || mnem=="bgt" || mnem=="blt";
+}
+
+static bool definesLabel(const json &node){
+    return node.contains("label") && !labelIsTarget(node);
+}
+
+// Um rótulo de código repetido é erro: os dois loaders resolveriam as
+// referências para definições diferentes
+static void defineCodeLabel(AssemblerContext &ctx, const json &node, int index){
+    const string name = node["label"].get<string>();
+    if (!ctx.labelMap.emplace(name, index).second) throw runtime_error("rótulo repetido: " + name);
+}
+
+// lw/sw (e vload/vstore) com "base" guardam o endereço absoluto do dado no imediato
+static bool usesDataAddress(const json &node){
+    const isa::InstrDesc &d = getInstrDesc(node["instruction"].get<string>());
+    return (d.syntax == isa::Syntax::RtMem || d.syntax == isa::Syntax::VtMem) &&
+           !node.contains("addr") && !node.contains("baseReg") && node.contains("base");
+}
+
+// j/jal com "label" guardam o endereço absoluto do alvo
+static bool usesCodeAddress(const json &node){
+    const string mnem = toLower(node["instruction"].get<string>());
+    return (mnem=="j" || mnem=="jal") && node.contains("label");
+}
+
+// Palavras com endereço absoluto: entram na lista de relocação da imagem
+static bool needsRelocation(const json &node){
+    return usesDataAddress(node) || usesCodeAddress(node);
+}
+
+int parseProgram(const json &programJson, ProgramImage &image, int startAddr, AssemblerContext &ctx) {
     if (!programJson.is_array()) {
         return startAddr;
     }
 
     int instruction_address_counter = 0;
     for (const auto &node : programJson) {
-        if (node.contains("label")) {
-            labelMap[node["label"].get<string>()] = instruction_address_counter;
-        }
+        if (definesLabel(node)) defineCodeLabel(ctx, node, instruction_address_counter);
         if (node.contains("instruction")) {
             instruction_address_counter++;
         }
     }
 
+    ctx.codeBase = startAddr;
     int current_mem_addr = startAddr;
     int current_instruction_addr = 0;
     for (const auto &node : programJson) {
@@ -312,9 +377,11 @@ int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, i
             continue;
         }
         
-        uint32_t binary_instruction = parseInstruction(node, current_instruction_addr);
+        uint32_t binary_instruction = parseInstruction(node, current_instruction_addr, ctx);
         
-        memManager.write(current_mem_addr, binary_instruction, pcb); // Alterado aqui
+        emitWord(image, current_mem_addr, binary_instruction);
+        if (needsRelocation(node))
+            image.relocations.push_back(static_cast<uint32_t>(current_mem_addr - static_cast<int>(image.startAddr)) / 4);
         
         current_mem_addr += 4;
         current_instruction_addr++;
@@ -323,20 +390,216 @@ int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, i
     return current_mem_addr;
 }
 
-// ======= Loader (Alterado para usar MemoryManager) =======
-static json readJsonFile(const string &filename){
+// ======= Loader streaming (SAX) =======
+// Percorre o JSON token a token, sem montar o documento inteiro. Só cada nó de
+// "program" (e cada item de "data" no formato em lista) vira um json pequeno,
+// descartado logo após ser codificado. Instruções que citam um rótulo ainda
+// não visto entram numa lista de backpatch e são codificadas no fim.
+// O layout final é idêntico ao do loader DOM: dados primeiro, depois o código,
+// e no formato objeto os rótulos de dados ficam em ordem de chave. Por isso a
+// seção "data" no formato objeto é a exceção: as palavras dela ficam guardadas
+// até o fim da seção e só então são escritas, ordenadas pelo rótulo.
+class ProgramStreamLoader : public nlohmann::json_sax<json> {
+public:
+    ProgramStreamLoader(int startAddr, AssemblerContext &context)
+        : ctx(context), dataOut{data, ctx, startAddr, {}}, dataEnd(startAddr) {
+        data.startAddr = static_cast<uint32_t>(startAddr);
+    }
+
+    bool null() override { return scalar(json(nullptr)); }
+    bool boolean(bool v) override { return scalar(json(v)); }
+    bool number_integer(number_integer_t v) override { return scalar(json(v)); }
+    bool number_unsigned(number_unsigned_t v) override { return scalar(json(v)); }
+    bool number_float(number_float_t v, const string_t &) override { return scalar(json(v)); }
+    bool string(string_t &v) override { return scalar(json(v)); }
+    bool binary(binary_t &v) override { return scalar(json(json::binary_t(v))); }
+
+    bool start_object(std::size_t) override { return open(json::object()); }
+    bool start_array(std::size_t) override { return open(json::array()); }
+    bool end_object() override { return close(); }
+    bool end_array() override { return close(); }
+
+    bool key(string_t &k) override {
+        if (!unitStack.empty()) { unitKey = k; return true; }
+        if (depth == 1) topKey = k;
+        else if (section == Section::DataObject && depth == 2) {
+            dataKey = k;
+            objectData[dataKey].clear();
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t pos, const std::string &, const nlohmann::detail::exception &ex) override {
+        throw runtime_error("JSON inválido na posição " + to_string(pos) + ": " + ex.what());
+    }
+
+    ProgramImage finish() {
+        ProgramImage image = std::move(data);
+        image.words.resize(static_cast<size_t>(dataEnd - static_cast<int>(image.startAddr)) / 4, 0);
+        image.codeOffset = static_cast<uint32_t>(image.words.size());
+
+        // Backpatch: agora todos os rótulos e o endereço do código são conhecidos
+        ctx.codeBase = static_cast<int>(image.entryAddr());
+        for (auto &p : pending) code[p.first] = parseInstruction(p.second, p.first, ctx);
+        pending.clear();
+
+        image.words.insert(image.words.end(), code.begin(), code.end());
+        for (uint32_t idx : relocations) image.relocations.push_back(image.codeOffset + idx);
+        return image;
+    }
+
+private:
+    enum class Section { None, Skip, DataObject, DataArray, Program };
+
+    AssemblerContext &ctx;
+    Section section = Section::None;
+    int depth = 0;
+    std::string topKey;
+
+    // Nó em construção (instrução ou item de dados)
+    json unit;
+    vector<json*> unitStack;
+    std::string unitKey;
+
+    // Seção de dados
+    ProgramImage data;
+    DataWriter dataOut;
+    int dataEnd;
+    std::map<std::string, vector<int>> objectData; // formato objeto: a seção inteira, em ordem de chave
+    std::string dataKey;
+
+    // Seção de código
+    vector<uint32_t> code;
+    vector<uint32_t> relocations; // índices em 'code'
+    vector<pair<int, json>> pending;
+
+    bool scalar(json v){
+        if (!unitStack.empty()) { put(std::move(v)); return true; }
+        if (section == Section::DataObject && (depth == 2 || depth == 3))
+            objectData[dataKey].push_back(dataWordValue(v));
+        return true;
+    }
+
+    bool open(json container){
+        if (!unitStack.empty()) {
+            put(std::move(container));
+            json *top = unitStack.back();
+            unitStack.push_back(top->is_array() ? &top->back() : &(*top)[unitKey]);
+        } else if (depth == 0) {
+            // raiz do documento
+        } else if (depth == 1) {
+            if (topKey == "data") section = container.is_object() ? Section::DataObject : Section::DataArray;
+            else if (topKey == "program" && container.is_array()) section = Section::Program;
+            else section = Section::Skip;
+        } else if (depth == 2 && (section == Section::DataArray || section == Section::Program)) {
+            unit = std::move(container);
+            unitStack.push_back(&unit);
+        } else if (section == Section::DataObject && (depth > 2 || !container.is_array())) {
+            throw runtime_error("Valor de dado inválido em '" + dataKey + "'");
+        }
+        depth++;
+        return true;
+    }
+
+    bool close(){
+        depth--;
+        if (!unitStack.empty()) {
+            unitStack.pop_back();
+            if (unitStack.empty()) {
+                if (section == Section::Program) programNode(std::move(unit));
+                else dataOut.item(unit);
+                unit = json();
+            }
+            return true;
+        }
+        if (depth == 1) endSection();
+        return true;
+    }
+
+    void put(json v){
+        json *top = unitStack.back();
+        if (top->is_array()) top->push_back(std::move(v));
+        else (*top)[unitKey] = std::move(v);
+    }
+
+    void endSection(){
+        if (section == Section::DataObject) {
+            for (auto &entry : objectData) {
+                dataOut.label(entry.first);
+                for (int w : entry.second) dataOut.word(w);
+            }
+            objectData.clear();
+        } else if (section == Section::DataArray) {
+            dataOut.flushBytes();
+        }
+        if (section == Section::DataObject || section == Section::DataArray) dataEnd = dataOut.addr;
+        section = Section::None;
+    }
+
+    // Algum símbolo citado pela instrução ainda não foi definido?
+    bool hasUnresolvedSymbol(const json &node) const {
+        // j/jal dependem do endereço do código, que só é fixado no fim
+        if (usesCodeAddress(node)) return true;
+        if (labelIsTarget(node) && node.contains("label"))
+            return !ctx.labelMap.count(node["label"].get<std::string>());
+        if (usesDataAddress(node))
+            return !ctx.dataMap.count(node["base"].get<std::string>());
+        return false;
+    }
+
+    void programNode(json node){
+        if (!node.is_object()) return;
+        const int index = static_cast<int>(code.size());
+        if (definesLabel(node)) defineCodeLabel(ctx, node, index);
+        if (!node.contains("instruction")) return;
+        if (needsRelocation(node)) relocations.push_back(static_cast<uint32_t>(index));
+
+        if (hasUnresolvedSymbol(node)) {
+            code.push_back(0);
+            pending.emplace_back(index, std::move(node));
+        } else {
+            code.push_back(parseInstruction(node, index, ctx));
+        }
+    }
+};
+
+// ======= Loader =======
+ProgramImage compileJsonDocument(const json &j, int startAddr){
+    AssemblerContext ctx;
+    ProgramImage image;
+    image.startAddr = static_cast<uint32_t>(startAddr);
+    int addr = startAddr;
+    if (j.contains("data"))    addr = parseData(j["data"], image, addr, ctx);
+    image.codeOffset = static_cast<uint32_t>(addr - startAddr) / 4;
+    if (j.contains("program")) addr = parseProgram(j["program"], image, addr, ctx);
+    image.words.resize(static_cast<size_t>(addr - startAddr) / 4, 0);
+    return image;
+}
+
+ProgramImage compileJsonProgram(const string &filename, int startAddr){
     ifstream f(filename);
     if (!f) throw runtime_error("Não foi possível abrir: " + filename);
-    json j; f >> j; return j;
+    AssemblerContext ctx;
+    ProgramStreamLoader loader(startAddr, ctx);
+    json::sax_parse(f, &loader);
+    return loader.finish();
 }
 
-int loadJsonProgram(const string &filename, MemoryManager &memManager, PCB& pcb, int startAddr){
-    dataMap.clear();
-    labelMap.clear();
+ProgramImage compileProgramCached(const string &filename, int startAddr){
+    // Programa inalterado (mesmo hash) -> reaproveita a imagem já montada
+    const uint64_t hash = hashProgramFile(filename);
+    const string cachePath = programCachePath(hash);
 
-    json j = readJsonFile(filename);
-    int addr = startAddr;
-    if (j.contains("data"))    addr = parseData(j["data"], memManager, pcb, addr);
-    if (j.contains("program")) addr = parseProgram(j["program"], memManager, pcb, addr);
-    return addr;
-}
\ No newline at end of file
+    ProgramImage image;
+    if (cachePath.empty() || !loadProgramImage(cachePath, image, hash)) {
+        image = isAsmFile(filename) ? compileAsmProgram(filename, 0) : compileJsonProgram(filename, 0);
+        if (!cachePath.empty()) saveProgramImage(cachePath, image, hash);
+    }
+    relocateProgramImage(image, static_cast<uint32_t>(startAddr));
+    return image;
+}
+
+int loadJsonProgram(const string &filename, MemoryManager &memManager, PCB& pcb, int startAddr){
+    ProgramImage image = compileProgramCached(filename, startAddr);
+    return writeProgramImage(image, memManager, pcb);
+}
@@ -2,27 +2,76 @@
 #include <cstdint>
 #include <string>
 #include <utility>
+#include <unordered_map>
+#include <vector>
 #include "../nlohmann/json.hpp"
 
 // Forward declarations para evitar inclusões circulares
 class MemoryManager;
 struct PCB;
+struct ProgramImage;
 
 using nlohmann::json;
 
+// Tabelas de símbolos de uma montagem. Cada carga de programa tem o seu próprio
+// contexto, então vários programas podem ser montados ao mesmo tempo (threads).
+struct AssemblerContext {
+    std::unordered_map<std::string, int> dataMap;  // rótulo de dado -> endereço
+    std::unordered_map<std::string, int> labelMap; // rótulo de código -> índice da instrução
+    int codeBase = 0;                              // endereço da primeira instrução (alvo de j/jal)
+};
+
+// Tabelas do codificador, geradas da tabela única de cpu/ISA.hpp e
+// compartilhadas com o montador de texto (parser_asm)
+extern const std::unordered_map<std::string, int> instructionMap;
+extern const std::unordered_map<std::string, int> functMap;
+extern const std::unordered_map<std::string, int> registerMap;
+extern const std::unordered_map<std::string, int> vectorRegisterMap; // $w0..$w7
+
+// Escreve a seção de dados palavra a palavra. Bytes consecutivos são empacotados
+// 4 a 4 (big-endian) e só viram palavra quando chega uma "word" ou no fim.
+struct DataWriter {
+    ProgramImage &image;
+    AssemblerContext &ctx;
+    int addr;
+    std::vector<uint8_t> bytes;
+
+    void label(const std::string &name); // runtime_error se o rótulo já existe
+    void word(int w);
+    void byte(uint8_t b);
+    void flushBytes();
+    // Item do formato em lista: { "type": "word"|"byte", "label": ..., "value": ... }
+    void item(const json &item);
+};
+
 // ===== API principal =====
-// Agora recebe MemoryManager e PCB para carregar o programa
+// Carrega o programa (JSON ou texto .s) na memória. Usa o cache de imagens (program_image.hpp):
+// se o JSON não mudou desde a última carga, pula parsing e codificação.
 int loadJsonProgram(const std::string &filename, MemoryManager &memManager, PCB& pcb, int startAddr);
 
+// Apenas monta a imagem binária, sem tocar na memória nem no cache.
+// Lê o arquivo em streaming (SAX): memória proporcional à imagem, não ao JSON.
+// "data" no formato objeto é guardado inteiro (só as palavras) até o fim da
+// seção, para sair em ordem de rótulo; o formato em lista vai direto à imagem.
+// Reentrante: pode ser chamada de várias threads ao mesmo tempo (o MemoryManager
+// não é, então a escrita das imagens na memória deve ser feita por uma só thread).
+ProgramImage compileJsonProgram(const std::string &filename, int startAddr);
+// Mesma montagem a partir de um documento já carregado (DOM).
+ProgramImage compileJsonDocument(const json &j, int startAddr);
+// Montagem via cache de imagens (também reentrante). É o que loadJsonProgram usa.
+// Arquivos .s/.asm passam pelo montador de texto (parser_asm.hpp), os demais pelo JSON.
+ProgramImage compileProgramCached(const std::string &filename, int startAddr);
+
 // ===== Parsers de seção =====
-int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int startAddr);
-int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, int startAddr);
+int parseData(const json &dataJson, ProgramImage &image, int startAddr, AssemblerContext &ctx);
+int parseProgram(const json &programJson, ProgramImage &image, int startAddr, AssemblerContext &ctx);
 
 // ===== Parser de instrução =====
-uint32_t parseInstruction(const json &instrJson, int currentInstrIndex);
+uint32_t parseInstruction(const json &instrJson, int currentInstrIndex, const AssemblerContext &ctx);
 
 // ===== Helpers / Encoders =====
 int     getRegisterCode(const std::string &reg);
+int     getVectorRegisterCode(const std::string &reg);
 int     getOpcode(const std::string &instr);
 int     getFunct(const std::string &instr);
 
@@ -30,8 +79,8 @@ uint32_t buildBinaryInstruction(int opcode, int rs, int rt, int rd, int shamt, i
                                 int immediate, int address);
 
 uint32_t encodeRType(const nlohmann::json &instrJson);
-uint32_t encodeIType(const nlohmann::json &instrJson, int currentInstrIndex);
-uint32_t encodeJType(const nlohmann::json &instrJson);
+uint32_t encodeIType(const nlohmann::json &instrJson, int currentInstrIndex, const AssemblerContext &ctx);
+uint32_t encodeJType(const nlohmann::json &instrJson, const AssemblerContext &ctx);
 
 // ===== Utils =====
 std::pair<int16_t,int> parseOffsetBase(const std::string &addrExpr);
@@ -0,0 +1,164 @@
+#include "program_image.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../cpu/PCB.hpp"
+#include "../cpu/ISA.hpp"
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <stdexcept>
+
+using namespace std;
+
+static const char IMAGE_MAGIC[4] = {'V', 'N', 'P', 'I'};
+
+static mutex cacheDirLock;
+static string cacheDir = ".program_cache";
+
+// ======= Relocação =======
+// j/jal: o alvo ocupa os 26 bits do campo. lw/sw: o endereço do dado fica no
+// imediato de 16 bits, que os núcleos estendem com sinal, então só alcança
+// até 0x7FFF. Um endereço que não cabe é erro, nunca truncado.
+void relocateProgramImage(ProgramImage &image, uint32_t newStartAddr){
+    const int64_t delta = int64_t(newStartAddr) - int64_t(image.startAddr);
+    vector<uint32_t> words = image.words;
+    for (uint32_t idx : image.relocations){
+        uint32_t &w = words.at(idx);
+        const isa::InstrDesc *d = isa::decode(w);
+        const bool jump = d && d->format == isa::Format::J;
+        const uint32_t mask = jump ? 0x03FFFFFFu : 0xFFFFu;
+        const int64_t limit = jump ? 0x03FFFFFF : 0x7FFF;
+        const int64_t addr = int64_t(w & mask) + delta;
+        if (addr < 0 || addr > limit)
+            throw out_of_range("Relocação para a base " + to_string(newStartAddr) + " leva o endereço " +
+                               to_string(addr) + " além do alcance de " + (jump ? "j/jal" : "lw/sw (0x7FFF)"));
+        w = (w & ~mask) | static_cast<uint32_t>(addr);
+    }
+    image.words = std::move(words);
+    image.startAddr = newStartAddr;
+}
+
+// ======= Serialização =======
+bool saveProgramImage(const string &path, const ProgramImage &image, uint64_t sourceHash){
+    namespace fs = std::filesystem;
+    error_code ec;
+    fs::path target(path);
+    if (target.has_parent_path()) fs::create_directories(target.parent_path(), ec);
+
+    // Escreve num temporário e renomeia: leitores concorrentes nunca veem uma imagem pela metade
+    fs::path tmp = target;
+    tmp += ".tmp" + to_string(hash<thread::id>{}(this_thread::get_id()))
+         + "_" + to_string(chrono::steady_clock::now().time_since_epoch().count());
+    {
+        ofstream out(tmp, ios::binary | ios::trunc);
+        if (!out) return false;
+        uint32_t version = PROGRAM_IMAGE_VERSION;
+        uint32_t count = static_cast<uint32_t>(image.words.size());
+        uint32_t relocCount = static_cast<uint32_t>(image.relocations.size());
+        out.write(IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&sourceHash), sizeof(sourceHash));
+        out.write(reinterpret_cast<const char*>(&image.startAddr), sizeof(image.startAddr));
+        out.write(reinterpret_cast<const char*>(&image.codeOffset), sizeof(image.codeOffset));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(image.words.data()), count * sizeof(uint32_t));
+        out.write(reinterpret_cast<const char*>(&relocCount), sizeof(relocCount));
+        out.write(reinterpret_cast<const char*>(image.relocations.data()), relocCount * sizeof(uint32_t));
+        if (!out) { out.close(); fs::remove(tmp, ec); return false; }
+    }
+    fs::rename(tmp, target, ec);
+    if (ec) { fs::remove(tmp, ec); return false; }
+    return true;
+}
+
+bool loadProgramImage(const string &path, ProgramImage &image, uint64_t expectedHash){
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    uint32_t version = 0, startAddr = 0, codeOffset = 0, count = 0, relocCount = 0;
+    uint64_t hash = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+    in.read(reinterpret_cast<char*>(&startAddr), sizeof(startAddr));
+    in.read(reinterpret_cast<char*>(&codeOffset), sizeof(codeOffset));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || !equal(begin(magic), end(magic), IMAGE_MAGIC)) return false;
+    if (version != PROGRAM_IMAGE_VERSION || hash != expectedHash) return false;
+
+    // Tamanhos e índices vêm do arquivo: uma imagem corrompida não pode
+    // alocar além do que o arquivo tem nem apontar para fora das palavras
+    const streamoff header = in.tellg();
+    in.seekg(0, ios::end);
+    const uint64_t remaining = static_cast<uint64_t>(in.tellg() - header);
+    in.seekg(header);
+    const uint64_t wordBytes = uint64_t(count) * sizeof(uint32_t);
+    if (!in || wordBytes + sizeof(relocCount) > remaining || codeOffset > count) return false;
+
+    vector<uint32_t> words(count);
+    in.read(reinterpret_cast<char*>(words.data()), count * sizeof(uint32_t));
+    in.read(reinterpret_cast<char*>(&relocCount), sizeof(relocCount));
+    if (!in || uint64_t(relocCount) * sizeof(uint32_t) != remaining - wordBytes - sizeof(relocCount)) return false;
+    vector<uint32_t> relocations(relocCount);
+    in.read(reinterpret_cast<char*>(relocations.data()), relocCount * sizeof(uint32_t));
+    if (!in) return false;
+    for (uint32_t idx : relocations)
+        if (idx >= count) return false;
+
+    image.startAddr = startAddr;
+    image.codeOffset = codeOffset;
+    image.words = std::move(words);
+    image.relocations = std::move(relocations);
+    return true;
+}
+
+int writeProgramImage(const ProgramImage &image, MemoryManager &memManager, PCB &pcb){
+    uint32_t addr = image.startAddr;
+    for (uint32_t w : image.words){
+        memManager.write(addr, w, pcb);
+        addr += 4;
+    }
+    return static_cast<int>(addr);
+}
+
+// ======= Cache em disco =======
+uint64_t hashProgramFile(const string &filename){
+    ifstream f(filename, ios::binary);
+    if (!f) throw runtime_error("Não foi possível abrir: " + filename);
+
+    uint64_t h = 1469598103934665603ULL; // FNV-1a offset basis
+    auto mix = [&h](const unsigned char *p, size_t n){
+        for (size_t i = 0; i < n; ++i){ h ^= p[i]; h *= 1099511628211ULL; }
+    };
+    uint32_t version = PROGRAM_IMAGE_VERSION;
+    mix(reinterpret_cast<const unsigned char*>(&version), sizeof(version));
+
+    char buf[64 * 1024];
+    while (f.read(buf, sizeof(buf)) || f.gcount() > 0){
+        mix(reinterpret_cast<const unsigned char*>(buf), static_cast<size_t>(f.gcount()));
+    }
+    return h;
+}
+
+void setProgramCacheDir(const string &dir){
+    lock_guard<mutex> lock(cacheDirLock);
+    cacheDir = dir;
+}
+
+string programCacheDir(){
+    lock_guard<mutex> lock(cacheDirLock);
+    return cacheDir;
+}
+
+string programCachePath(uint64_t sourceHash){
+    string dir = programCacheDir();
+    if (dir.empty()) return string();
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx.img", static_cast<unsigned long long>(sourceHash));
+    return (std::filesystem::path(dir) / name).string();
+}
@@ -0,0 +1,64 @@
+#pragma once
+/*
+  program_image.hpp
+  Imagem binária de um programa já montado (seção de dados + seção de código)
+  e cache em disco dessas imagens, indexada pelo hash do JSON de origem.
+
+  Uma imagem é apenas a sequência de palavras que o parser escreveria na
+  memória a partir de startAddr (uma palavra a cada 4 endereços). Carregar uma
+  imagem do cache reproduz exatamente as mesmas escritas no MemoryManager, sem
+  reler nem remontar o JSON.
+*/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MemoryManager;
+struct PCB;
+
+// Incrementar sempre que a codificação das instruções ou o layout da imagem
+// mudar: imagens antigas no cache passam a ser ignoradas automaticamente.
+constexpr uint32_t PROGRAM_IMAGE_VERSION = 4;
+
+struct ProgramImage {
+    uint32_t startAddr = 0;
+    std::vector<uint32_t> words; // palavra i fica no endereço startAddr + 4*i
+    uint32_t codeOffset = 0;     // índice da primeira instrução (após a seção de dados)
+
+    // Palavras que guardam um endereço absoluto (lw/sw com "base", no
+    // imediato de 16 bits; j/jal com rótulo, no alvo de 26 bits): precisam
+    // ser ajustadas quando a imagem muda de endereço base.
+    std::vector<uint32_t> relocations;
+
+    uint32_t endAddr() const { return startAddr + static_cast<uint32_t>(words.size()) * 4; }
+    uint32_t entryAddr() const { return startAddr + codeOffset * 4; }
+};
+
+// Move a imagem para outro endereço base, corrigindo as relocações.
+// out_of_range se um endereço relocado não couber no campo (dados de lw/sw
+// acima de 0x7FFF, alvo de j/jal acima de 26 bits); a imagem fica como estava.
+void relocateProgramImage(ProgramImage &image, uint32_t newStartAddr);
+
+// ===== Serialização =====
+// Formato (host endian): "VNPI" | versão u32 | hash u64 | startAddr u32 | codeOffset u32
+//                        | n u32 | n x u32 | r u32 | r x u32 (relocações)
+bool saveProgramImage(const std::string &path, const ProgramImage &image, uint64_t sourceHash);
+// false se o arquivo faltar, for de outra versão/hash ou estiver inconsistente
+// (tamanhos maiores que o arquivo, codeOffset ou relocação fora das palavras)
+bool loadProgramImage(const std::string &path, ProgramImage &image, uint64_t expectedHash);
+
+// Escreve a imagem na memória (contabilizando no PCB, como o parser faz) e
+// retorna o primeiro endereço livre após ela.
+int writeProgramImage(const ProgramImage &image, MemoryManager &memManager, PCB &pcb);
+
+// ===== Cache em disco =====
+// Hash FNV-1a (64 bits) do conteúdo do arquivo, combinado com PROGRAM_IMAGE_VERSION.
+uint64_t hashProgramFile(const std::string &filename);
+
+// Diretório do cache de imagens. String vazia desativa o cache.
+void setProgramCacheDir(const std::string &dir);
+std::string programCacheDir();
+
+// Caminho da imagem para o hash ou "" se o cache estiver desativado. As imagens
+// são guardadas na base 0 e relocadas na carga, então servem para qualquer base.
+std::string programCachePath(uint64_t sourceHash);
@@ -0,0 +1,57 @@
+# tasks.s
+# Mesmo programa de tasks.json em texto (montado por parser_asm).
+# Os dados seguem a ordem de chave do JSON, então a imagem é idêntica.
+
+        .data
+counter: .word 10
+flag:    .word 0
+matrixA: .word 1, 2, 3, 4
+matrixB: .word 5, 6, 7, 8
+numbers: .word 5, 10, 15, 20
+output:  .word 0, 0, 0, 0, 0
+result:  .word 0, 0, 0, 0
+x:       .word 15
+y:       .word 25
+z:       .word 0
+
+        .text
+start:  li    $t0, 100
+        addi  $t1, $zero, 5
+        add   $t2, $t0, $t1
+        sub   $t3, $t0, $t1
+        and   $t4, $t0, $t1
+        or    $t5, $t0, $t1
+        mult  $t6, $t1, $t1
+        div   $t7, $t0, $t1
+
+        lw    $s0, x
+        lw    $s1, y
+        add   $s2, $s0, $s1
+        sw    $s2, z
+
+        lw    $s3, numbers
+        addi  $s3, $s3, 10
+        sw    $s3, result
+
+loop:   lw    $t8, counter
+        beq   $t8, $zero, end_loop
+        addi  $t8, $t8, -1
+        sw    $t8, counter
+        j     loop
+end_loop:
+        print $t8
+
+        bgt   $t0, $t1, greater_case
+        blt   $t0, $t1, less_case
+
+greater_case:
+        li    $a0, 111
+        j     after_compare
+
+less_case:
+        li    $a0, 222
+
+after_compare:
+        print $a0
+
+end:    end
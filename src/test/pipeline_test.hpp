@@ -0,0 +1,121 @@
+#ifndef PIPELINE_TEST_HPP
+#define PIPELINE_TEST_HPP
+/*
+  pipeline_test.hpp
+  Apoio comum aos testes do pipeline de Core() (hazards, unidades
+  funcionais, emissão múltipla, store buffer, macro-fusão): verifica(), uma
+  execução completa de um programa em assembly com uma PipelineConfig e a
+  comparação com o núcleo rápido, inteira e em fatias curtas.
+*/
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpu/PCB.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+inline int falhas = 0;
+
+inline void verifica(bool ok, const std::string &descricao){
+    std::cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+// Estado final e contadores de uma execução (cada teste olha os seus)
+struct Resultado {
+    uint64_t ciclos = 0, instrucoes = 0;
+    uint64_t raw = 0, loadUse = 0, estrutural = 0, exEx = 0, memEx = 0;  // hazards
+    uint64_t latencia = 0, ocupada = 0;                                  // unidades funcionais
+    uint64_t dependencia = 0, separacaoEstrutural = 0;                   // emissão múltipla
+    std::vector<uint64_t> emitidas;
+    uint64_t adiantados = 0, cheio = 0;                                  // store buffer
+    uint64_t pares = 0;                                                  // macro-fusão
+    std::vector<uint32_t> regs;   // $t0..$t7, $s0..$s7, hi, lo
+    std::vector<uint32_t> dados;  // primeiras 8 palavras de .data
+    uint32_t dado = 0;            // dados[0]
+    std::vector<std::string> saida;
+};
+
+// Roda 'fonte' até o fim em fatias de 'quantum', em Core() com 'config' ou
+// no núcleo rápido
+inline Resultado roda(const char *fonte, const PipelineConfig &config, int quantum = 100000, bool rapido = false){
+    MemoryManager mem(4096, 8192);
+    PCB pcb;
+    pcb.quantum = quantum;
+    ProgramImage img = compileAsmSource(fonte, 0);
+    writeProgramImage(img, mem, pcb);
+    pcb.regBank.pc.write(img.entryAddr());
+
+    setPipelineConfig(config);
+    Resultado r;
+    QuietCore quiet;
+    bool printLock = false;
+    for (int fatia = 0; fatia < 100000 && pcb.state != State::Finished; ++fatia) {
+        std::vector<std::unique_ptr<IORequest>> io;
+        if (rapido) FastCore(mem, pcb, &io, printLock);
+        else Core(mem, pcb, &io, printLock);
+        for (const auto &req : io) r.saida.push_back(req->msg);
+    }
+    setPipelineConfig(PipelineConfig{});
+
+    r.ciclos = pcb.pipeline_cycles.load();
+    r.instrucoes = pcb.instructions_retired.load();
+    r.raw = pcb.stall_raw_cycles.load();
+    r.loadUse = pcb.stall_load_use_cycles.load();
+    r.estrutural = pcb.stall_structural_cycles.load();
+    r.exEx = pcb.forwards_ex_ex.load();
+    r.memEx = pcb.forwards_mem_ex.load();
+    r.latencia = pcb.stall_fu_latency_cycles.load();
+    r.ocupada = pcb.stall_fu_busy_cycles.load();
+    r.dependencia = pcb.issue_split_dependency.load();
+    r.separacaoEstrutural = pcb.issue_split_structural.load();
+    r.emitidas = pcb.issue_width_cycles;
+    r.adiantados = pcb.loads_forwarded.load();
+    r.cheio = pcb.store_buffer_full_stalls.load();
+    r.pares = pcb.fused_pairs.load();
+    const hw::REGISTER_BANK &b = pcb.regBank;
+    for (const REGISTER *reg : {&b.t0, &b.t1, &b.t2, &b.t3, &b.t4, &b.t5, &b.t6, &b.t7,
+                                &b.s0, &b.s1, &b.s2, &b.s3, &b.s4, &b.s5, &b.s6, &b.s7, &b.hi, &b.lo})
+        r.regs.push_back(reg->value);
+    for (uint32_t addr = 0; addr < 32; addr += 4) r.dados.push_back(mem.peek(addr));
+    r.dado = r.dados[0];
+    return r;
+}
+
+struct Equivalencia {
+    Resultado rapido;          // o núcleo rápido, a referência
+    bool iguais = true;        // cada config, inteira: mesmo estado e mesmas instruções
+    bool fatiasIguais = true;  // cada config em fatias de 1, 2, 3, 5 e 7
+};
+
+// O modelo de tempo não muda o estado arquitetural: 'fonte' em cada uma das
+// 'configs', inteira e em fatias curtas (instruções paradas no esvaziamento
+// não se perdem), termina com os mesmos registradores, memória, saída e
+// instruções do núcleo rápido. 'cadaExecucao' vê a execução inteira de cada
+// config.
+inline Equivalencia comparaComRapido(const char *fonte, const std::vector<PipelineConfig> &configs,
+                                     const std::function<void(const Resultado &)> &cadaExecucao = {}){
+    Equivalencia e;
+    e.rapido = roda(fonte, PipelineConfig{}, 100000, true);
+    const auto mesmoEstado = [&e](const Resultado &r) {
+        return r.regs == e.rapido.regs && r.dados == e.rapido.dados && r.saida == e.rapido.saida &&
+               r.instrucoes == e.rapido.instrucoes;
+    };
+    for (const PipelineConfig &c : configs) {
+        const Resultado inteiro = roda(fonte, c);
+        e.iguais = e.iguais && mesmoEstado(inteiro);
+        if (cadaExecucao) cadaExecucao(inteiro);
+        for (int quantum : {1, 2, 3, 5, 7})
+            e.fatiasIguais = e.fatiasIguais && mesmoEstado(roda(fonte, c, quantum));
+    }
+    return e;
+}
+
+#endif // PIPELINE_TEST_HPP
@@ -0,0 +1,285 @@
+/*
+  test_atomics.cpp
+  Testes de ll/sc e das atômicas (amoswap, amoadd): montagem, as reservas do
+  MemoryManager (uma escrita de outro processo derruba o sc), o mesmo
+  resultado nos quatro núcleos e com processos alternando em fatias, e o
+  custo da contenção com 1, 2 e 4 contextos de hardware: trava (spinlock com
+  ll/sc) contra contador sem trava (ll/sc e amoadd).
+*/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <string>
+#include <stdexcept>
+
+#include "cpu/PCB.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "cpu/OOO_CORE.hpp"
+#include "cpu/SMT_CORE.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_json.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+// Palavras compartilhadas pelos processos (fora das imagens dos programas)
+static constexpr uint32_t TRAVA = 900;
+static constexpr uint32_t CONTADOR = 904;
+
+void encodingTest(){
+    cout << "\n=== Encoding Test ===\n";
+    ProgramImage texto = compileAsmSource(R"(
+        .text
+        ll      $t1, 4($t0)
+        sc      $t1, 4($t0)
+        amoswap $t2, 0($s0)
+        amoadd  $t3, -8($sp)
+        end
+    )", 0);
+    ProgramImage dom = compileJsonDocument(json::parse(R"J({
+        "program": [
+          { "instruction": "ll", "rt": "$t1", "addr": "4($t0)" },
+          { "instruction": "sc", "rt": "$t1", "addr": "4($t0)" },
+          { "instruction": "amoswap", "rt": "$t2", "addr": "0($s0)" },
+          { "instruction": "amoadd", "rt": "$t3", "addr": "-8($sp)" },
+          { "instruction": "end" }
+        ] })J"), 0);
+    verifica(texto.words == dom.words, "montador de texto == JSON");
+
+    const vector<string> esperado = {"ll $t1, 4($t0)", "sc $t1, 4($t0)", "amoswap $t2, 0($s0)", "amoadd $t3, -8($sp)"};
+    bool ida = true;
+    for (size_t i = 0; i < esperado.size(); ++i)
+        ida = ida && isa::disassemble(texto.words[i]) == esperado[i] && isa::isAtomic(isa::decode(texto.words[i])->op);
+    verifica(ida, "disassemble devolve o texto montado");
+
+    const isa::RegisterUse ll = isa::registerUse(*isa::decode(texto.words[0]), texto.words[0]);
+    const isa::RegisterUse sc = isa::registerUse(*isa::decode(texto.words[1]), texto.words[1]);
+    verifica(ll.src1 == 8 && ll.src2 == 0 && ll.dst == 9 && sc.src1 == 8 && sc.src2 == 9 && sc.dst == 9,
+             "ll le a base; sc le e escreve rt");
+}
+
+void reservationTest(){
+    cout << "\n=== Reservation Test ===\n";
+    MemoryManager mem(4096, 8192);
+    PCB a, b;
+    mem.poke(CONTADOR, 10);
+
+    verifica(mem.atomic(isa::Op::LL, CONTADOR, 0, a, &a) == 10 && mem.reserved(a, CONTADOR), "ll le e reserva");
+    verifica(mem.atomic(isa::Op::SC, CONTADOR, 11, a, &a) == 1 && mem.peek(CONTADOR) == 11 && !mem.reserved(a, CONTADOR),
+             "sc com a reserva escreve e a consome");
+    verifica(mem.atomic(isa::Op::SC, CONTADOR, 12, a, &a) == 0 && mem.peek(CONTADOR) == 11, "sc sem ll falha");
+
+    mem.atomic(isa::Op::LL, CONTADOR, 0, a, &a);
+    mem.write(CONTADOR, 20, b);
+    verifica(!mem.reserved(a, CONTADOR) && mem.atomic(isa::Op::SC, CONTADOR, 21, a, &a) == 0 &&
+             mem.peek(CONTADOR) == 20, "escrita de outro processo derruba a reserva");
+
+    mem.atomic(isa::Op::LL, CONTADOR, 0, a, &a);
+    mem.atomic(isa::Op::LL, CONTADOR, 0, b, &b);
+    const uint32_t scB = mem.atomic(isa::Op::SC, CONTADOR, 30, b, &b);
+    const uint32_t scA = mem.atomic(isa::Op::SC, CONTADOR, 40, a, &a);
+    verifica(scB == 1 && scA == 0 && mem.peek(CONTADOR) == 30, "dois ll: so o primeiro sc ganha");
+
+    mem.atomic(isa::Op::LL, CONTADOR, 0, a, &a);
+    mem.poke(CONTADOR + 4, 1);
+    verifica(mem.reserved(a, CONTADOR), "escrita em outra palavra nao derruba");
+    mem.poke(CONTADOR, 31);
+    verifica(!mem.reserved(a, CONTADOR), "poke tambem derruba");
+
+    PCB c;
+    mem.poke(TRAVA, 0);
+    verifica(mem.atomic(isa::Op::AMOSWAP, TRAVA, 1, c, &c) == 0 && mem.peek(TRAVA) == 1 && c.spin_iterations == 0,
+             "amoswap devolve o antigo e escreve");
+    verifica(mem.atomic(isa::Op::AMOSWAP, TRAVA, 1, c, &c) == 1 && c.spin_iterations == 1, "amoswap sem mudanca e spin");
+    verifica(mem.atomic(isa::Op::AMOADD, CONTADOR, 5, c, &c) == 31 && mem.peek(CONTADOR) == 36, "amoadd soma e devolve o antigo");
+
+    PCB d;
+    mem.atomic(isa::Op::LL, TRAVA, 0, d, &d);
+    mem.atomic(isa::Op::LL, TRAVA, 0, d, &d);
+    verifica(d.spin_iterations == 1 && d.atomic_operations == 2, "ll repetido sem sc e spin");
+    verifica(a.sc_failures == 3 && a.spin_iterations == 3, "contadores de sc falhos por processo");
+
+    PCB e;
+    const uint64_t antes = e.mem_accesses_total.load();
+    mem.atomic(isa::Op::AMOADD, CONTADOR, 1, e, nullptr);
+    verifica(e.mem_accesses_total.load() == antes && mem.peek(CONTADOR) == 37, "sem metricas: so funcional");
+}
+
+// Cada processo soma 1 ao CONTADOR 'vezes' vezes. Os três jeitos:
+//   trava  : spinlock com ll/sc na TRAVA, lw/addi/sw no contador, sw libera
+//   llsc   : ll/addi/sc no próprio contador, repete se o sc falhar
+//   amoadd : uma atômica por incremento
+enum class Modo { Trava, LlSc, AmoAdd };
+
+static const char *nome(Modo m){
+    return m == Modo::Trava ? "trava (ll/sc)" : m == Modo::LlSc ? "sem trava (ll/sc)" : "sem trava (amoadd)";
+}
+
+static string programa(Modo modo, int vezes){
+    string corpo;
+    switch (modo) {
+        case Modo::Trava:
+            corpo = R"(
+pega:   ll   $t1, 0($t0)
+        bne  $t1, $zero, pega
+        li   $t1, 1
+        sc   $t1, 0($t0)
+        beq  $t1, $zero, pega
+        lw   $t2, 4($t0)
+        addi $t2, $t2, 1
+        sw   $t2, 4($t0)
+        sw   $zero, 0($t0)
+)";
+            break;
+        case Modo::LlSc:
+            corpo = R"(
+tenta:  ll   $t1, 4($t0)
+        addi $t1, $t1, 1
+        sc   $t1, 4($t0)
+        beq  $t1, $zero, tenta
+)";
+            break;
+        case Modo::AmoAdd:
+            corpo = R"(
+        li   $t1, 1
+        amoadd $t1, 4($t0)
+)";
+            break;
+    }
+    return "        .text\n        li   $t0, " + to_string(TRAVA) + "\n        li   $s0, 0\n        li   $s1, " +
+           to_string(vezes) + "\nlaco:" + corpo + "        addi $s0, $s0, 1\n        bne  $s0, $s1, laco\n        end\n";
+}
+
+struct Maquina {
+    MemoryManager mem{4096, 8192};
+    vector<unique_ptr<PCB>> processos;
+
+    Maquina(){
+        mem.poke(TRAVA, 0);
+        mem.poke(CONTADOR, 0);
+    }
+
+    void carrega(const string &fonte, int n){
+        for (int i = 0; i < n; ++i) {
+            auto pcb = make_unique<PCB>();
+            pcb->pid = i + 1;
+            pcb->quantum = 7;
+            ProgramImage img = compileAsmSource(fonte, 100 * i);
+            writeProgramImage(img, mem, *pcb);
+            pcb->regBank.pc.write(img.entryAddr());
+            processos.push_back(move(pcb));
+        }
+    }
+
+    vector<PCB*> todos() const {
+        vector<PCB*> v;
+        for (const auto &p : processos) v.push_back(p.get());
+        return v;
+    }
+
+    uint64_t soma(std::atomic<uint64_t> PCB::*contador) const {
+        uint64_t total = 0;
+        for (const auto &p : processos) total += ((*p).*contador).load();
+        return total;
+    }
+};
+
+// Processos alternando em fatias curtas (quantum 7) num núcleo de uma vez,
+// como o escalonador: a trava pode ficar com quem perdeu a vez
+void slicingTest(){
+    cout << "\n=== Time-Slicing Test ===\n";
+    for (CoreFunction core : {&Core, &FastCore, &OooCore}) {
+        bool certo = true;
+        for (Modo modo : {Modo::Trava, Modo::LlSc, Modo::AmoAdd}) {
+            Maquina m;
+            m.carrega(programa(modo, 12), 3);
+            QuietCore quiet;
+            bool printLock = false;
+            for (int volta = 0; volta < 10000; ++volta) {
+                bool algum = false;
+                for (auto &p : m.processos) {
+                    if (p->state == State::Finished) continue;
+                    vector<unique_ptr<IORequest>> io;
+                    core(m.mem, *p, &io, printLock);
+                    algum = true;
+                }
+                if (!algum) break;
+            }
+            certo = certo && m.mem.peek(CONTADOR) == 36 && m.mem.peek(TRAVA) == 0 &&
+                    m.soma(&PCB::atomic_operations) > 0;
+        }
+        verifica(certo, string(core == &Core ? "pipeline" : core == &FastCore ? "rapido" : "fora de ordem") +
+                        ": 3 processos x 12 incrementos == 36 nos tres modos");
+    }
+}
+
+struct Medida {
+    uint64_t ciclos = 0, scFalhos = 0, spins = 0;
+    uint32_t contador = 0;
+};
+
+static Medida mede(Modo modo, int contextos, int vezes){
+    Maquina m;
+    m.carrega(programa(modo, vezes), contextos);
+    const SmtReport r = run_smt(m.mem, m.todos());
+    Medida x;
+    x.ciclos = r.cycles;
+    for (const SmtThreadStats &t : r.threads) {
+        x.scFalhos += t.scFailures;
+        x.spins += t.spinIterations;
+    }
+    x.contador = m.mem.peek(CONTADOR);
+    return x;
+}
+
+void contentionTest(){
+    cout << "\n=== Contention Benchmark (contextos intercalados) ===\n";
+    const int VEZES = 20;
+    cout << "  " << left << setw(20) << "modo" << right << setw(10) << "contextos" << setw(10) << "ciclos"
+         << setw(14) << "ciclos/incr" << setw(10) << "sc falhos" << setw(8) << "spins" << "\n";
+
+    Medida r[3][3];
+    const int contextos[3] = {1, 2, 4};
+    bool somas = true;
+    for (int mo = 0; mo < 3; ++mo) {
+        for (int k = 0; k < 3; ++k) {
+            const Modo modo = static_cast<Modo>(mo);
+            r[mo][k] = mede(modo, contextos[k], VEZES);
+            const Medida &x = r[mo][k];
+            somas = somas && x.contador == uint32_t(contextos[k] * VEZES);
+            cout << "  " << left << setw(20) << nome(modo) << right << setw(10) << contextos[k] << setw(10) << x.ciclos
+                 << setw(14) << fixed << setprecision(2) << double(x.ciclos) / (contextos[k] * VEZES)
+                 << setw(10) << x.scFalhos << setw(8) << x.spins << "\n";
+        }
+    }
+    const int T = 0, L = 1, A = 2;
+    verifica(somas, "contador final == contextos x incrementos em todos os modos");
+    verifica(r[T][0].spins == 0 && r[T][0].scFalhos == 0 && r[L][0].scFalhos == 0, "um contexto: sem contencao");
+    verifica(r[T][2].spins > r[T][1].spins && r[T][1].spins > 0, "trava: spins crescem com os contextos");
+    verifica(r[L][2].scFalhos > 0, "ll/sc sem trava: sc falha com 4 contextos");
+    verifica(r[A][0].spins + r[A][1].spins + r[A][2].spins == 0 &&
+             r[A][0].scFalhos + r[A][1].scFalhos + r[A][2].scFalhos == 0, "amoadd: nunca espera");
+    verifica(r[A][2].ciclos < r[L][2].ciclos && r[L][2].ciclos < r[T][2].ciclos,
+             "4 contextos: amoadd < ll/sc sem trava < trava");
+}
+
+int main(){
+    encodingTest();
+    reservationTest();
+    slicingTest();
+    contentionTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
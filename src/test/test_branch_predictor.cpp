@@ -0,0 +1,215 @@
+/*
+  test_branch_predictor.cpp
+  Testes do preditor de desvios (cpu/BRANCH_PREDICTOR): cada tipo aprende o
+  padrão que deveria, a RAS acerta retornos e, no pipeline de Core(), prever
+  bem economiza ciclos sem mudar o resultado do programa.
+*/
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <memory>
+
+#include "cpu/BRANCH_PREDICTOR.hpp"
+#include "cpu/PCB.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+static BranchPredictorConfig configura(PredictorKind kind, unsigned penalty = 0){
+    BranchPredictorConfig c;
+    c.kind = kind;
+    c.historyBits = 4;
+    c.mispredictPenalty = penalty;
+    return c;
+}
+
+// Roda um desvio condicional com o padrão dado, 'voltas' vezes; retorna os erros da última volta
+static int erros(BranchPredictor &bp, const vector<bool> &padrao, int voltas){
+    const uint32_t pc = 100, alvo = 80;
+    int errosVolta = 0;
+    for (int v = 0; v < voltas; ++v) {
+        errosVolta = 0;
+        for (bool taken : padrao) {
+            Prediction p = bp.predict(pc);
+            if (bp.update(pc, isa::Op::BNE, p, taken, alvo)) errosVolta++;
+        }
+    }
+    return errosVolta;
+}
+
+void directionTest(){
+    cout << "\n=== Direction Predictor Test ===\n";
+    const vector<bool> laco = {true, true, true, true, true, true, true, false};
+    const vector<bool> alterna = {true, false, true, false, true, false, true, false};
+
+    BranchPredictor naoDesvia(configura(PredictorKind::NotTaken));
+    verifica(erros(naoDesvia, laco, 5) == 7, "not-taken erra todo desvio tomado");
+
+    BranchPredictor estatico(configura(PredictorKind::Static));
+    verifica(erros(estatico, laco, 5) == 1, "static (BTFN) acerta o desvio para tras do laco");
+
+    BranchPredictor bimodal(configura(PredictorKind::Bimodal));
+    verifica(erros(bimodal, laco, 5) == 1, "bimodal aprende o laco (erra so a saida)");
+
+    BranchPredictor bimodal2(configura(PredictorKind::Bimodal));
+    BranchPredictor gshare(configura(PredictorKind::GShare));
+    BranchPredictor torneio(configura(PredictorKind::Tournament));
+    verifica(erros(bimodal2, alterna, 20) >= 4, "bimodal nao aprende padrao alternado");
+    verifica(erros(gshare, alterna, 20) == 0, "gshare aprende padrao alternado pelo historico");
+    verifica(erros(torneio, alterna, 20) == 0, "tournament escolhe o gshare no padrao alternado");
+}
+
+void returnStackTest(){
+    cout << "\n=== BTB / Return Address Stack Test ===\n";
+    BranchPredictor bp(configura(PredictorKind::Bimodal));
+    // Duas chamadas à mesma função (400..420) a partir de lugares diferentes
+    bp.warm(200, isa::Op::JAL, true, 400);
+    bp.warm(420, isa::Op::JR, true, 204);
+    bp.warm(300, isa::Op::JAL, true, 400);
+    bp.warm(420, isa::Op::JR, true, 304);
+
+    Prediction chamada = bp.predict(200);
+    verifica(chamada.btbHit && chamada.nextPC == 400, "jal previsto pela BTB");
+    Prediction retorno = bp.predict(420);
+    verifica(retorno.nextPC == 204, "jr volta para quem chamou (RAS), nao para o ultimo alvo");
+    bp.update(420, isa::Op::JR, retorno, true, 204);
+    bp.update(200, isa::Op::JAL, chamada, true, 400);
+
+    // Código reescrito: o endereço do desvio virou uma instrução comum
+    Prediction velho = bp.predict(200);
+    verifica(bp.update(200, isa::Op::ADD, velho, false, 0) && !bp.predict(200).btbHit,
+             "entrada da BTB de instrucao que deixou de ser desvio e invalidada");
+
+    BranchPredictor naoDesvia(configura(PredictorKind::NotTaken));
+    naoDesvia.warm(200, isa::Op::JAL, true, 400);
+    verifica(naoDesvia.predict(200).nextPC == 204, "not-taken nao consulta a BTB");
+}
+
+void stateTest(){
+    cout << "\n=== Predictor State Test ===\n";
+    BranchPredictor original(configura(PredictorKind::Tournament, 3));
+    erros(original, {true, false, true, true}, 10);
+    original.warm(200, isa::Op::JAL, true, 400);
+
+    stringstream buffer;
+    original.saveState(buffer);
+    BranchPredictor restaurado;
+    restaurado.loadState(buffer);
+    BranchPredictor copia = original;
+
+    bool iguais = restaurado.config().kind == PredictorKind::Tournament && restaurado.config().mispredictPenalty == 3;
+    for (uint32_t pc : {100u, 200u, 420u}) {
+        Prediction a = original.predict(pc), b = restaurado.predict(pc), c = copia.predict(pc);
+        iguais = iguais && a.nextPC == b.nextPC && a.nextPC == c.nextPC && a.history == b.history;
+    }
+    verifica(iguais, "checkpoint e copia preservam tabelas, historico e RAS");
+
+    stringstream truncado(buffer.str().substr(0, 10));
+    bool rejeitou = false;
+    try { restaurado.loadState(truncado); } catch (const runtime_error &) { rejeitou = true; }
+    verifica(rejeitou, "estado truncado e rejeitado");
+
+    bool invalido = false;
+    try { predictor_kind_from_string("perceptron"); } catch (const invalid_argument &) { invalido = true; }
+    verifica(invalido && predictor_kind_from_string("gshare") == PredictorKind::GShare, "nomes dos preditores");
+}
+
+// Laço aninhado com chamada: desvios bem previsíveis
+static const char *LACOS = R"(
+        .data
+total:  .word 0
+        .text
+        li   $s0, 0
+        li   $s1, 30
+        li   $s2, 0
+fora:   li   $s3, 0
+dentro: jal  soma
+        addi $s3, $s3, 1
+        blt  $s3, $s1, dentro
+        addi $s0, $s0, 1
+        bne  $s0, $s1, fora
+        sw   $s2, total
+        print $s2
+        end
+soma:   add  $s2, $s2, $s3
+        jr   $ra
+)";
+
+struct Resultado {
+    uint64_t ciclos = 0, instrucoes = 0, desvios = 0, erros = 0, flush = 0;
+    uint32_t s2 = 0, total = 0;
+    vector<string> saida;
+};
+
+static Resultado roda(const BranchPredictorConfig &config){
+    MemoryManager mem(4096, 8192);
+    PCB pcb;
+    pcb.quantum = 50;
+    pcb.branchPredictor = BranchPredictor(config);
+    ProgramImage img = compileAsmSource(LACOS, 0);
+    writeProgramImage(img, mem, pcb);
+    pcb.regBank.pc.write(img.entryAddr());
+
+    Resultado r;
+    QuietCore quiet;
+    bool printLock = false;
+    for (int fatia = 0; fatia < 100000 && pcb.state != State::Finished; ++fatia) {
+        vector<unique_ptr<IORequest>> io;
+        Core(mem, pcb, &io, printLock);
+        for (const auto &req : io) r.saida.push_back(req->msg);
+    }
+    r.ciclos = pcb.pipeline_cycles.load();
+    r.instrucoes = pcb.instructions_retired.load();
+    r.desvios = pcb.branch_predictions.load();
+    r.erros = pcb.branch_mispredictions.load();
+    r.flush = pcb.branch_flush_cycles.load();
+    r.s2 = pcb.regBank.s2.read();
+    r.total = mem.peek(0);
+    return r;
+}
+
+void pipelineTest(){
+    cout << "\n=== Pipeline Prediction Test ===\n";
+    const Resultado base = roda(configura(PredictorKind::NotTaken));
+    verifica(base.saida == vector<string>({"13050"}) && base.total == 13050, "not-taken: resultado correto");
+    verifica(base.desvios > 0 && base.erros > base.desvios / 2 && base.flush == base.erros,
+             "not-taken: cada desvio tomado custa uma bolha de flush");
+
+    bool mesmoResultado = true;
+    for (PredictorKind kind : {PredictorKind::Static, PredictorKind::Bimodal,
+                               PredictorKind::GShare, PredictorKind::Tournament}) {
+        const Resultado r = roda(configura(kind));
+        mesmoResultado = mesmoResultado && r.saida == base.saida && r.s2 == base.s2 &&
+                         r.instrucoes == base.instrucoes && r.desvios == base.desvios;
+        verifica(r.erros * 10 < base.erros && r.ciclos < base.ciclos,
+                 string(predictor_kind_name(kind)) + ": menos erros e menos ciclos que not-taken");
+    }
+    verifica(mesmoResultado, "todos os preditores chegam ao mesmo estado arquitetural");
+
+    const Resultado semPenalidade = roda(configura(PredictorKind::Bimodal));
+    const Resultado comPenalidade = roda(configura(PredictorKind::Bimodal, 4));
+    verifica(comPenalidade.erros > 0 && comPenalidade.ciclos > semPenalidade.ciclos &&
+             comPenalidade.flush > semPenalidade.flush && comPenalidade.saida == base.saida,
+             "penalidade para o Fetch por N ciclos a cada erro");
+}
+
+int main(){
+    directionTest();
+    returnStackTest();
+    stateTest();
+    pipelineTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+/*
+  test_checkpoint.cpp
+  Testes do checkpoint da máquina (cpu/checkpoint): uma simulação retomada
+  de um checkpoint precisa terminar exatamente como a que não parou.
+*/
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
+
+#include "cpu/checkpoint.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/ISA.hpp"
+#include "cpu/PCB.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+// Acumula i em v[i % 16]; na base 0, 0($t0) indexa o vetor
+static const char *VETOR = R"(
+        .data
+vetor:  .word 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+        .text
+        li   $s0, 0
+        li   $s1, 300
+laco:   andi $t0, $s0, 15
+        sll  $t0, $t0, 2
+        lw   $t1, 0($t0)
+        add  $t1, $t1, $s0
+        sw   $t1, 0($t0)
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        lw   $t2, 60($zero)
+        print $t2
+        end
+)";
+
+static const char *SOMA = R"(
+        .data
+soma:   .word 0
+        .text
+        li   $s0, 0
+        li   $s1, 400
+laco:   lw   $t0, soma
+        add  $t0, $t0, $s0
+        sw   $t0, soma
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        lw   $t1, soma
+        print $t1
+        end
+)";
+
+struct Simulacao {
+    unique_ptr<MemoryManager> mem = make_unique<MemoryManager>(1024, 8192);
+    SchedulerState escalonador;
+    vector<string> saida; // prints, em ordem
+};
+
+static void adiciona(Simulacao &s, const ProgramImage &img, int pid, uint64_t chegada){
+    auto pcb = make_unique<PCB>();
+    pcb->pid = pid;
+    pcb->name = "p" + to_string(pid);
+    pcb->quantum = 37;
+    pcb->arrival_time = chegada;
+    writeProgramImage(img, *s.mem, *pcb);
+    pcb->regBank.pc.write(img.entryAddr());
+    s.escalonador.events.schedule(chegada, EventKind::Arrival, pcb.get());
+    s.escalonador.processes.push_back(move(pcb));
+}
+
+static Simulacao prepara(){
+    Simulacao s;
+    adiciona(s, compileAsmSource(VETOR, 0), 1, 0);
+    adiciona(s, compileAsmSource(SOMA, 512), 2, 50);
+    return s;
+}
+
+// Round-Robin de main.cpp (fila de eventos), sem I/O bloqueante. Para entre
+// duas fatias, com a CPU livre; fatias < 0 roda até o fim.
+static void roda(Simulacao &s, int fatias){
+    SchedulerState &e = s.escalonador;
+    const int total = static_cast<int>(e.processes.size());
+    QuietCore quiet;
+    PCB *rodando = nullptr;
+    while (e.finished < total) {
+        if (!rodando && (e.events.empty() || e.events.nextCycle() > e.clock) && !e.ready.empty()) {
+            if (fatias == 0) break;
+            rodando = e.ready.front();
+            e.ready.pop_front();
+            rodando->state = State::Running;
+
+            vector<unique_ptr<IORequest>> io;
+            bool printLock = false;
+            const uint64_t antes = rodando->pipeline_cycles.load();
+            Core(*s.mem, *rodando, &io, printLock);
+            e.events.schedule(e.clock + (rodando->pipeline_cycles.load() - antes), EventKind::SliceEnd, rodando);
+            for (const auto &req : io) s.saida.push_back(req->msg);
+            fatias--;
+            continue;
+        }
+        const Event ev = e.events.pop();
+        e.clock = max(e.clock, ev.cycle);
+        if (ev.kind == EventKind::Arrival) {
+            e.ready.push_back(ev.process);
+        } else if (ev.process->state == State::Finished) {
+            rodando = nullptr;
+            e.finished++;
+        } else {
+            rodando = nullptr;
+            ev.process->state = State::Ready;
+            e.ready.push_back(ev.process);
+        }
+    }
+}
+
+static bool mesmoPCB(const PCB &a, const PCB &b){
+    for (const auto &nome : isa::REGISTER_NAMES) {
+        const string n(nome.substr(1));
+        if (a.regBank.readRegister(n) != b.regBank.readRegister(n)) return false;
+    }
+    return a.pid == b.pid && a.name == b.name && a.state == b.state &&
+           a.regBank.pc.read() == b.regBank.pc.read() &&
+           a.pipeline_cycles.load() == b.pipeline_cycles.load() &&
+           a.instructions_retired.load() == b.instructions_retired.load() &&
+           a.memory_cycles.load() == b.memory_cycles.load() &&
+           a.mem_reads.load() == b.mem_reads.load() &&
+           a.mem_writes.load() == b.mem_writes.load() &&
+           a.cache_hits.load() == b.cache_hits.load() &&
+           a.cache_misses.load() == b.cache_misses.load() &&
+           a.primary_mem_accesses.load() == b.primary_mem_accesses.load();
+}
+
+static bool mesmaSimulacao(const Simulacao &a, const Simulacao &b){
+    const auto &pa = a.escalonador.processes, &pb = b.escalonador.processes;
+    if (pa.size() != pb.size() || a.escalonador.clock != b.escalonador.clock || a.saida != b.saida) return false;
+    for (size_t i = 0; i < pa.size(); ++i)
+        if (!mesmoPCB(*pa[i], *pb[i])) return false;
+    for (uint32_t addr = 0; addr < a.mem->addressSpaceSize(); ++addr)
+        if (a.mem->peek(addr) != b.mem->peek(addr)) return false;
+    return true;
+}
+
+void resumeTest(IOManager &io){
+    cout << "\n=== Checkpoint Resume Test ===\n";
+    const string arquivo = "test_checkpoint.ckpt";
+
+    Simulacao original = prepara();
+    roda(original, 7);
+    verifica(original.escalonador.ready.size() == 2 && original.escalonador.finished == 0,
+             "checkpoint no meio dos dois processos");
+    save_checkpoint(arquivo, *original.mem, original.escalonador, io);
+    const vector<string> saidaAntes = original.saida;
+    const int primeiroPronto = original.escalonador.ready.front()->pid;
+    roda(original, -1);
+    verifica(original.saida.size() == 2 && original.saida[0] == "2718" && original.saida[1] == "79800",
+             "execucao sem parar termina com os prints esperados");
+
+    // Retomada em memória com outro tamanho: o checkpoint traz o seu
+    Simulacao retomada;
+    retomada.mem = make_unique<MemoryManager>(16, 16);
+    retomada.saida = saidaAntes;
+    load_checkpoint(arquivo, *retomada.mem, retomada.escalonador, io);
+    verifica(retomada.escalonador.processes.size() == 2 && retomada.escalonador.ready.size() == 2 &&
+             retomada.escalonador.ready.front()->pid == primeiroPronto &&
+             retomada.mem->addressSpaceSize() == original.mem->addressSpaceSize(),
+             "processos, filas e memoria restaurados");
+    roda(retomada, -1);
+    verifica(mesmaSimulacao(original, retomada), "retomada termina identica (registradores, contadores, memoria, relogio)");
+
+    // Várias variantes a partir do mesmo checkpoint
+    Simulacao outra;
+    load_checkpoint(arquivo, *outra.mem, outra.escalonador, io);
+    outra.saida = saidaAntes;
+    roda(outra, -1);
+    verifica(mesmaSimulacao(retomada, outra), "segunda retomada do mesmo arquivo identica");
+
+    // Antes da chegada do segundo processo: o evento fica na fila gravada
+    Simulacao cedo = prepara();
+    roda(cedo, 1);
+    save_checkpoint(arquivo, *cedo.mem, cedo.escalonador, io);
+    Simulacao cedoRetomada;
+    load_checkpoint(arquivo, *cedoRetomada.mem, cedoRetomada.escalonador, io);
+    const vector<Event> pendentes = cedoRetomada.escalonador.events.pending();
+    verifica(cedo.escalonador.clock < 50 && pendentes.size() == 1 && pendentes[0].cycle == 50 &&
+             pendentes[0].kind == EventKind::Arrival && pendentes[0].process->pid == 2,
+             "chegada futura restaurada na fila de eventos");
+    cedoRetomada.saida = cedo.saida;
+    roda(cedo, -1);
+    roda(cedoRetomada, -1);
+    verifica(mesmaSimulacao(cedo, cedoRetomada), "retomada antes da chegada termina identica");
+    remove(arquivo.c_str());
+}
+
+static bool rejeita(const string &arquivo, IOManager &io){
+    Simulacao s;
+    try {
+        load_checkpoint(arquivo, *s.mem, s.escalonador, io);
+    } catch (const runtime_error &) {
+        return s.escalonador.processes.empty();
+    }
+    return false;
+}
+
+void rejectTest(IOManager &io){
+    cout << "\n=== Checkpoint Reject Test ===\n";
+    const string arquivo = "test_checkpoint_bad.ckpt";
+    Simulacao s = prepara();
+    roda(s, 3);
+    save_checkpoint(arquivo, *s.mem, s.escalonador, io);
+
+    string conteudo;
+    {
+        ifstream in(arquivo, ios::binary);
+        conteudo.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+    auto grava = [&](const string &dados){
+        ofstream out(arquivo, ios::binary | ios::trunc);
+        out.write(dados.data(), dados.size());
+    };
+
+    string outraVersao = conteudo;
+    outraVersao[4] = static_cast<char>(CHECKPOINT_VERSION + 1);
+    grava(outraVersao);
+    verifica(rejeita(arquivo, io), "versao diferente rejeitada");
+
+    grava(conteudo.substr(0, conteudo.size() / 2));
+    verifica(rejeita(arquivo, io), "arquivo truncado rejeitado");
+
+    grava(conteudo + "x");
+    verifica(rejeita(arquivo, io), "lixo no fim rejeitado");
+
+    remove(arquivo.c_str());
+    verifica(rejeita(arquivo, io), "arquivo inexistente rejeitado");
+}
+
+int main(){
+    IOManager io;
+    resumeTest(io);
+    rejectTest(io);
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/*
+  test_completion_ring.cpp
+  Testes da fila de conclusões do I/O (IO/completion_ring): ordem FIFO,
+  limite de capacidade e volta do índice; forEach olha sem retirar; e vários
+  produtores publicando ao mesmo tempo para um consumidor, sem perder nem
+  duplicar elementos e mantendo a ordem de cada produtor. Compara o tempo
+  com a fila antiga (deque protegido por mutex).
+*/
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+#include "IO/completion_ring.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+void fifoTest(){
+    cout << "\n=== FIFO Test ===\n";
+    CompletionRing<int, 8> fila;
+    int valor = -1;
+    verifica(fila.empty() && !fila.tryPop(valor), "vazia: tryPop falha");
+
+    bool cabe = true;
+    for (int i = 0; i < 8; ++i) cabe = cabe && fila.tryPush(i);
+    verifica(cabe && !fila.tryPush(8), "cheia: tryPush falha depois de 'capacity' elementos");
+
+    vector<int> vistos;
+    fila.forEach([&vistos](int v) { vistos.push_back(v); });
+    verifica(vistos == vector<int>({0, 1, 2, 3, 4, 5, 6, 7}), "forEach na ordem, sem retirar");
+
+    bool ordem = true;
+    for (int i = 0; i < 8; ++i) ordem = ordem && fila.tryPop(valor) && valor == i;
+    verifica(ordem && fila.empty(), "sai na ordem de entrada");
+
+    // Muitas voltas pela mesma memória, com a fila meio cheia
+    bool voltas = true;
+    int proximo = 0, esperado = 0;
+    for (int rodada = 0; rodada < 1000; ++rodada) {
+        for (int k = 0; k < 5; ++k) voltas = voltas && fila.tryPush(proximo++);
+        for (int k = 0; k < 5; ++k) voltas = voltas && fila.tryPop(valor) && valor == esperado++;
+    }
+    verifica(voltas && fila.empty(), "indices dao a volta sem perder a ordem");
+}
+
+constexpr int PRODUTORES = 4;
+constexpr uint64_t POR_PRODUTOR = 200000;
+
+// Cada produtor publica (produtor << 32 | n), n = 0, 1, 2...
+template <typename Push, typename Pop>
+static double produz(Push push, Pop pop, bool &semPerda, bool &ordemPorProdutor){
+    const auto inicio = chrono::steady_clock::now();
+    vector<thread> produtores;
+    for (uint64_t p = 0; p < PRODUTORES; ++p)
+        produtores.emplace_back([p, &push] {
+            for (uint64_t n = 0; n < POR_PRODUTOR; ++n)
+                while (!push((p << 32) | n)) this_thread::yield();
+        });
+
+    vector<uint64_t> proximo(PRODUTORES, 0);
+    uint64_t recebidos = 0, valor = 0;
+    ordemPorProdutor = true;
+    while (recebidos < PRODUTORES * POR_PRODUTOR) {
+        if (!pop(valor)) { this_thread::yield(); continue; }
+        const uint64_t p = valor >> 32;
+        ordemPorProdutor = ordemPorProdutor && p < PRODUTORES && (valor & 0xffffffffu) == proximo[p];
+        if (p < PRODUTORES) proximo[p]++;
+        recebidos++;
+    }
+    for (thread &t : produtores) t.join();
+    semPerda = !pop(valor);
+    for (uint64_t n : proximo) semPerda = semPerda && n == POR_PRODUTOR;
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+void concurrencyTest(){
+    cout << "\n=== Multi-Producer Test ===\n";
+    static CompletionRing<uint64_t, 1024> fila;
+    bool semPerda = false, ordem = false;
+    const double anel = produz([](uint64_t v) { return fila.tryPush(v); },
+                               [](uint64_t &v) { return fila.tryPop(v); }, semPerda, ordem);
+    verifica(semPerda, "4 produtores: cada elemento chega uma vez so");
+    verifica(ordem, "ordem de cada produtor preservada");
+
+    // A fila de antes: deque com mutex, limitado do mesmo jeito
+    deque<uint64_t> antiga;
+    mutex trava;
+    bool semPerdaAntiga = false, ordemAntiga = false;
+    const double comTrava = produz(
+        [&](uint64_t v) {
+            lock_guard<mutex> lock(trava);
+            if (antiga.size() >= 1024) return false;
+            antiga.push_back(v);
+            return true;
+        },
+        [&](uint64_t &v) {
+            lock_guard<mutex> lock(trava);
+            if (antiga.empty()) return false;
+            v = antiga.front();
+            antiga.pop_front();
+            return true;
+        }, semPerdaAntiga, ordemAntiga);
+    verifica(semPerdaAntiga && ordemAntiga, "referencia com mutex confere");
+
+    const double total = PRODUTORES * POR_PRODUTOR;
+    cout << "  sem travas: " << anel * 1e9 / total << " ns/elemento; deque+mutex: "
+         << comTrava * 1e9 / total << " ns/elemento\n";
+}
+
+int main(){
+    fifoTest();
+    concurrencyTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
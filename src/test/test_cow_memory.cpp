@@ -0,0 +1,173 @@
+/*
+  test_cow_memory.cpp
+  Testes da bifurcação com cópia na escrita (memory/PagedStorage,
+  MemoryManager::fork, fork_scheduler): cópias compartilham páginas até
+  escreverem, e cada variante evolui sem enxergar as outras.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "cpu/checkpoint.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/PCB.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+void pageTest(){
+    cout << "\n=== Copy-on-Write Page Test ===\n";
+    PagedStorage a(200, 7);
+    verifica(a.pageCount() == 4 && a.get(0) == 7 && a.get(199) == 7 && a.sharedPages() == 4,
+             "paginas nunca escritas compartilham a pagina de preenchimento");
+    a.set(10, 1);
+    verifica(a.copiedPages() == 1 && a.sharedPages() == 3, "primeira escrita duplica so uma pagina");
+
+    PagedStorage b(a);
+    verifica(b.get(10) == 1 && b.copiedPages() == 0 && b.sharedPages() == 4, "copia compartilha todas as paginas");
+    b.set(11, 2);
+    b.set(12, 3);
+    verifica(b.copiedPages() == 1 && a.get(11) == 7 && b.get(11) == 2 && b.get(10) == 1,
+             "escrita na copia duplica uma pagina e nao aparece no original");
+    a.set(150, 9);
+    verifica(b.get(150) == 7 && a.get(150) == 9, "escrita no original nao aparece na copia");
+}
+
+void memoryForkTest(){
+    cout << "\n=== MemoryManager Fork Test ===\n";
+    MemoryManager mem(1024, 8192);
+    PCB pcb;
+    for (uint32_t addr = 0; addr < 1024; addr += 4) mem.poke(addr, addr);
+    mem.write(2000, 111, pcb); // linha suja na cache (memória secundária)
+
+    auto variante = mem.fork();
+    MemoryManager::PageStats s = variante->pageStats();
+    verifica(s.pages == 16 + 128 && s.shared == s.pages && s.copied == 0,
+             "fork nao copia nenhuma pagina");
+
+    variante->poke(8, 999);
+    variante->write(2000, 222, pcb);
+    variante->poke(9000, 5); // memória secundária, fora da cache
+    verifica(mem.peek(8) == 8 && variante->peek(8) == 999, "escrita na variante isolada (memoria principal)");
+    verifica(mem.peek(2000) == 111 && variante->peek(2000) == 222, "linhas sujas da cache independentes");
+    verifica(mem.peek(9000) != 5 && variante->peek(9000) == 5, "escrita na variante isolada (memoria secundaria)");
+    s = variante->pageStats();
+    verifica(s.copied == 2 && s.shared == s.pages - 2, "so as paginas escritas foram copiadas");
+}
+
+// Soma 0..399 numa variável; dois processos para o escalonador ter filas
+static const char *SOMA = R"(
+        .data
+soma:   .word 0
+        .text
+        li   $s0, 0
+        li   $s1, 400
+laco:   lw   $t0, soma
+        add  $t0, $t0, $s0
+        sw   $t0, soma
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        lw   $t1, soma
+        print $t1
+        end
+)";
+
+struct Maquina {
+    unique_ptr<MemoryManager> mem;
+    SchedulerState escalonador;
+    vector<string> saida;
+};
+
+// Round-Robin de main.cpp (fila de eventos), sem I/O bloqueante. Para entre
+// duas fatias, com a CPU livre; fatias < 0 roda até o fim.
+static void roda(Maquina &m, int fatias){
+    SchedulerState &e = m.escalonador;
+    const int total = static_cast<int>(e.processes.size());
+    QuietCore quiet;
+    PCB *rodando = nullptr;
+    while (e.finished < total) {
+        if (!rodando && (e.events.empty() || e.events.nextCycle() > e.clock) && !e.ready.empty()) {
+            if (fatias == 0) break;
+            rodando = e.ready.front();
+            e.ready.pop_front();
+            vector<unique_ptr<IORequest>> io;
+            bool printLock = false;
+            const uint64_t antes = rodando->pipeline_cycles.load();
+            Core(*m.mem, *rodando, &io, printLock);
+            e.events.schedule(e.clock + (rodando->pipeline_cycles.load() - antes), EventKind::SliceEnd, rodando);
+            for (const auto &req : io) m.saida.push_back(req->msg);
+            fatias--;
+            continue;
+        }
+        const Event ev = e.events.pop();
+        e.clock = max(e.clock, ev.cycle);
+        if (ev.kind == EventKind::SliceEnd) rodando = nullptr;
+        if (ev.process->state == State::Finished) e.finished++;
+        else e.ready.push_back(ev.process);
+    }
+}
+
+static Maquina bifurca(const Maquina &m){
+    return {m.mem->fork(), fork_scheduler(m.escalonador), m.saida};
+}
+
+void machineForkTest(){
+    cout << "\n=== Machine Fork Test ===\n";
+    Maquina base{make_unique<MemoryManager>(1024, 8192), {}, {}};
+    for (int i = 0; i < 2; ++i) {
+        auto pcb = make_unique<PCB>();
+        pcb->pid = i + 1;
+        pcb->quantum = 40;
+        ProgramImage img = compileAsmSource(SOMA, 256 * i);
+        writeProgramImage(img, *base.mem, *pcb);
+        pcb->regBank.pc.write(img.entryAddr());
+        base.escalonador.events.schedule(0, EventKind::Arrival, pcb.get());
+        base.escalonador.processes.push_back(move(pcb));
+    }
+    roda(base, 10); // estado "aquecido" comum
+
+    Maquina igual = bifurca(base);
+    Maquina outroQuantum = bifurca(base);
+    for (auto &p : outroQuantum.escalonador.processes) p->quantum = 7;
+    verifica(igual.escalonador.ready.size() == base.escalonador.ready.size() &&
+             igual.escalonador.ready.front() != base.escalonador.ready.front() &&
+             igual.escalonador.ready.front()->pid == base.escalonador.ready.front()->pid,
+             "filas da bifurcacao apontam para PCBs proprios");
+
+    roda(base, -1);
+    roda(igual, -1);
+    roda(outroQuantum, -1);
+
+    bool mesmo = base.saida == igual.saida && base.escalonador.clock == igual.escalonador.clock;
+    for (size_t i = 0; i < base.escalonador.processes.size(); ++i) {
+        const PCB &a = *base.escalonador.processes[i], &b = *igual.escalonador.processes[i];
+        mesmo = mesmo && a.pipeline_cycles.load() == b.pipeline_cycles.load() &&
+                a.memory_cycles.load() == b.memory_cycles.load() && a.regBank.t1.read() == b.regBank.t1.read();
+    }
+    verifica(mesmo && base.saida == vector<string>({"79800", "79800"}),
+             "variante identica termina igual ao original");
+    verifica(outroQuantum.saida == base.saida && outroQuantum.escalonador.clock != base.escalonador.clock,
+             "variante com outro quantum: mesmo resultado, outro tempo");
+    MemoryManager::PageStats s = igual.mem->pageStats();
+    verifica(s.copied > 0 && s.copied <= 2, "variantes copiaram so as paginas das variaveis");
+}
+
+int main(){
+    pageTest();
+    memoryForkTest();
+    machineForkTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
@@ -13,28 +13,12 @@
 #include "cpu/REGISTER_BANK.hpp"
 #include "cpu/ULA.hpp"
 #include "cpu/HASH_REGISTER.hpp"
+#include "cpu/ISA.hpp"
 
 // CORREÇÃO: Caminho dos includes de memória e I/O ajustado
 #include "memory/MemoryManager.hpp"
 #include "IO/IOManager.hpp" // Define a estrutura IORequest
 
-// Sentinel de fim de programa (mesmo usado em CONTROL_UNIT.cpp)
-static constexpr uint32_t END_SENTINEL = 0b11111100000000000000000000000000u;
-
-// Helpers de montagem de instruções (formato simplificado compatível com o decodificador atual)
-static uint32_t makeR(uint8_t rs, uint8_t rt, uint8_t rd, uint8_t funct /*6 bits*/) {
-    return (0u << 26) | (static_cast<uint32_t>(rs) << 21) | (static_cast<uint32_t>(rt) << 16) |
-           (static_cast<uint32_t>(rd) << 11) | (0u << 6) | (funct & 0x3Fu);
-}
-static uint32_t makeI(uint8_t opcode /*6 bits*/, uint8_t rs, uint8_t rt, uint16_t imm) {
-    return (static_cast<uint32_t>(opcode & 0x3F) << 26) | (static_cast<uint32_t>(rs) << 21) |
-           (static_cast<uint32_t>(rt) << 16) | imm;
-}
-static uint32_t makeJ(uint8_t opcode /*6 bits*/, uint32_t addr26) {
-    return (static_cast<uint32_t>(opcode & 0x3F) << 26) | (addr26 & 0x03FFFFFFu);
-}
-
-
 int main() {
     // Carrega PCB do JSON
     PCB pcb{};
@@ -55,13 +39,13 @@ int main() {
     uint8_t r_t3 = hw::RegisterMapper::indexFromBinary(mapper.getRegisterBinary("t3"));
     uint8_t r_t4 = hw::RegisterMapper::indexFromBinary(mapper.getRegisterBinary("t4"));
 
-    // Instruções
-    uint32_t li_t1 = makeI(0x0E, r_zero, r_t1, 5);
-    uint32_t li_t2 = makeI(0x0E, r_zero, r_t2, 7);
-    uint32_t add_t3 = makeR(r_t1, r_t2, r_t3, 0x20);
-    uint32_t sw_t3  = makeI(0x0D, r_zero, r_t3, 20);
-    uint32_t lw_t4  = makeI(0x0C, r_zero, r_t4, 20);
-    uint32_t print_t4 = makeI(0x10, r_zero, r_t4, 0);
+    // Instruções (codificadas pela tabela ISA, a mesma do montador e do decodificador)
+    uint32_t li_t1 = isa::encodeI(*isa::find("li"), r_zero, r_t1, 5);
+    uint32_t li_t2 = isa::encodeI(*isa::find("li"), r_zero, r_t2, 7);
+    uint32_t add_t3 = isa::encodeR(*isa::find("add"), r_t1, r_t2, r_t3, 0);
+    uint32_t sw_t3  = isa::encodeI(*isa::find("sw"), r_zero, r_t3, 28);
+    uint32_t lw_t4  = isa::encodeI(*isa::find("lw"), r_zero, r_t4, 28);
+    uint32_t print_t4 = isa::encodeI(*isa::find("print"), r_zero, r_t4, 0);
 
     // Escreve na memória usando o MemoryManager
     memManager.write(0, li_t1, pcb);
@@ -70,7 +54,7 @@ int main() {
     memManager.write(12, sw_t3, pcb);
     memManager.write(16, lw_t4, pcb);
     memManager.write(20, print_t4, pcb);
-    memManager.write(24, END_SENTINEL, pcb);
+    memManager.write(24, isa::END_WORD, pcb);
 
     // Zera o endereço alvo inicial
     memManager.write(28, 0, pcb); // Usando um endereço diferente para o dado
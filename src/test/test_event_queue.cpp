@@ -0,0 +1,273 @@
+/*
+  test_event_queue.cpp
+  Testes do escalonador por eventos (cpu/event_queue) e do I/O em tempo
+  virtual: a fila sai por ciclo e, no mesmo ciclo, na ordem de agendamento;
+  o IOManager dá os mesmos ciclos de término para a mesma semente, devolve
+  os processos pela fila de conclusões e não acorda quando não há trabalho;
+  e uma simulação com I/O bloqueante termina no mesmo ciclo toda vez, sem
+  esperar o relógio de parede.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cpu/checkpoint.hpp"
+#include "cpu/event_queue.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/PCB.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+void orderTest(){
+    cout << "\n=== Event Order Test ===\n";
+    PCB a, b, c;
+    EventQueue q;
+    q.schedule(30, EventKind::SliceEnd, &a);
+    q.schedule(10, EventKind::Arrival, &b);
+    q.schedule(30, EventKind::IoCompletion, &c);
+    q.schedule(10, EventKind::Arrival, &c);
+    q.schedule(0, EventKind::Arrival, &a);
+
+    const vector<Event> pendentes = q.pending();
+    verifica(q.size() == 5 && q.nextCycle() == 0 && pendentes.size() == 5, "proximo evento e o mais cedo");
+
+    vector<pair<uint64_t, PCB*>> ordem;
+    while (!q.empty()) {
+        const Event e = q.pop();
+        ordem.push_back({e.cycle, e.process});
+    }
+    const vector<pair<uint64_t, PCB*>> esperado = {{0, &a}, {10, &b}, {10, &c}, {30, &a}, {30, &c}};
+    verifica(ordem == esperado, "por ciclo e, no mesmo ciclo, na ordem de agendamento");
+
+    bool iguais = true;
+    for (size_t i = 0; i < esperado.size(); ++i)
+        iguais = iguais && pendentes[i].cycle == esperado[i].first && pendentes[i].process == esperado[i].second;
+    verifica(iguais, "pending() na ordem de saida");
+
+    bool lancou = false;
+    try { q.pop(); } catch (const logic_error &) { lancou = true; }
+    verifica(lancou, "fila vazia: pop lanca logic_error");
+}
+
+// Espera a resposta do IOManager e devolve o ciclo de término
+static uint64_t espera(IOManager &io, PCB &p){
+    const vector<PCB*> prontos = io.takeCompletions(1);
+    if (prontos.size() != 1 || prontos[0] != &p || p.state != State::Blocked)
+        throw runtime_error("conclusao inesperada do IOManager");
+    return p.io_ready_cycle.load();
+}
+
+static vector<uint64_t> atende(uint32_t semente, vector<uint64_t> &custos, uint64_t *acordou = nullptr){
+    IOManager io(semente);
+    vector<unique_ptr<PCB>> processos;
+    vector<uint64_t> termino;
+    custos.clear();
+    for (uint64_t envio : {0ull, 10ull, 10ull, 5000ull, 5001ull, 90000ull}) {
+        auto p = make_unique<PCB>();
+        p->pid = static_cast<int>(processos.size()) + 1;
+        p->state = State::Blocked;
+        io.registerProcessWaitingForIO(p.get(), envio);
+        termino.push_back(espera(io, *p));
+        custos.push_back(p->io_cycles.load() - 1);
+        processos.push_back(move(p));
+    }
+    if (acordou) *acordou = io.wakeups();
+    return termino;
+}
+
+void virtualTimeTest(){
+    cout << "\n=== Virtual Time I/O Test ===\n";
+    vector<uint64_t> custos, custosDeNovo, custosOutra;
+    uint64_t acordou = 0;
+    const vector<uint64_t> termino = atende(7, custos, &acordou);
+    const vector<uint64_t> deNovo = atende(7, custosDeNovo);
+    const vector<uint64_t> outra = atende(8, custosOutra);
+
+    verifica(termino == deNovo && custos == custosDeNovo, "mesma semente: mesmos ciclos de termino");
+    verifica(termino != outra, "outra semente: outros ciclos");
+
+    const uint64_t envio[] = {0, 10, 10, 5000, 5001, 90000};
+    // Um por vez: o atendimento começa quando o processo chega ou o
+    // dispositivo sorteado fica livre, com o custo da distribuição dele
+    uint64_t menor = UINT64_MAX, maior = 0;
+    for (const IODeviceConfig &d : IOManager::defaultDevices()) {
+        menor = min(menor, d.min_cycles);
+        maior = max(maior, d.max_cycles);
+    }
+    bool custoValido = true, esperaValida = true;
+    for (size_t i = 0; i < termino.size(); ++i) {
+        custoValido = custoValido && custos[i] >= menor && custos[i] <= maior;
+        const uint64_t comeco = termino[i] - custos[i];
+        esperaValida = esperaValida && comeco >= envio[i] &&
+                       (comeco == envio[i] || find(termino.begin(), termino.begin() + i, comeco) != termino.begin() + i);
+    }
+    verifica(custoValido, "custo dentro da distribuicao dos dispositivos");
+    verifica(esperaValida, "comeca na chegada ou quando o dispositivo fica livre");
+
+    // O custo fica em io_cycles (que começa em 1) e o término em
+    // io_ready_cycle, sem dormir: cada requisição acorda uma thread uma vez
+    verifica(acordou == termino.size(), "uma thread acordada por atendimento");
+}
+
+void wakeupTest(){
+    cout << "\n=== Condition Variable Test ===\n";
+    IOManager io(5);
+    verifica(io.wakeups() == 0 && io.takeCompletions().empty(), "ocioso: a thread nao acorda");
+
+    PCB a, b;
+    a.pid = 1;
+    b.pid = 2;
+    a.state = b.state = State::Blocked;
+    io.registerProcessWaitingForIO(&a, 0);
+    io.registerProcessWaitingForIO(&b, 0);
+    const vector<PCB*> prontos = io.takeCompletions(2);
+    verifica(prontos.size() == 2 && prontos[0]->io_ready_cycle.load() <= prontos[1]->io_ready_cycle.load() &&
+             (prontos[0]->io_ready_cycle.load() < prontos[1]->io_ready_cycle.load() || prontos[0] == &a),
+             "conclusoes em ordem de termino (empate: menor pid)");
+    verifica(a.state == State::Blocked && b.state == State::Blocked, "o estado do PCB fica com o escalonador");
+    // wakeups() conta antes de publicar a conclusão: já está em dia aqui
+    verifica(io.wakeups() == 2, "uma vez por requisicao");
+
+    // Conclusões ainda não entregues entram no checkpoint
+    PCB c;
+    c.state = State::Blocked;
+    io.registerProcessWaitingForIO(&c, 1000);
+    while (io.wakeups() < 3) this_thread::yield();
+    const IOManager::PendingState salvo = io.pendingState();
+    IOManager outro(99);
+    outro.restorePendingState(salvo);
+    const vector<PCB*> restaurado = outro.takeCompletions(1);
+    bool semFila = salvo.devices.size() == IOManager::defaultDevices().size();
+    for (const auto &d : salvo.devices) semFila = semFila && d.requests.empty();
+    verifica(semFila && salvo.completed.size() == 1 && restaurado.size() == 1 &&
+             restaurado[0] == &c && c.io_ready_cycle.load() == salvo.completed[0].completion_cycle &&
+             io.takeCompletions(1).size() == 1, "conclusao pendente salva e restaurada");
+}
+
+// Imprime (e bloqueia, com printLock) 'prints' vezes
+static string programa(int prints){
+    return R"(
+        .text
+        li   $s0, 0
+        li   $s1, )" + to_string(prints) + R"(
+laco:   addi $s0, $s0, 1
+        print $s0
+        addi $t0, $t0, 1
+        addi $t1, $t1, 1
+        addi $t2, $t2, 1
+        addi $t3, $t3, 1
+        addi $t4, $t4, 1
+        addi $t5, $t5, 1
+        bne  $s0, $s1, laco
+        end
+)";
+}
+
+struct Resultado {
+    uint64_t relogio = 0;
+    uint64_t cpu = 0;               // soma dos ciclos de pipeline
+    vector<int> ordem;              // pid de cada fatia, na ordem
+    double segundos = 0;
+};
+
+// Laço de main.cpp: eventos, I/O bloqueante no IOManager
+static Resultado simula(uint32_t semente){
+    const auto inicio = chrono::steady_clock::now();
+    MemoryManager mem(1024, 8192);
+    IOManager io(semente);
+    SchedulerState e;
+    for (int i = 0; i < 3; ++i) {
+        auto pcb = make_unique<PCB>();
+        pcb->pid = i + 1;
+        pcb->quantum = 50;
+        pcb->arrival_time = 400 * i;
+        ProgramImage img = compileAsmSource(programa(3 + i), 256 * i);
+        writeProgramImage(img, mem, *pcb);
+        pcb->regBank.pc.write(img.entryAddr());
+        e.events.schedule(pcb->arrival_time, EventKind::Arrival, pcb.get());
+        e.processes.push_back(move(pcb));
+    }
+
+    Resultado r;
+    QuietCore quiet;
+    PCB *rodando = nullptr;
+    while (e.finished < static_cast<int>(e.processes.size())) {
+        if (e.blocked > 0) {
+            for (PCB *p : io.takeCompletions(e.blocked)) {
+                e.events.schedule(p->io_ready_cycle.load(), EventKind::IoCompletion, p);
+                e.blocked--;
+            }
+        }
+        if (!rodando && (e.events.empty() || e.events.nextCycle() > e.clock) && !e.ready.empty()) {
+            rodando = e.ready.front();
+            e.ready.pop_front();
+            rodando->state = State::Running;
+            vector<unique_ptr<IORequest>> pedidos;
+            bool printLock = true;
+            const uint64_t antes = rodando->pipeline_cycles.load();
+            Core(mem, *rodando, &pedidos, printLock);
+            e.events.schedule(e.clock + (rodando->pipeline_cycles.load() - antes), EventKind::SliceEnd, rodando);
+            r.ordem.push_back(rodando->pid);
+            continue;
+        }
+        if (e.events.empty()) break;
+        const Event ev = e.events.pop();
+        e.clock = max(e.clock, ev.cycle);
+        if (ev.kind == EventKind::SliceEnd) {
+            rodando = nullptr;
+            if (ev.process->state == State::Blocked) {
+                io.registerProcessWaitingForIO(ev.process, e.clock);
+                e.blocked++;
+                continue;
+            }
+            if (ev.process->state == State::Finished) {
+                e.finished++;
+                continue;
+            }
+        }
+        ev.process->state = State::Ready;
+        e.ready.push_back(ev.process);
+    }
+    r.relogio = e.clock;
+    for (const auto &p : e.processes) r.cpu += p->pipeline_cycles.load();
+    r.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+void schedulerTest(){
+    cout << "\n=== Event-Driven Scheduler Test ===\n";
+    const Resultado a = simula(3);
+    const Resultado b = simula(3);
+    verifica(a.relogio == b.relogio && a.ordem == b.ordem, "mesma semente: mesmo relogio final e mesma ordem de fatias");
+    verifica(a.relogio > a.cpu, "relogio inclui o tempo de I/O e o ocioso");
+    verifica(count(a.ordem.begin(), a.ordem.end(), 3) >= 5, "cada print bloqueia e volta (processo 3: 5 prints)");
+    cout << "  relogio final " << a.relogio << " ciclos (CPU " << a.cpu << "), " << a.ordem.size()
+         << " fatias, " << a.segundos * 1000 << " ms de parede\n";
+}
+
+int main(){
+    orderTest();
+    virtualTimeTest();
+    wakeupTest();
+    schedulerTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
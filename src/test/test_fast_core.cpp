@@ -0,0 +1,250 @@
+/*
+  test_fast_core.cpp
+  Testes do núcleo rápido (cpu/FAST_CORE): o interpretador pré-decodificado
+  precisa chegar ao mesmo estado arquitetural que o pipeline de Core()
+  (registradores, PC, memória e requisições de I/O).
+*/
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#include "cpu/ISA.hpp"
+#include "cpu/PCB.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_json.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+// Percorre um vetor com laço, jal/jr e todas as operações da ALU. Montado na
+// base 0, então 0($t0) indexa o vetor.
+static const char *KERNEL = R"(
+        .data
+vec:    .word 3, -7, 12, 5, 0, 9, 21, -4
+n:      .word 8
+out:    .word 0, 0, 0, 0
+        .text
+main:   li    $s0, 0
+        lw    $s1, n
+        li    $s2, 0
+        li    $s3, -1000
+        li    $s4, 1
+loop:   beq   $s0, $s1, fim
+        sll   $t0, $s0, 2
+        lw    $t1, 0($t0)
+        add   $s2, $s2, $t1
+        blt   $t1, $s3, naomax
+        or    $s3, $t1, $zero
+naomax: beq   $t1, $zero, pula
+        mult  $s4, $s4, $t1
+pula:   jal   dobra
+        addi  $s0, $s0, 1
+        j     loop
+dobra:  sll   $t2, $t1, 1
+        sub   $s5, $s5, $t2
+        jr    $ra
+fim:    sw    $s2, out
+        sw    $s3, 40($zero)
+        sw    $s4, 44($zero)
+        div   $t3, $s2, $s1
+        andi  $t4, $s4, 0xFF
+        ori   $t5, $zero, 0x7001
+        srl   $t6, $t5, 4
+        slti  $t7, $s5, 0
+        sw    $s5, 48($zero)
+        print $s2
+        print $t3
+        end
+)";
+
+struct Execucao {
+    unique_ptr<MemoryManager> mem;
+    unique_ptr<PCB> pcb;
+    vector<unique_ptr<IORequest>> io;
+    uint32_t fim = 0; // fim da imagem
+};
+
+static Execucao prepara(const ProgramImage &img){
+    Execucao e;
+    e.mem = make_unique<MemoryManager>(1024, 8192);
+    e.pcb = make_unique<PCB>();
+    writeProgramImage(img, *e.mem, *e.pcb);
+    e.pcb->regBank.pc.write(img.entryAddr());
+    e.fim = img.endAddr();
+    return e;
+}
+
+static void executaCore(Execucao &e){
+    bool printLock = false;
+    e.pcb->quantum = 1000000;
+    ostringstream silencio;
+    streambuf *antigo = cout.rdbuf(silencio.rdbuf());
+    Core(*e.mem, *e.pcb, &e.io, printLock);
+    cout.rdbuf(antigo);
+}
+
+static void executaFast(Execucao &e){
+    bool printLock = false;
+    e.pcb->quantum = 1000000;
+    FastCore(*e.mem, *e.pcb, &e.io, printLock);
+}
+
+// Estado arquitetural igual: registradores, PC, estado, memória da imagem e I/O
+static bool mesmoEstado(const Execucao &a, const Execucao &b){
+    const auto &ra = a.pcb->regBank, &rb = b.pcb->regBank;
+    for (const auto &nome : isa::REGISTER_NAMES) {
+        const string n(nome.substr(1));
+        if (ra.readRegister(n) != rb.readRegister(n)) return false;
+    }
+    if (ra.pc.read() != rb.pc.read() || a.pcb->state != b.pcb->state) return false;
+    for (uint32_t addr = 0; addr < a.fim; ++addr)
+        if (a.mem->peek(addr) != b.mem->peek(addr)) return false;
+    if (a.io.size() != b.io.size()) return false;
+    for (size_t i = 0; i < a.io.size(); ++i)
+        if (a.io[i]->msg != b.io[i]->msg) return false;
+    return true;
+}
+
+static bool equivalente(const ProgramImage &img){
+    Execucao core = prepara(img), fast = prepara(img);
+    executaCore(core);
+    executaFast(fast);
+    return fast.pcb->state == State::Finished && mesmoEstado(core, fast) &&
+           core.pcb->instructions_retired.load() == fast.pcb->instructions_retired.load();
+}
+
+void equivalenceTest(){
+    cout << "\n=== FastCore x Core Equivalence Test ===\n";
+
+    for (int base : {0, 512})
+        verifica(equivalente(compileJsonProgram("tasks.json", base)),
+                 "tasks.json (base " + to_string(base) + ")");
+    verifica(equivalente(compileAsmProgram("tasks.s", 256)), "tasks.s (base 256)");
+    verifica(equivalente(compileAsmSource(KERNEL, 0)), "laco com jal/jr, lw/sw e ALU completa");
+
+    // Código automodificável: o sw troca a instrução em 4 (li $t2, 1 -> li $t2, 10)
+    // entre as duas voltas do laço. A entrada pré-decodificada tem de ser descartada.
+    const isa::InstrDesc &li = *isa::find("li");
+    ProgramImage smc;
+    smc.startAddr = 0;
+    smc.words = {
+        isa::encodeI(li, 0, 11, 2),                          //  0: li   $t3, 2
+        isa::encodeI(li, 0, 10, 1),                          //  4: li   $t2, 1
+        isa::encodeR(*isa::find("add"), 12, 10, 12, 0),      //  8: add  $t4, $t4, $t2
+        isa::encodeI(*isa::find("lw"), 0, 9, 40),            // 12: lw   $t1, 40($zero)
+        isa::encodeI(*isa::find("sw"), 0, 9, 4),             // 16: sw   $t1, 4($zero)
+        isa::encodeI(*isa::find("addi"), 11, 11, -1),        // 20: addi $t3, $t3, -1
+        isa::encodeI(*isa::find("bne"), 11, 0, -6),          // 24: bne  $t3, $zero, 4
+        isa::END_WORD,                                       // 28: end
+        0, 0,
+        isa::encodeI(li, 0, 10, 10)                          // 40: li   $t2, 10
+    };
+    Execucao fast = prepara(smc);
+    executaFast(fast);
+    verifica(fast.pcb->regBank.t4.read() == 11, "sw sobre codigo invalida a pre-decodificacao");
+    verifica(equivalente(smc), "codigo automodificavel igual ao Core");
+}
+
+void quantumTest(){
+    cout << "\n=== FastCore Quantum/IO Test ===\n";
+    ProgramImage img = compileAsmSource(KERNEL, 0);
+
+    // Fatias de 3 instruções chegam ao mesmo estado de uma execução única
+    Execucao inteira = prepara(img), fatiada = prepara(img);
+    executaFast(inteira);
+    bool printLock = false;
+    fatiada.pcb->quantum = 3;
+    const uint64_t versao = fatiada.mem->codeVersion();
+    int chamadas = 0;
+    while (fatiada.pcb->state != State::Finished && chamadas < 10000) {
+        FastCore(*fatiada.mem, *fatiada.pcb, &fatiada.io, printLock);
+        ++chamadas;
+    }
+    verifica(mesmoEstado(inteira, fatiada), "execucao em fatias == execucao unica");
+    verifica(fatiada.pcb->pipeline_cycles.load() == inteira.pcb->pipeline_cycles.load(),
+             "contadores em lote somam o mesmo");
+    // Os sw do laço só tocam dados: a versão do código não muda e a tabela
+    // pré-decodificada é reaproveitada de uma fatia para a outra
+    verifica(fatiada.mem->codeVersion() == versao, "fatias sem escrita em codigo mantem a pre-decodificacao");
+
+    // Escrita em código entre duas fatias (outro processo ou outro núcleo):
+    // a fatia seguinte enxerga a instrução nova (li $t2, 1 -> li $t2, 10)
+    Execucao troca = prepara(compileAsmSource(R"(
+        .text
+              li   $t1, 2
+        loop: li   $t2, 1
+              add  $t4, $t4, $t2
+              addi $t1, $t1, -1
+              bne  $t1, $zero, loop
+              end
+    )", 0));
+    troca.pcb->quantum = 4;
+    FastCore(*troca.mem, *troca.pcb, &troca.io, printLock);
+    const uint64_t antes = troca.mem->codeVersion();
+    troca.mem->poke(4, isa::encodeI(*isa::find("li"), 0, 10, 10));
+    verifica(troca.mem->codeVersion() != antes, "escrita em palavra decodificada muda a versao do codigo");
+    for (chamadas = 0; troca.pcb->state != State::Finished && chamadas < 100; ++chamadas)
+        FastCore(*troca.mem, *troca.pcb, &troca.io, printLock);
+    verifica(troca.pcb->regBank.t4.read() == 11, "escrita em codigo entre fatias invalida a pre-decodificacao");
+
+    // print com printLock bloqueia logo após a instrução
+    Execucao bloqueio = prepara(img);
+    printLock = true;
+    bloqueio.pcb->quantum = 1000000;
+    FastCore(*bloqueio.mem, *bloqueio.pcb, &bloqueio.io, printLock);
+    verifica(bloqueio.pcb->state == State::Blocked && bloqueio.io.size() == 1 &&
+             bloqueio.io[0]->msg == to_string(static_cast<int>(inteira.pcb->regBank.s2.read())),
+             "print com printLock bloqueia com uma requisicao");
+    verifica(isa::decode(bloqueio.mem->peek(bloqueio.pcb->regBank.pc.read()))->op == isa::Op::PRINT,
+             "PC aponta para a instrucao seguinte ao print");
+
+    verifica(coreFor(Engine::Fast) == FastCore && coreFor(Engine::Pipeline) == Core, "selecao do motor");
+}
+
+void throughputTest(){
+    cout << "\n=== FastCore Throughput ===\n";
+    // ~3 milhões de instruções: soma de 1 a 2^20
+    ProgramImage img = compileAsmSource(R"(
+        .text
+              li   $t1, 1
+              sll  $t1, $t1, 20
+        loop: addi $t0, $t0, 1
+              add  $t2, $t2, $t0
+              bne  $t0, $t1, loop
+              end
+    )", 0);
+    Execucao e = prepara(img);
+    bool printLock = false;
+
+    auto inicio = chrono::steady_clock::now();
+    uint64_t n = FastCoreRun(*e.mem, *e.pcb, &e.io, printLock, UINT64_MAX);
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    verifica(e.pcb->state == State::Finished && e.pcb->regBank.t0.read() == (1u << 20) &&
+             e.pcb->regBank.t2.read() == static_cast<uint32_t>((uint64_t(1) << 19) * ((1u << 20) + 1)),
+             "laco longo termina com o resultado certo");
+    cout << "  " << n << " instrucoes em " << segundos << " s ("
+         << (segundos > 0 ? n / segundos / 1e6 : 0) << " MIPS)\n";
+}
+
+int main(){
+    equivalenceTest();
+    quantumTest();
+    throughputTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
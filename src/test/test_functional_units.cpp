@@ -0,0 +1,176 @@
+/*
+  test_functional_units.cpp
+  Testes das unidades funcionais de várias etapas do pipeline de Core():
+  mult/div deixam o resultado em HI/LO (mfhi/mflo), a latência de cada
+  unidade atrasa só quem depende do resultado e uma unidade não segmentada
+  segura a operação seguinte do mesmo tipo. O tempo muda, o resultado não.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+
+#include "pipeline_test.hpp"
+
+using namespace std;
+
+static PipelineConfig unidades(FunctionalUnit mul, FunctionalUnit div, FunctionalUnit mem = {1, 1}){
+    PipelineConfig c;
+    c.unit(UnitKind::Multiplier) = mul;
+    c.unit(UnitKind::Divider) = div;
+    c.unit(UnitKind::LoadStore) = mem;
+    return c;
+}
+
+// Produto que não cabe em 32 bits, divisões com resto negativo e por zero
+static const char *HILO = R"(
+        .text
+        li   $t0, 30000
+        li   $t1, -30000
+        mult $t2, $t0, $t0
+        mult $t2, $t2, $t0
+        mfhi $s0
+        mflo $s1
+        li   $t3, -17
+        li   $t4, 5
+        div  $t5, $t3, $t4
+        mfhi $s2
+        mflo $s3
+        div  $t6, $t4, $zero
+        mfhi $s4
+        mflo $s5
+        mult $t7, $t1, $t0
+        mfhi $s6
+        end
+)";
+
+void hiLoTest(){
+    cout << "\n=== HI/LO Test ===\n";
+    const Resultado core = roda(HILO, PipelineConfig{});
+    const Resultado rapido = roda(HILO, PipelineConfig{}, 100000, true);
+    const int64_t produto = int64_t(900000000) * 30000;
+    verifica(core.regs[8] == uint32_t(uint64_t(produto) >> 32) && core.regs[9] == uint32_t(produto) &&
+             core.regs[2] == uint32_t(produto), "mult: produto de 64 bits em HI:LO, rd recebe LO");
+    verifica(int32_t(core.regs[10]) == -2 && int32_t(core.regs[11]) == -3 && int32_t(core.regs[5]) == -3,
+             "div: resto em HI e quociente em LO (com sinal)");
+    verifica(core.regs[12] == 5 && core.regs[13] == 0, "div por zero: LO = 0, HI = dividendo");
+    verifica(core.regs[14] == 0xFFFFFFFFu, "mult negativo estende o sinal em HI");
+    verifica(core.regs == rapido.regs, "nucleo rapido == pipeline (incluindo HI/LO)");
+    verifica(isa::disassemble(isa::encodeR(*isa::find("mfhi"), 0, 0, 16, 0)) == "mfhi $s0",
+             "mfhi desmonta com o registrador destino");
+}
+
+// Consumidor logo depois do mult e instruções independentes depois do div
+static const char *DEPENDENTE = R"(
+        .text
+        li   $t0, 6
+        li   $t1, 7
+        mult $t2, $t0, $t1
+        addi $t3, $t2, 1
+        end
+)";
+
+static const char *INDEPENDENTE = R"(
+        .text
+        li   $t0, 84
+        li   $t1, 2
+        div  $t2, $t0, $t1
+        addi $t3, $t0, 1
+        addi $t4, $t1, 1
+        addi $t5, $t3, 1
+        addi $t6, $t4, 1
+        mflo $t7
+        end
+)";
+
+void latencyTest(){
+    cout << "\n=== Functional Unit Latency Test ===\n";
+    const Resultado rapido = roda(DEPENDENTE, unidades({1, 1}, {1, 1}));
+    const Resultado lento = roda(DEPENDENTE, unidades({4, 1}, {1, 1}));
+    verifica(rapido.latencia == 0 && lento.latencia == 3 && lento.ciclos == rapido.ciclos + 3,
+             "mult de 4 ciclos: o consumidor seguinte espera 3");
+    verifica(lento.regs[3] == 43 && rapido.regs == lento.regs, "mesmo resultado");
+
+    const Resultado div1 = roda(INDEPENDENTE, unidades({4, 1}, {1, 1}));
+    const Resultado div12 = roda(INDEPENDENTE, unidades({4, 1}, {12, 12}));
+    verifica(div12.latencia == 7 && div12.ciclos == div1.ciclos + 7,
+             "instrucoes independentes seguem; so o mflo espera o div");
+    verifica(div12.regs[7] == 42 && div12.regs == div1.regs, "mflo le o quociente");
+}
+
+// Quatro operações independentes seguidas na mesma unidade
+static const char *SEGUIDAS = R"(
+        .text
+        li   $t0, 3
+        li   $t1, 5
+        mult $t2, $t0, $t1
+        mult $t3, $t0, $t0
+        mult $t4, $t1, $t1
+        mult $t5, $t1, $t0
+        div  $t6, $t1, $t0
+        div  $t7, $t0, $t1
+        end
+)";
+
+void intervalTest(){
+    cout << "\n=== Initiation Interval Test ===\n";
+    const Resultado segmentado = roda(SEGUIDAS, unidades({4, 1}, {1, 1}));
+    const Resultado naoSegmentado = roda(SEGUIDAS, unidades({4, 4}, {1, 1}));
+    verifica(segmentado.ocupada == 0, "multiplicador segmentado aceita um mult por ciclo");
+    verifica(naoSegmentado.ocupada == 9 && naoSegmentado.ciclos == segmentado.ciclos + 9,
+             "multiplicador nao segmentado: 3 ciclos de espera por mult");
+
+    const Resultado divisor = roda(SEGUIDAS, unidades({4, 1}, {12, 12}));
+    verifica(divisor.ocupada == 11, "div seguido de div espera o divisor inteiro");
+    verifica(segmentado.regs == naoSegmentado.regs && segmentado.regs == divisor.regs &&
+             segmentado.regs[5] == 15 && segmentado.regs[6] == 1, "mesmo resultado");
+}
+
+// Laço com mult/div, mfhi/mflo e lw/sw, para comparar com o núcleo rápido
+static const char *MISTO = R"(
+        .data
+vec:    .word 4, -2, 7, 1, 9, 3, 0, 5
+        .text
+        li   $s0, 0
+        li   $s1, 8
+        li   $s2, 0
+        li   $s4, 3
+laco:   sll  $t0, $s0, 2
+        lw   $t1, 0($t0)
+        mult $t2, $t1, $s4
+        addi $t2, $t2, 7
+        div  $t3, $t2, $s4
+        mfhi $t4
+        add  $s3, $s3, $t4
+        add  $s2, $s2, $t3
+        sw   $t3, 0($t0)
+        addi $s0, $s0, 1
+        blt  $s0, $s1, laco
+        print $s2
+        print $s3
+        end
+)";
+
+void equivalenceTest(){
+    cout << "\n=== Architectural Equivalence Test ===\n";
+    const Equivalencia e = comparaComRapido(MISTO, {
+        unidades({1, 1}, {1, 1}), PipelineConfig{}, unidades({4, 4}, {20, 20}, {3, 1}), unidades({2, 1}, {6, 3}, {2, 2})
+    });
+    verifica(e.rapido.saida == vector<string>({"43", "8"}), "resultado do nucleo rapido");
+    verifica(e.iguais, "todas as latencias == nucleo rapido");
+    verifica(e.fatiasIguais, "execucao em fatias com unidades ocupadas == nucleo rapido");
+
+    bool invalido = false;
+    try { unit_kind_from_string("fpu"); } catch (const invalid_argument &) { invalido = true; }
+    verifica(invalido && unit_kind_from_string("div") == UnitKind::Divider &&
+             unit_of(isa::LatencyClass::Load) == UnitKind::LoadStore, "nomes e classes das unidades");
+}
+
+int main(){
+    hiLoTest();
+    latencyTest();
+    intervalTest();
+    equivalenceTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
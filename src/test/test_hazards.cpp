@@ -0,0 +1,157 @@
+/*
+  test_hazards.cpp
+  Testes do modelo de hazards do pipeline de Core(): dependências RAW com e
+  sem adiantamento, load-use, conflito estrutural na porta de memória e a
+  contagem de ciclos parados por causa. O modelo muda só o tempo: qualquer
+  configuração chega ao mesmo estado arquitetural do núcleo rápido.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+
+#include "pipeline_test.hpp"
+
+using namespace std;
+
+static PipelineConfig modelo(bool exEx, bool memEx, bool portaUnica){
+    PipelineConfig c;
+    c.forwardExEx = exEx;
+    c.forwardMemEx = memEx;
+    c.unifiedMemoryPort = portaUnica;
+    return c;
+}
+
+// Cadeia de dependências a distância 1
+static const char *CADEIA = R"(
+        .text
+        li   $t0, 1
+        addi $t1, $t0, 1
+        addi $t2, $t1, 1
+        addi $t3, $t2, 1
+        end
+)";
+
+void rawTest(){
+    cout << "\n=== RAW / Forwarding Test ===\n";
+    const Resultado completo = roda(CADEIA, modelo(true, true, false));
+    const Resultado soEx = roda(CADEIA, modelo(true, false, false));
+    const Resultado soMem = roda(CADEIA, modelo(false, true, false));
+    const Resultado nenhum = roda(CADEIA, modelo(false, false, false));
+
+    verifica(completo.raw == 0 && completo.exEx == 3 && completo.memEx == 0,
+             "adiantamento completo: nenhuma espera, 3 adiantamentos EX->EX");
+    verifica(soEx.raw == 0 && soEx.ciclos == completo.ciclos, "so EX->EX basta para distancia 1");
+    verifica(soMem.raw == 3 && soMem.memEx == 3 && soMem.ciclos == completo.ciclos + 3,
+             "so MEM->EX: uma bolha por dependencia");
+    verifica(nenhum.raw == 6 && nenhum.ciclos == completo.ciclos + 6,
+             "sem adiantamento: duas bolhas por dependencia (espera o WB)");
+    verifica(nenhum.regs == completo.regs && completo.regs[3] == 4, "mesmo resultado em todos os modos");
+}
+
+static const char *CARGA = R"(
+        .data
+val:    .word 21
+        .text
+        lw   $t0, val
+        add  $t1, $t0, $t0
+        lw   $t2, val
+        addi $t3, $zero, 1
+        add  $t4, $t2, $t3
+        end
+)";
+
+void loadUseTest(){
+    cout << "\n=== Load-Use Test ===\n";
+    const Resultado completo = roda(CARGA, modelo(true, true, false));
+    const Resultado nenhum = roda(CARGA, modelo(false, false, false));
+    verifica(completo.loadUse == 1 && completo.raw == 0, "lw seguido de uso: uma bolha mesmo com adiantamento");
+    verifica(completo.memEx == 3 && completo.exEx == 1, "lw a distancia 2 usa MEM->EX (por operando)");
+    verifica(nenhum.loadUse == 3 && nenhum.raw == 1, "sem adiantamento: lw espera o WB");
+    verifica(completo.regs[1] == 42 && completo.regs[4] == 22 && nenhum.regs == completo.regs,
+             "valores corretos");
+}
+
+static const char *MEMORIA = R"(
+        .data
+soma:   .word 0
+        .text
+        li   $s0, 0
+        li   $s1, 20
+laco:   lw   $t0, soma
+        add  $t0, $t0, $s0
+        sw   $t0, soma
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        end
+)";
+
+void structuralTest(){
+    cout << "\n=== Structural Hazard Test ===\n";
+    const Resultado umaPorta = roda(MEMORIA, modelo(true, true, true));
+    const Resultado duasPortas = roda(MEMORIA, modelo(true, true, false));
+    verifica(umaPorta.estrutural >= 40 && duasPortas.estrutural == 0,
+             "uma porta: o Fetch espera cada lw/sw no MEM");
+    verifica(umaPorta.ciclos > duasPortas.ciclos && umaPorta.dado == 190 && duasPortas.dado == 190,
+             "conflito custa ciclos, nao muda o resultado");
+}
+
+// sw seguido de escrita no registrador que ele guarda: o valor é o antigo
+static const char *STORE = R"(
+        .data
+val:    .word 0
+        .text
+        li   $t0, 5
+        sw   $t0, val
+        li   $t0, 9
+        addi $t0, $t0, 1
+        lw   $t1, val
+        print $t1
+        end
+)";
+
+// Laço com jal/jr, dependências e acessos à memória, para comparar com o núcleo rápido
+static const char *MISTO = R"(
+        .data
+vec:    .word 4, -2, 7, 1, 9, 3, 0, 5
+        .text
+        li   $s0, 0
+        li   $s1, 8
+        li   $s2, 0
+laco:   sll  $t0, $s0, 2
+        lw   $t1, 0($t0)
+        add  $s2, $s2, $t1
+        jal  dobra
+        sw   $t2, 0($t0)
+        lw   $t3, 0($t0)
+        add  $s3, $s3, $t3
+        addi $s0, $s0, 1
+        blt  $s0, $s1, laco
+        print $s2
+        print $s3
+        end
+dobra:  add  $t2, $t1, $t1
+        jr   $ra
+)";
+
+void equivalenceTest(){
+    cout << "\n=== Architectural Equivalence Test ===\n";
+    const Resultado store = roda(STORE, modelo(true, true, true));
+    verifica(store.dado == 5 && store.saida == vector<string>({"5"}), "sw le os operandos antes da instrucao seguinte");
+
+    vector<PipelineConfig> configs;
+    for (int modo = 0; modo < 8; ++modo) configs.push_back(modelo(modo & 1, modo & 2, modo & 4));
+    const Equivalencia e = comparaComRapido(MISTO, configs);
+    verifica(e.rapido.saida == vector<string>({"27", "54"}), "resultado do nucleo rapido");
+    verifica(e.iguais, "todas as configuracoes == nucleo rapido");
+    verifica(e.fatiasIguais, "execucao em fatias com esperas == nucleo rapido");
+}
+
+int main(){
+    rawTest();
+    loadUseTest();
+    structuralTest();
+    equivalenceTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/*
+  test_io_devices.cpp
+  Testes dos dispositivos de I/O (IO/IOManager): cada dispositivo tem fila
+  própria e canais atendendo em paralelo, em tempo virtual. Confere a fila de
+  um dispositivo com 1, 2 e 4 canais, dois dispositivos atendendo ao mesmo
+  tempo, o determinismo com várias threads de trabalho, o checkpoint só numa
+  configuração igual e com a fila de conclusões cheia, e mede a vazão de uma
+  carga só de I/O conforme os canais aumentam.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+static IODeviceConfig dispositivo(const string &nome, unsigned canais, uint64_t minimo, uint64_t maximo){
+    IODeviceConfig d;
+    d.name = nome;
+    d.operation = nome + "_op";
+    d.msg = "Atendendo...";
+    d.channels = canais;
+    d.min_cycles = minimo;
+    d.max_cycles = maximo;
+    return d;
+}
+
+struct Lote {
+    vector<unique_ptr<PCB>> processos;
+    vector<uint64_t> termino; // na ordem de takeCompletions
+    vector<int> ordem;        // pids, na mesma ordem
+};
+
+// 'n' processos pedem I/O no ciclo 'envio(i)'; o dispositivo é o sorteado
+// (destino < 0) ou destino(i)
+template <typename Envio, typename Destino>
+static Lote submete(IOManager &io, int n, Envio envio, Destino destino){
+    Lote lote;
+    for (int i = 0; i < n; ++i) {
+        auto p = make_unique<PCB>();
+        p->pid = i + 1;
+        p->state = State::Blocked;
+        const int d = destino(i);
+        if (d < 0) io.registerProcessWaitingForIO(p.get(), envio(i));
+        else io.registerProcessWaitingForIO(p.get(), envio(i), static_cast<size_t>(d));
+        lote.processos.push_back(move(p));
+    }
+    for (PCB *p : io.takeCompletions(n)) {
+        lote.termino.push_back(p->io_ready_cycle.load());
+        lote.ordem.push_back(p->pid);
+    }
+    return lote;
+}
+
+static auto noCiclo(uint64_t c){ return [c](int) { return c; }; }
+static auto sorteado(){ return [](int) { return -1; }; }
+static auto sempre(int d){ return [d](int) { return d; }; }
+
+void channelTest(){
+    cout << "\n=== Device Channels Test ===\n";
+    vector<vector<uint64_t>> termino;
+    for (unsigned canais : {1u, 2u, 4u}) {
+        IOManager io(1, {dispositivo("disk", canais, 100, 100)});
+        termino.push_back(submete(io, 4, noCiclo(0), sempre(0)).termino);
+    }
+    verifica(termino[0] == vector<uint64_t>({100, 200, 300, 400}), "1 canal: um atendimento por vez");
+    verifica(termino[1] == vector<uint64_t>({100, 100, 200, 200}), "2 canais: dois por vez");
+    verifica(termino[2] == vector<uint64_t>({100, 100, 100, 100}), "4 canais: todos juntos");
+
+    // Canal livre antes da chegada: começa na chegada
+    IOManager io(1, {dispositivo("disk", 1, 100, 100)});
+    const Lote tarde = submete(io, 2, [](int i) { return i == 0 ? 0 : 1000; }, sempre(0));
+    verifica(tarde.termino == vector<uint64_t>({100, 1100}), "dispositivo ocioso nao atrasa a chegada");
+}
+
+void parallelDevicesTest(){
+    cout << "\n=== Parallel Devices Test ===\n";
+    IOManager io(1, {dispositivo("printer", 1, 100, 100), dispositivo("disk", 1, 100, 100)});
+    const Lote lote = submete(io, 4, noCiclo(0), [](int i) { return i % 2; });
+    verifica(lote.termino == vector<uint64_t>({100, 100, 200, 200}), "dispositivos diferentes atendem ao mesmo tempo");
+    verifica(lote.ordem == vector<int>({1, 2, 3, 4}), "empate no termino: menor pid primeiro");
+
+    bool lancou = false;
+    try { IOManager invalido(1, {dispositivo("disk", 0, 100, 100)}); } catch (const invalid_argument &) { lancou = true; }
+    verifica(lancou, "dispositivo sem canais: invalid_argument");
+
+    vector<IODeviceConfig> config = IOManager::defaultDevices();
+    io_device_by_name(config, "network").channels = 3;
+    lancou = false;
+    try { io_device_by_name(config, "tape"); } catch (const invalid_argument &) { lancou = true; }
+    verifica(config[2].channels == 3 && lancou, "io_device_by_name acha pelo nome e rejeita desconhecido");
+}
+
+void determinismTest(){
+    cout << "\n=== Multi-Worker Determinism Test ===\n";
+    vector<IODeviceConfig> config = IOManager::defaultDevices();
+    for (IODeviceConfig &d : config) d.channels = 2;
+    auto envio = [](int i) { return static_cast<uint64_t>(37 * (i / 3)); };
+
+    IOManager a(5, config), b(5, config), c(6, config);
+    const Lote la = submete(a, 60, envio, sorteado());
+    const Lote lb = submete(b, 60, envio, sorteado());
+    const Lote lc = submete(c, 60, envio, sorteado());
+    verifica(la.termino == lb.termino && la.ordem == lb.ordem, "mesma semente: mesmos terminos e ordem, com 6 threads");
+    verifica(la.termino != lc.termino, "outra semente: outros terminos");
+    verifica(is_sorted(la.termino.begin(), la.termino.end()), "conclusoes em ordem de termino");
+    verifica(a.wakeups() == 60, "uma vez por requisicao");
+
+    bool lancou = false;
+    IOManager umCanal(5);
+    try { umCanal.restorePendingState(a.pendingState()); } catch (const invalid_argument &) { lancou = true; }
+    verifica(!umCanal.compatible(a.pendingState()) && lancou, "estado de outra configuracao e rejeitado");
+    IOManager igual(9, config);
+    igual.restorePendingState(a.pendingState());
+    verifica(igual.pendingState().rng == a.pendingState().rng &&
+             igual.pendingState().devices[1].busy_until == a.pendingState().devices[1].busy_until,
+             "mesma configuracao: gerador e canais restaurados");
+}
+
+// Fila de conclusões cheia e o escalonador tirando o checkpoint (todas as
+// travas dos dispositivos) antes de esvaziá-la: as threads não podem ficar
+// esperando espaço na fila com a trava do dispositivo
+void fullRingTest(){
+    cout << "\n=== Full Completion Ring Test ===\n";
+    const size_t n = IOManager::COMPLETION_CAPACITY + 50;
+    IOManager io(1, {dispositivo("disk", 2, 10, 10)});
+    vector<unique_ptr<PCB>> processos;
+    for (size_t i = 0; i < n; ++i) {
+        processos.push_back(make_unique<PCB>());
+        processos.back()->pid = static_cast<int>(i + 1);
+        io.registerProcessWaitingForIO(processos.back().get(), 0, 0);
+    }
+    while (io.wakeups() <= IOManager::COMPLETION_CAPACITY) this_thread::yield();
+
+    // Cada requisição aparece uma vez: esperando o canal ou já atendida
+    const IOManager::PendingState estado = io.pendingState();
+    verifica(estado.completed.size() > IOManager::COMPLETION_CAPACITY &&
+             estado.completed.size() + estado.devices[0].requests.size() == n,
+             "fila cheia: pendingState ve cada requisicao uma vez");
+    IOManager copia(2, {dispositivo("disk", 2, 10, 10)});
+    copia.restorePendingState(estado);
+    verifica(copia.takeCompletions(n).size() == n, "restaurado com mais conclusoes que a fila: todas chegam");
+    verifica(io.takeCompletions(n).size() == n, "original: todas chegam ao esvaziar a fila");
+}
+
+// Carga só de I/O: 'n' requisições no ciclo 0, todas para o disco
+void throughputTest(){
+    cout << "\n=== IO Throughput Scaling Test ===\n";
+    const int n = 64;
+    vector<uint64_t> duracao;
+    for (unsigned canais : {1u, 2u, 4u, 8u}) {
+        vector<IODeviceConfig> config = IOManager::defaultDevices();
+        io_device_by_name(config, "disk").channels = canais;
+        IOManager io(3, config);
+        const auto inicio = chrono::steady_clock::now();
+        const Lote lote = submete(io, n, noCiclo(0), sempre(1));
+        const double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        duracao.push_back(lote.termino.back());
+        cout << "  " << canais << " canal(is): " << n << " requisicoes em " << lote.termino.back()
+             << " ciclos (" << 1000.0 * n / lote.termino.back() << " por mil ciclos), "
+             << segundos * 1000 << " ms de parede\n";
+    }
+    verifica(is_sorted(duracao.rbegin(), duracao.rend()) && duracao[0] > duracao[1], "mais canais, menos ciclos");
+    verifica(duracao[0] >= 3 * duracao[2], "4 canais: ao menos 3x a vazao de 1");
+}
+
+int main(){
+    channelTest();
+    parallelDevicesTest();
+    determinismTest();
+    fullRingTest();
+    throughputTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+/*
+  test_lockstep.cpp
+  Testes da verificação diferencial (cpu/lockstep): Core() e o núcleo rápido
+  precisam concordar, e um motor com defeito plantado precisa ser apontado na
+  instrução exata.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+
+#include "cpu/lockstep.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "cpu/ISA.hpp"
+#include "cpu/PCB.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_json.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+// Núcleo rápido com um defeito depois da 10ª instrução do processo
+static uint64_t fastComRegistroErrado(MemoryManager &mem, PCB &pcb, vector<unique_ptr<IORequest>>* io,
+                                      bool &printLock, uint64_t n){
+    uint64_t antes = pcb.instructions_retired.load();
+    uint64_t feitas = FastCoreRun(mem, pcb, io, printLock, n);
+    if (antes < 10 && pcb.instructions_retired.load() >= 10) pcb.regBank.t2.write(pcb.regBank.t2.read() ^ 1);
+    return feitas;
+}
+
+static uint64_t fastComMemoriaErrada(MemoryManager &mem, PCB &pcb, vector<unique_ptr<IORequest>>* io,
+                                     bool &printLock, uint64_t n){
+    uint64_t antes = pcb.instructions_retired.load();
+    uint64_t feitas = FastCoreRun(mem, pcb, io, printLock, n);
+    if (antes < 12 && pcb.instructions_retired.load() >= 12) mem.poke(4, 12345);
+    return feitas;
+}
+
+static bool contem(const vector<string> &linhas, const string &trecho){
+    for (const auto &l : linhas)
+        if (l.find(trecho) != string::npos) return true;
+    return false;
+}
+
+void agreementTest(MemoryManager &mem, PCB &pcb){
+    cout << "\n=== Lockstep Agreement Test (tasks.json) ===\n";
+    const uint32_t entrada = pcb.regBank.pc.read();
+    for (int intervalo : {1, 7, 64}) {
+        LockstepOptions opcoes;
+        opcoes.interval = intervalo;
+        LockstepReport r = run_lockstep(mem, pcb, opcoes);
+        verifica(r.ok() && r.finished && r.instructions == 73,
+                 "Core e nucleo rapido concordam (intervalo " + to_string(intervalo) + ")");
+    }
+    verifica(pcb.regBank.pc.read() == entrada && pcb.instructions_retired.load() == 0 &&
+             mem.peek(0) == 10, "entrada nao e modificada");
+}
+
+void divergenceTest(MemoryManager &mem, PCB &pcb){
+    cout << "\n=== Lockstep Divergence Test ===\n";
+    const uint32_t entrada = pcb.regBank.pc.read();
+
+    LockstepOptions opcoes;
+    opcoes.interval = 16;
+    opcoes.engine = fastComRegistroErrado;
+    LockstepReport r = run_lockstep(mem, pcb, opcoes);
+    verifica(!r.ok() && r.divergence->localized && r.divergence->instruction == 10,
+             "registro divergente localizado na instrucao #10");
+    verifica(r.divergence && r.divergence->address == entrada + 36 && contem(r.divergence->differences, "$t2"),
+             "endereco e registrador da divergencia");
+    verifica(r.divergence && !r.divergence->trace.empty() && r.divergence->trace.size() <= opcoes.traceLength &&
+             r.divergence->trace.back().find("lw") != string::npos,
+             "trace termina na instrucao divergente");
+    cout << format_lockstep_report(r);
+
+    opcoes.engine = fastComMemoriaErrada;
+    r = run_lockstep(mem, pcb, opcoes);
+    verifica(!r.ok() && r.divergence->instruction == 12 && contem(r.divergence->differences, "mem[4]"),
+             "escrita divergente na memoria localizada na instrucao #12");
+}
+
+int main(){
+    MemoryManager mem(1024, 8192);
+    PCB pcb;
+    ProgramImage img = compileJsonProgram("tasks.json", 0);
+    writeProgramImage(img, mem, pcb);
+    pcb.regBank.pc.write(img.entryAddr());
+    pcb.instructions_retired = 0;
+
+    agreementTest(mem, pcb);
+    divergenceTest(mem, pcb);
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
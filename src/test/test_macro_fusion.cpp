@@ -0,0 +1,147 @@
+/*
+  test_macro_fusion.cpp
+  Testes da macro-fusão de Core(): addi/slti seguido de um desvio que lê o
+  resultado e sll seguido de ori no mesmo registrador ocupam uma só posição
+  do pipeline, pares que não batem seguem separados, o ganho aparece em
+  ciclos e o estado arquitetural é o mesmo do núcleo rápido.
+*/
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <memory>
+
+#include "pipeline_test.hpp"
+
+using namespace std;
+
+static PipelineConfig fusao(bool ligada, unsigned largura = 1, bool adiantamento = true){
+    PipelineConfig c;
+    c.macroFusion = ligada;
+    c.issueWidth = largura;
+    c.forwardExEx = c.forwardMemEx = adiantamento;
+    return c;
+}
+
+// Contador de laço: addi + bne no registrador incrementado
+static const char *CONTADOR = R"(
+        .text
+        li   $s0, 0
+        li   $s1, 50
+laco:   add  $t0, $t0, $s0
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        end
+)";
+
+// Comparação e desvio: slti + bne no resultado da comparação
+static const char *COMPARA = R"(
+        .text
+        li   $s0, 0
+laco:   addi $s0, $s0, 1
+        add  $t1, $t1, $s0
+        slti $t0, $s0, 30
+        bne  $t0, $zero, laco
+        end
+)";
+
+void loopTest(){
+    cout << "\n=== Fused Branch Test ===\n";
+    const Resultado sem = roda(CONTADOR, fusao(false));
+    const Resultado com = roda(CONTADOR, fusao(true));
+    verifica(sem.pares == 0, "sem fusao: nenhum par");
+    verifica(com.pares == 50, "addi + bne: um par por volta");
+    verifica(com.regs == sem.regs && com.instrucoes == sem.instrucoes && com.regs[0] == 1225,
+             "mesmo resultado, mesmas instrucoes");
+    verifica(com.ciclos < sem.ciclos, "par fundido leva menos ciclos");
+
+    const uint64_t ciclos = accumulate(com.emitidas.begin(), com.emitidas.end(), uint64_t(0));
+    verifica(com.emitidas.size() == 2 && ciclos == com.ciclos, "par conta como uma emissao no histograma");
+
+    const Resultado compara = roda(COMPARA, fusao(true));
+    const Resultado comparaSem = roda(COMPARA, fusao(false));
+    verifica(compara.pares == 30 && compara.regs == comparaSem.regs && compara.regs[1] == 465,
+             "slti + bne fundidos");
+    verifica(compara.ciclos < comparaSem.ciclos, "comparacao e desvio em menos ciclos");
+}
+
+// Constante de 32 bits (sll + ori, no lugar de lui + ori) e pares que não batem
+static const char *CONSTANTE = R"(
+        .text
+        li   $t0, 0x1234
+        sll  $t0, $t0, 16
+        ori  $t0, $t0, 0x5678
+        li   $t1, 1
+        sll  $t2, $t1, 16
+        ori  $t3, $t2, 1
+        addi $t4, $t4, 1
+        beq  $t1, $zero, fim
+        addi $t5, $zero, 3
+        slti $t6, $t5, 4
+fim:    end
+)";
+
+void constantTest(){
+    cout << "\n=== Constant and Non-Matching Pairs Test ===\n";
+    const Resultado r = roda(CONSTANTE, fusao(true));
+    verifica(r.regs[0] == 0x12345678u, "sll + ori monta a constante");
+    verifica(r.pares == 1, "so o par no mesmo registrador e fundido");
+    verifica(r.regs[3] == 0x10001u && r.regs[4] == 1 && r.regs[6] == 1, "pares que nao batem executam separados");
+    verifica(Control_Unit::Fusible(0x20000000u, 0) == false, "addi em $zero nao funde");
+}
+
+// Laço com jal/jr, mult/div, mfhi e lw/sw no mesmo endereço
+static const char *MISTO = R"(
+        .data
+vec:    .word 4, -2, 7, 1, 9, 3, 0, 5
+        .text
+        li   $s0, 0
+        li   $s1, 8
+        li   $s2, 0
+        li   $s4, 3
+laco:   sll  $t0, $s0, 2
+        lw   $t1, 0($t0)
+        mult $t2, $t1, $s4
+        jal  soma
+        div  $t3, $t2, $s4
+        mfhi $t4
+        add  $s3, $s3, $t4
+        add  $s2, $s2, $t3
+        sw   $t3, 0($t0)
+        lw   $t5, 0($t0)
+        add  $s5, $s5, $t5
+        addi $s0, $s0, 1
+        blt  $s0, $s1, laco
+        print $s2
+        print $s3
+        print $s5
+        end
+soma:   addi $t2, $t2, 7
+        jr   $ra
+)";
+
+void equivalenceTest(){
+    cout << "\n=== Architectural Equivalence Test ===\n";
+    vector<PipelineConfig> configs;
+    for (unsigned largura : {1u, 2u, 3u})
+        for (bool adiantamento : {true, false}) configs.push_back(fusao(true, largura, adiantamento));
+    bool iguais = true, fatiasIguais = true, fundiu = true;
+    for (const char *fonte : {MISTO, CONTADOR, COMPARA, CONSTANTE}) {
+        const Equivalencia e = comparaComRapido(fonte, configs, [&fundiu](const Resultado &r) {
+            fundiu = fundiu && r.pares > 0;
+        });
+        iguais = iguais && e.iguais;
+        fatiasIguais = fatiasIguais && e.fatiasIguais;
+    }
+    verifica(fundiu, "todos os programas tem pares fundidos");
+    verifica(iguais, "todas as larguras com fusao == nucleo rapido");
+    verifica(fatiasIguais, "execucao em fatias com fusao == nucleo rapido");
+}
+
+int main(){
+    loopTest();
+    constantTest();
+    equivalenceTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
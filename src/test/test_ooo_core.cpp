@@ -0,0 +1,273 @@
+/*
+  test_ooo_core.cpp
+  Testes do núcleo fora de ordem (OooCore): o estado arquitetural e a saída
+  são os mesmos do núcleo rápido em qualquer configuração e fatia, o lw recebe
+  o valor de um sw ainda não confirmado, um front end largo extrai paralelismo
+  que o pipeline em ordem não tem e os histogramas batem com os ciclos.
+*/
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <memory>
+
+#include "cpu/PCB.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "cpu/OOO_CORE.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+static OooConfig modelo(unsigned largura, unsigned rob, unsigned estacoes, unsigned lsq){
+    OooConfig c;
+    c.width = largura;
+    c.robEntries = rob;
+    c.stations = estacoes;
+    c.lsqEntries = lsq;
+    c.units[static_cast<unsigned>(UnitKind::Alu)] = largura;
+    return c;
+}
+
+struct Resultado {
+    uint64_t ciclos = 0, instrucoes = 0;
+    OooStats ooo;
+    vector<uint32_t> regs;   // $t0..$t7, $s0..$s7, hi, lo
+    uint32_t dado = 0;       // primeira palavra de .data
+    vector<string> saida;
+    bool terminou = false;
+};
+
+static Resultado roda(const char *fonte, Engine motor, const OooConfig &config = OooConfig{},
+                      int quantum = 100000, bool printLock = false){
+    MemoryManager mem(4096, 8192);
+    PCB pcb;
+    pcb.quantum = quantum;
+    ProgramImage img = compileAsmSource(fonte, 0);
+    writeProgramImage(img, mem, pcb);
+    pcb.regBank.pc.write(img.entryAddr());
+
+    setOooConfig(config);
+    const CoreFunction nucleo = coreFor(motor);
+    Resultado r;
+    QuietCore quiet;
+    for (int fatia = 0; fatia < 100000 && pcb.state != State::Finished; ++fatia) {
+        vector<unique_ptr<IORequest>> io;
+        pcb.state = State::Running;
+        nucleo(mem, pcb, &io, printLock);
+        for (const auto &req : io) r.saida.push_back(req->msg);
+    }
+    setOooConfig(OooConfig{});
+
+    r.terminou = pcb.state == State::Finished;
+    r.ciclos = pcb.pipeline_cycles.load();
+    r.instrucoes = pcb.instructions_retired.load();
+    r.ooo = pcb.ooo;
+    const hw::REGISTER_BANK &b = pcb.regBank;
+    for (const REGISTER *reg : {&b.t0, &b.t1, &b.t2, &b.t3, &b.t4, &b.t5, &b.t6, &b.t7,
+                                &b.s0, &b.s1, &b.s2, &b.s3, &b.s4, &b.s5, &b.s6, &b.s7, &b.hi, &b.lo})
+        r.regs.push_back(reg->value);
+    r.dado = mem.peek(0);
+    return r;
+}
+
+// Laço com jal/jr, mult/div, mfhi/mflo e lw/sw no mesmo endereço
+static const char *MISTO = R"(
+        .data
+vec:    .word 4, -2, 7, 1, 9, 3, 0, 5
+        .text
+        li   $s0, 0
+        li   $s1, 8
+        li   $s2, 0
+        li   $s4, 3
+laco:   sll  $t0, $s0, 2
+        lw   $t1, 0($t0)
+        mult $t2, $t1, $s4
+        jal  soma
+        div  $t3, $t2, $s4
+        mfhi $t4
+        add  $s3, $s3, $t4
+        add  $s2, $s2, $t3
+        sw   $t3, 0($t0)
+        lw   $t5, 0($t0)
+        add  $s5, $s5, $t5
+        addi $s0, $s0, 1
+        blt  $s0, $s1, laco
+        print $s2
+        print $s3
+        print $s5
+        end
+soma:   addi $t2, $t2, 7
+        jr   $ra
+)";
+
+void equivalenceTest(){
+    cout << "\n=== Architectural Equivalence Test ===\n";
+    const Resultado rapido = roda(MISTO, Engine::Fast);
+    const vector<OooConfig> configs = {
+        OooConfig{}, modelo(1, 4, 2, 1), modelo(4, 64, 32, 16), modelo(3, 8, 4, 2)
+    };
+    bool iguais = true, fatiasIguais = true, bloqueioIgual = true;
+    for (const OooConfig &c : configs) {
+        const Resultado inteiro = roda(MISTO, Engine::OutOfOrder, c);
+        iguais = iguais && inteiro.terminou && inteiro.regs == rapido.regs && inteiro.saida == rapido.saida &&
+                 inteiro.instrucoes == rapido.instrucoes;
+        // Fatias curtas: o que já foi buscado termina, o resto é descartado e buscado de novo
+        for (int quantum : {1, 2, 3, 5, 7}) {
+            const Resultado fatiado = roda(MISTO, Engine::OutOfOrder, c, quantum);
+            fatiasIguais = fatiasIguais && fatiado.terminou && fatiado.regs == rapido.regs &&
+                           fatiado.saida == rapido.saida && fatiado.instrucoes == rapido.instrucoes;
+        }
+        // print bloqueante: o commit para no print e a fatia seguinte continua dali
+        const Resultado bloqueado = roda(MISTO, Engine::OutOfOrder, c, 100000, true);
+        bloqueioIgual = bloqueioIgual && bloqueado.regs == rapido.regs && bloqueado.saida == rapido.saida;
+    }
+    verifica(rapido.saida == vector<string>({"43", "8", "43"}), "resultado do nucleo rapido");
+    verifica(iguais, "todas as configuracoes == nucleo rapido");
+    verifica(fatiasIguais, "execucao em fatias == nucleo rapido");
+    verifica(bloqueioIgual, "print bloqueante == nucleo rapido");
+}
+
+// O lw lê o que o sw anterior ainda não confirmou
+static const char *ENCAMINHA = R"(
+        .data
+val:    .word 1
+        .text
+        li   $t0, 3
+        li   $t1, 4
+        mult $t2, $t0, $t1
+        sw   $t2, val
+        lw   $t3, val
+        addi $t3, $t3, 1
+        sw   $t3, val
+        lw   $t4, val
+        print $t4
+        end
+)";
+
+void forwardingTest(){
+    cout << "\n=== Store-to-Load Forwarding Test ===\n";
+    const Resultado r = roda(ENCAMINHA, Engine::OutOfOrder, modelo(4, 32, 16, 8));
+    verifica(r.regs[3] == 13 && r.regs[4] == 13 && r.saida == vector<string>({"13"}),
+             "lw recebe o valor do sw mais novo no mesmo endereco");
+    verifica(r.dado == 13, "so o commit escreve na memoria, em ordem");
+}
+
+// Quatro cadeias independentes
+static const char *PARALELO = R"(
+        .text
+        li   $s0, 0
+        li   $s1, 50
+laco:   addi $t0, $t0, 1
+        addi $t1, $t1, 2
+        addi $t2, $t2, 3
+        addi $t3, $t3, 4
+        add  $t4, $t4, $t0
+        add  $t5, $t5, $t1
+        add  $t6, $t6, $t2
+        add  $t7, $t7, $t3
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        end
+)";
+
+void ipcTest(){
+    cout << "\n=== Instruction-Level Parallelism Test ===\n";
+    const Resultado emOrdem = roda(PARALELO, Engine::Pipeline);
+    const Resultado estreito = roda(PARALELO, Engine::OutOfOrder, modelo(1, 32, 16, 8));
+    const Resultado largo = roda(PARALELO, Engine::OutOfOrder, modelo(4, 64, 32, 8));
+    const double ipcOrdem = double(emOrdem.instrucoes) / emOrdem.ciclos;
+    const double ipcLargo = double(largo.instrucoes) / largo.ciclos;
+    verifica(largo.regs == emOrdem.regs && estreito.regs == emOrdem.regs, "mesmo resultado");
+    verifica(ipcLargo > 1.5 && ipcLargo > ipcOrdem, "largura 4 passa de 1.5 IPC e do pipeline em ordem");
+    verifica(estreito.ciclos > largo.ciclos, "largura 1 leva mais ciclos");
+
+    const OooStats &s = largo.ooo;
+    const uint64_t ciclosRob = accumulate(s.robOccupancy.begin(), s.robOccupancy.end(), uint64_t(0));
+    const uint64_t ciclosCommit = accumulate(s.committedPerCycle.begin(), s.committedPerCycle.end(), uint64_t(0));
+    uint64_t confirmadas = 0;
+    for (size_t n = 0; n < s.committedPerCycle.size(); ++n) confirmadas += n * s.committedPerCycle[n];
+    verifica(ciclosRob == largo.ciclos && ciclosCommit == largo.ciclos && confirmadas == largo.instrucoes,
+             "histogramas somam os ciclos e as instrucoes");
+    verifica(s.committedPerCycle.size() == 5 && s.committedPerCycle[4] > 0, "ciclos com 4 commits");
+}
+
+// div longo na frente de muitas instruções independentes
+static const char *DIVISAO = R"(
+        .text
+        li   $t0, 1000
+        li   $t1, 7
+        div  $t2, $t0, $t1
+        addi $t3, $zero, 1
+        addi $t4, $zero, 2
+        addi $t5, $zero, 3
+        addi $t6, $zero, 4
+        addi $t7, $zero, 5
+        addi $s0, $zero, 6
+        addi $s1, $zero, 7
+        addi $s2, $zero, 8
+        add  $s3, $t2, $t3
+        end
+)";
+
+void stallTest(){
+    cout << "\n=== Dispatch Stall Test ===\n";
+    const Resultado pequeno = roda(DIVISAO, Engine::OutOfOrder, modelo(2, 4, 16, 8));
+    const Resultado grande = roda(DIVISAO, Engine::OutOfOrder, modelo(2, 32, 16, 8));
+    const auto rob = static_cast<unsigned>(OooStall::RobFull);
+    verifica(pequeno.ooo.dispatchStalls[rob] > 0 && grande.ooo.dispatchStalls[rob] == 0,
+             "ROB pequeno enche atras do div");
+    verifica(pequeno.ciclos > grande.ciclos && pequeno.regs == grande.regs && pequeno.regs[11] == 143,
+             "ROB maior esconde a latencia do div");
+
+    bool invalido = false;
+    try { setOooConfig(modelo(0, 4, 4, 4)); } catch (const invalid_argument &) { invalido = true; }
+    verifica(invalido && oooConfig().width == OooConfig{}.width, "largura zero e rejeitada");
+}
+
+// Desvio que alterna: o preditor erra e o caminho errado é descartado
+static const char *ALTERNA = R"(
+        .data
+val:    .word 0
+        .text
+        li   $s0, 0
+        li   $s1, 40
+laco:   andi $t0, $s0, 1
+        beq  $t0, $zero, par
+        addi $s2, $s2, 1
+        sw   $s2, val
+        j    fim
+par:    addi $s3, $s3, 1
+fim:    addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        end
+)";
+
+void squashTest(){
+    cout << "\n=== Misprediction Squash Test ===\n";
+    const Resultado rapido = roda(ALTERNA, Engine::Fast);
+    const Resultado ooo = roda(ALTERNA, Engine::OutOfOrder, modelo(4, 32, 16, 8));
+    verifica(ooo.ooo.squashed > 0, "previsoes erradas descartam instrucoes");
+    verifica(ooo.regs == rapido.regs && ooo.dado == 20 && ooo.instrucoes == rapido.instrucoes,
+             "caminho errado nao deixa rastro (registradores e memoria)");
+}
+
+int main(){
+    equivalenceTest();
+    forwardingTest();
+    ipcTest();
+    stallTest();
+    squashTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,386 @@
+/*
+  test_parser.cpp
+  Testes do carregamento de programas JSON: montagem da imagem binária,
+  cache de imagens em disco, loader streaming (SAX) comparado ao DOM,
+  montagem concorrente de vários programas, montador de texto (.s) e carga
+  de trabalho por manifesto; relocação de lw/sw e j/jal perto dos limites
+  dos campos.
+*/
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <cstdint>
+#include <thread>
+
+#include "cpu/PCB.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "cpu/workload_loader.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_json.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+// Lê a memória sem depender da ordem das escritas (a cache é write-back)
+static vector<uint32_t> dumpMemory(MemoryManager &mem, PCB &pcb, int start, int end){
+    vector<uint32_t> out;
+    for (int a = start; a < end; a += 4) out.push_back(mem.read(a, pcb));
+    return out;
+}
+
+// Cópia de 'origem' em 'destino' com o u32 em 'offset' trocado por 'valor'
+static void corrompe(const string &origem, const string &destino, streamoff offset, uint32_t valor){
+    std::filesystem::copy_file(origem, destino, std::filesystem::copy_options::overwrite_existing);
+    fstream f(destino, ios::binary | ios::in | ios::out);
+    f.seekp(offset);
+    f.write(reinterpret_cast<const char*>(&valor), sizeof(valor));
+}
+
+void programCacheTest(){
+    cout << "\n=== Program Image Cache Test ===\n";
+    namespace fs = std::filesystem;
+    const string dir = "test_program_cache";
+    fs::remove_all(dir);
+    setProgramCacheDir(dir);
+
+    ProgramImage compiled = compileJsonProgram("tasks.json", 0);
+    verifica(!compiled.words.empty(), "imagem montada nao vazia");
+
+    // 1a carga: miss -> monta e grava no cache
+    MemoryManager mem1(1024, 8192);
+    PCB pcb1;
+    int end1 = loadJsonProgram("tasks.json", mem1, pcb1, 0);
+    string path = programCachePath(hashProgramFile("tasks.json"));
+    verifica(fs::exists(path), "imagem gravada no cache");
+
+    // 2a carga: hit -> mesmas palavras e mesmas escritas contabilizadas
+    MemoryManager mem2(1024, 8192);
+    PCB pcb2;
+    int end2 = loadJsonProgram("tasks.json", mem2, pcb2, 0);
+    verifica(end1 == end2 && end1 == static_cast<int>(compiled.endAddr()), "endereco final igual");
+    verifica(pcb1.mem_writes.load() == pcb2.mem_writes.load(), "mesmo numero de escritas");
+    verifica(dumpMemory(mem1, pcb1, 0, end1) == dumpMemory(mem2, pcb2, 0, end2), "memoria identica");
+
+    ProgramImage cached;
+    verifica(loadProgramImage(path, cached, hashProgramFile("tasks.json")) &&
+             cached.words == compiled.words, "imagem do cache igual a montada");
+    verifica(!loadProgramImage(path, cached, 0), "hash diferente invalida a imagem");
+
+    // A imagem do cache (base 0) relocada para outra base == montagem direta nessa base
+    ProgramImage direta = compileJsonProgram("tasks.json", 256);
+    ProgramImage relocada = compileProgramCached("tasks.json", 256);
+    verifica(direta.words == relocada.words && relocada.entryAddr() == direta.entryAddr(),
+             "relocacao para base 256 igual a montagem direta");
+
+    // Imagem corrompida: recusada no carregamento, e o cache remonta em vez
+    // de falhar ou executar lixo. Campos: codeOffset em 20, n em 24, as n
+    // palavras, r e as relocações
+    const uint64_t h = hashProgramFile("tasks.json");
+    const streamoff primeiraRelocacao = 28 + 4 * static_cast<streamoff>(compiled.words.size()) + 4;
+    const string original = dir + "/original.img";
+    fs::copy_file(path, original);
+    verifica(!compiled.relocations.empty(), "imagem com relocacoes");
+    struct Corrupcao { const char *nome; streamoff offset; uint32_t valor; };
+    for (const Corrupcao &c : {Corrupcao{"n enorme", 24, 0x7fffffffu},
+                               Corrupcao{"n maior que o arquivo", 24, static_cast<uint32_t>(compiled.words.size() + 1)},
+                               Corrupcao{"codeOffset fora da imagem", 20, 0xffffffffu},
+                               Corrupcao{"r maior que o arquivo", primeiraRelocacao - 4, 0x7fffffffu},
+                               Corrupcao{"relocacao fora da imagem", primeiraRelocacao, static_cast<uint32_t>(compiled.words.size())}}) {
+        corrompe(original, path, c.offset, c.valor);
+        ProgramImage lida;
+        const bool recusada = !loadProgramImage(path, lida, h);
+        const ProgramImage remontada = compileProgramCached("tasks.json", 0);
+        verifica(recusada && remontada.words == compiled.words && remontada.codeOffset == compiled.codeOffset,
+                 string(c.nome) + ": recusada e remontada");
+    }
+
+    fs::remove_all(dir);
+}
+
+static ProgramImage compileDom(const string &filename, int startAddr){
+    ifstream f(filename);
+    json j; f >> j;
+    return compileJsonDocument(j, startAddr);
+}
+
+void streamingLoaderTest(){
+    cout << "\n=== Streaming (SAX) Loader Test ===\n";
+
+    ProgramImage dom = compileDom("tasks.json", 0);
+    ProgramImage sax = compileJsonProgram("tasks.json", 0);
+    verifica(dom.words == sax.words && dom.startAddr == sax.startAddr, "tasks.json: SAX igual ao DOM");
+    verifica(dom.codeOffset == sax.codeOffset && dom.relocations == sax.relocations, "tasks.json: mesmas relocacoes");
+
+    dom = compileDom("tasks.json", 400);
+    sax = compileJsonProgram("tasks.json", 400);
+    verifica(dom.words == sax.words, "tasks.json com base 400: SAX igual ao DOM");
+
+    // "program" antes de "data", rótulos à frente, dados em lista com bytes
+    const string file = "test_stream_program.json";
+    {
+        ofstream out(file);
+        out << R"({
+          "program": [
+            { "instruction": "beq", "rs": "$t0", "rt": "$zero", "label": "fim" },
+            { "label": "laco", "instruction": "lw", "rt": "$t1", "base": "valores" },
+            { "instruction": "sw", "rt": "$t1", "base": "saida" },
+            { "instruction": "j", "label": "laco" },
+            { "label": "fim" },
+            { "instruction": "end" }
+          ],
+          "metadata": { "ignorar": [1, 2, {"a": 3}] },
+          "data": [
+            { "type": "byte", "label": "bytes", "value": [1, 2, "0x03"] },
+            { "type": "word", "label": "valores", "value": [10, "0x20"] },
+            { "type": "word", "label": "saida", "value": 0 }
+          ]
+        })";
+    }
+    dom = compileDom(file, 8);
+    sax = compileJsonProgram(file, 8);
+    verifica(dom.words == sax.words && dom.relocations == sax.relocations,
+             "programa antes dos dados + backpatch: SAX igual ao DOM");
+    verifica(sax.words.size() == 4 + 5, "tamanho da imagem (4 dados + 5 instrucoes)");
+
+    bool lancou = false;
+    {
+        ofstream out(file);
+        out << R"({ "program": [ { "instruction": "j", "label": "nao_existe" } ] })";
+    }
+    try { compileJsonProgram(file, 0); } catch (const runtime_error &) { lancou = true; }
+    verifica(lancou, "rotulo inexistente gera erro");
+
+    // Rótulo de código repetido: o DOM resolveria para a última definição e o
+    // SAX, atrás, para a já vista; os dois recusam
+    {
+        ofstream out(file);
+        out << R"({ "program": [
+            { "label": "laco", "instruction": "addi", "rt": "$t0", "rs": "$t0", "immediate": 1 },
+            { "instruction": "bne", "rs": "$t0", "rt": "$zero", "label": "laco" },
+            { "label": "laco", "instruction": "end" } ] })";
+    }
+    bool domLancou = false, saxLancou = false;
+    try { compileDom(file, 0); } catch (const runtime_error &) { domLancou = true; }
+    try { compileJsonProgram(file, 0); } catch (const runtime_error &) { saxLancou = true; }
+    verifica(domLancou && saxLancou, "rotulo de codigo repetido: SAX e DOM recusam");
+
+    std::filesystem::remove(file);
+}
+
+void concurrentLoadTest(){
+    cout << "\n=== Concurrent Assembly Test ===\n";
+
+    // Cada thread monta o mesmo programa em uma base diferente; com tabelas de
+    // símbolos globais uma carga apagaria os rótulos da outra.
+    const int N = 8;
+    vector<ProgramImage> paralelo(N);
+    vector<string> erros(N);
+    vector<thread> threads;
+    for (int i = 0; i < N; ++i) {
+        threads.emplace_back([&, i](){
+            try {
+                for (int rep = 0; rep < 20; ++rep) paralelo[i] = compileJsonProgram("tasks.json", i * 256);
+            } catch (const exception &e) {
+                erros[i] = e.what();
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    bool ok = true;
+    for (int i = 0; i < N; ++i) {
+        if (!erros[i].empty() || paralelo[i].words != compileJsonProgram("tasks.json", i * 256).words) ok = false;
+    }
+    verifica(ok, "montagens paralelas iguais as sequenciais");
+}
+
+void asmAssemblerTest(){
+    cout << "\n=== Text Assembler Test ===\n";
+
+    // tasks.s é tasks.json em texto: mesma imagem, em qualquer base
+    for (int base : {0, 400}) {
+        ProgramImage js = compileJsonProgram("tasks.json", base);
+        ProgramImage as = compileAsmProgram("tasks.s", base);
+        verifica(js.words == as.words && js.codeOffset == as.codeOffset && js.relocations == as.relocations,
+                 "tasks.s igual a tasks.json (base " + to_string(base) + ")");
+    }
+
+    // Bytes empacotados, offset(base), deslocamentos e endereços numéricos
+    ProgramImage texto = compileAsmSource(R"(
+        .text
+        inicio: lw   $t1, 8($sp)      # comentario
+                sll  $t2, $t1, 3
+                bne  $t1, $zero, -2
+                jr   $ra
+                j    0x10
+        .data
+        b:      .byte 1, 2, 0x03
+        w:      .word -1
+    )", 0);
+    ProgramImage dom = compileJsonDocument(json::parse(R"J({
+        "data": [ { "type": "byte", "label": "b", "value": [1, 2, "0x03"] },
+                  { "type": "word", "label": "w", "value": "0xFFFFFFFF" } ],
+        "program": [
+          { "label": "inicio", "instruction": "lw", "rt": "$t1", "addr": "8($sp)" },
+          { "instruction": "sll", "rd": "$t2", "rt": "$t1", "shamt": 3 },
+          { "instruction": "bne", "rs": "$t1", "rt": "$zero", "offset": -2 },
+          { "instruction": "jr", "rs": "$ra" },
+          { "instruction": "j", "address": "0x10" }
+        ] })J"), 0);
+    verifica(texto.words == dom.words && texto.relocations.empty(), "bytes, offset(base) e imediatos iguais ao JSON");
+
+    // Operando de memória numérico é endereço absoluto, não rótulo
+    ProgramImage absoluto = compileAsmSource(".text\n lw $t0, 100\n sw $t1, -4\n", 0);
+    ProgramImage explicito = compileAsmSource(".text\n lw $t0, 100($zero)\n sw $t1, -4($zero)\n", 0);
+    verifica(absoluto.words == explicito.words && absoluto.relocations.empty(),
+             "lw/sw com endereco numerico montam como n($zero)");
+
+    string erro;
+    try { compileAsmSource(".text\n  add $t0, $t1\n", 0); } catch (const runtime_error &e) { erro = e.what(); }
+    verifica(erro.find("linha 2") != string::npos, "erro informa a linha");
+    erro.clear();
+    try { compileAsmSource("beq $t0, $t1, nada\n", 0); } catch (const runtime_error &e) { erro = e.what(); }
+    verifica(!erro.empty(), "rotulo inexistente gera erro");
+    erro.clear();
+    try { compileAsmSource(".data\nx: .word 1\nx: .word 2\n.text\nend\n", 0); } catch (const runtime_error &e) { erro = e.what(); }
+    bool jsonRecusado = false;
+    try {
+        compileJsonDocument(json::parse(R"J({ "data": [ { "label": "x", "value": 1 }, { "label": "x", "value": 2 } ] })J"), 0);
+    } catch (const runtime_error &) { jsonRecusado = true; }
+    verifica(erro.find("linha 3") != string::npos && erro.find("repetido: x") != string::npos && jsonRecusado,
+             "rotulo de dado repetido gera erro (.s e JSON)");
+
+    // O cache escolhe o montador pela extensão
+    setProgramCacheDir("");
+    verifica(compileProgramCached("tasks.s", 0).words == compileJsonProgram("tasks.json", 0).words,
+             "compileProgramCached aceita .s");
+    setProgramCacheDir(".program_cache");
+}
+
+// Escreve a imagem na memória e roda no núcleo rápido até o fim; devolve os prints
+static vector<string> executa(const ProgramImage &img){
+    MemoryManager mem(1024, 65536);
+    PCB pcb;
+    writeProgramImage(img, mem, pcb);
+    pcb.regBank.pc.write(img.entryAddr());
+    pcb.quantum = 1000;
+    vector<unique_ptr<IORequest>> io;
+    bool printLock = false;
+    QuietCore quiet;
+    FastCore(mem, pcb, &io, printLock);
+    vector<string> saida;
+    for (const auto &req : io) saida.push_back(req->msg);
+    return saida;
+}
+
+void relocationReachTest(){
+    cout << "\n=== Relocation Reach Test ===\n";
+    // lw num rótulo guarda o endereço no imediato de 16 bits, estendido com
+    // sinal: o dado precisa ficar abaixo de 0x8000. O código pode passar.
+    const ProgramImage dado = compileAsmSource(R"(
+        .data
+        x:    .word 7
+        .text
+              lw    $t0, x
+              j     fim
+              li    $t0, 0
+        fim:  print $t0
+              end
+    )", 0);
+    ProgramImage alto = dado;
+    relocateProgramImage(alto, 0x7FFC);
+    verifica(alto.entryAddr() == 0x8000 && executa(alto) == vector<string>({"7"}),
+             "dado em 0x7FFC e codigo acima de 0x8000: lw le 7");
+
+    bool lancou = false;
+    ProgramImage foraDoAlcance = dado;
+    try { relocateProgramImage(foraDoAlcance, 0x8000); } catch (const out_of_range &) { lancou = true; }
+    verifica(lancou && foraDoAlcance.startAddr == 0 && foraDoAlcance.words == dado.words,
+             "dado em 0x8000 e recusado, imagem intacta");
+
+    // j/jal: o alvo tem 26 bits e atravessa a fronteira de 64 KiB com vai-um
+    ProgramImage salto = compileAsmSource(R"(
+              j     fim
+              li    $t0, 1
+        fim:  li    $t0, 5
+              print $t0
+              end
+    )", 0);
+    relocateProgramImage(salto, 0xFFFC);
+    verifica(isa::targetOf(salto.words[0]) == 0x10004 && executa(salto) == vector<string>({"5"}),
+             "alvo de j relocado de 0x0008 para 0x10004");
+}
+
+void workloadManifestTest(){
+    cout << "\n=== Workload Manifest Test ===\n";
+    namespace fs = std::filesystem;
+    const string dir = "test_workload";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::copy_file("tasks.json", dir + "/tasks.json");
+    {
+        ofstream out(dir + "/base.json");
+        out << R"({ "name": "base", "quantum": 7, "priority": 2 })";
+    }
+    {
+        ofstream out(dir + "/manifest.json");
+        out << R"({
+          "processes": [
+            { "pcb": "base.json", "program": "tasks.json", "pid": 10, "count": 3 },
+            { "name": "tardio", "program": "tasks.json", "arrival_time": 500 }
+          ]
+        })";
+    }
+
+    Workload w = read_workload_manifest(dir + "/manifest.json");
+    verifica(w.processes.size() == 4, "count expande as entradas");
+
+    MemoryManager mem(1024, 8192);
+    auto procs = load_workload(w, mem, 4);
+    verifica(procs.size() == 4 && procs[0]->pid == 10 && procs[2]->pid == 12 && procs[3]->pid == 4,
+             "pids consecutivos e pid padrao pela posicao");
+    verifica(procs[1]->quantum == 7 && procs[1]->name == "base" && procs[3]->arrival_time == 500,
+             "campos do arquivo de PCB e inline aplicados");
+
+    // Cada processo na sua base, com o PC na primeira instrução e a memória
+    // igual à montagem direta naquela base
+    ProgramImage img = compileJsonProgram("tasks.json", 0);
+    bool ok = true;
+    for (size_t i = 0; i < procs.size(); ++i) {
+        uint32_t base = static_cast<uint32_t>(i) * static_cast<uint32_t>(img.words.size()) * 4;
+        ProgramImage direta = compileJsonProgram("tasks.json", static_cast<int>(base));
+        PCB leitor;
+        if (procs[i]->regBank.pc.read() != direta.entryAddr()) ok = false;
+        if (dumpMemory(mem, leitor, base, direta.endAddr()) != direta.words) ok = false;
+    }
+    verifica(ok, "imagens relocadas sem sobreposicao");
+
+    bool lancou = false;
+    MemoryManager pequena(64, 0);
+    try { load_workload(w, pequena); } catch (const runtime_error &) { lancou = true; }
+    verifica(lancou, "carga maior que a memoria gera erro");
+
+    fs::remove_all(dir);
+}
+
+int main(){
+    programCacheTest();
+    streamingLoaderTest();
+    concurrentLoadTest();
+    asmAssemblerTest();
+    relocationReachTest();
+    workloadManifestTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
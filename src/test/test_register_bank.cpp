@@ -85,6 +85,28 @@ void utilsTest_Bank(){
     }
 }
 
+// Função para testar a cópia: cada banco escreve nos próprios registradores
+void copyTest_Bank(){
+    cout << "\n=== Copy Test (REGISTER_BANK) ===\n";
+    REGISTER_BANK original;
+    original.writeRegister("t0", 7);
+
+    REGISTER_BANK copia(original);
+    copia.writeRegister("t0", 8);
+    REGISTER_BANK atribuida;
+    atribuida = original;
+    atribuida.writeRegister("s0", 9);
+
+    cout << "t0 original/copia: " << original.readRegister("t0") << "/" << copia.readRegister("t0")
+         << " (esperado: 7/8)\n";
+    if (original.readRegister("t0") == 7 && copia.readRegister("t0") == 8 &&
+        atribuida.readRegister("t0") == 7 && original.readRegister("s0") == 0){
+        cout << "  -> SUCESSO: As copias sao independentes do original.\n";
+    } else{
+        cout << "  -> FALHA: A copia ainda acessa os registradores do original.\n";
+        throw runtime_error("copia do REGISTER_BANK compartilha estado");
+    }
+}
 
 int main(){
     cout << "===============================================\n";
@@ -95,6 +117,7 @@ int main(){
         basicFunctionalityTest_Bank();
         rulesAndErrorHandlingTest_Bank();
         utilsTest_Bank();
+        copyTest_Bank();
 
         cout << "\n=== Todos os testes do REGISTER_BANK passaram com sucesso! ===\n";
 
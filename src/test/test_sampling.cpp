@@ -0,0 +1,198 @@
+/*
+  test_sampling.cpp
+  Testes do driver de amostragem (cpu/sampling): as estimativas extrapoladas
+  das janelas detalhadas precisam cobrir o valor medido numa execução
+  completa em Core(), que roda só uma fração das instruções, também quando a
+  janela termina com o divisor ocupado ou com stores no buffer.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+#include "cpu/sampling.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/PCB.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+// Acumula i em v[i % 64], 20000 vezes (~140 mil instruções). Na base 0,
+// 0($t0) indexa o vetor.
+static string programa(){
+    string fonte = "        .data\nvetor:  .word 0";
+    for (int i = 1; i < 64; ++i) fonte += ", 0";
+    fonte += R"(
+        .text
+        li   $s0, 0
+        li   $s1, 20000
+laco:   andi $t0, $s0, 63
+        sll  $t0, $t0, 2
+        lw   $t1, 0($t0)
+        add  $t1, $t1, $s0
+        sw   $t1, 0($t0)
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        print $s0
+        end
+)";
+    return fonte;
+}
+
+// Um div (12 ciclos, não segmentado) cujo resultado só é lido no fim e
+// dois sw por iteração: a janela pode terminar com o divisor ocupado e,
+// com store buffer, com escritas pendentes
+static string programaDivisao(){
+    string fonte = "        .data\nvetor:  .word 0";
+    for (int i = 1; i < 64; ++i) fonte += ", 0";
+    fonte += R"(
+        .text
+        li   $s0, 0
+        li   $s1, 8000
+        li   $s2, 7
+laco:   div  $t2, $s0, $s2
+        andi $t0, $s0, 31
+        sll  $t0, $t0, 3
+        sw   $s0, 0($t0)
+        sw   $s1, 4($t0)
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        mflo $t3
+        print $t3
+        end
+)";
+    return fonte;
+}
+
+struct Maquina {
+    MemoryManager mem{1024, 8192};
+    PCB pcb;
+    explicit Maquina(const ProgramImage &img){
+        writeProgramImage(img, mem, pcb);
+        pcb.regBank.pc.write(img.entryAddr());
+        // A carga passou pela cache: as métricas começam do zero
+        copy_pcb_state(PCB{}, pcb);
+        pcb.regBank.pc.write(img.entryAddr());
+    }
+};
+
+static bool cobre(const SampleEstimate &e, double real, double folga){
+    return fabs(e.mean - real) <= e.halfWidth + folga * real;
+}
+
+void estimateTest(){
+    cout << "\n=== Sampling Estimate Test ===\n";
+    ProgramImage img = compileAsmSource(programa(), 0);
+
+    // Referência: o programa inteiro no pipeline detalhado
+    Maquina completa(img);
+    {
+        QuietCore quiet;
+        vector<unique_ptr<IORequest>> io;
+        bool printLock = false;
+        completa.pcb.quantum = 1000000;
+        Core(completa.mem, completa.pcb, &io, printLock);
+    }
+    const double ciclos = completa.pcb.pipeline_cycles.load();
+    const double ciclosMem = completa.pcb.memory_cycles.load();
+
+    Maquina amostrada(img);
+    SamplingOptions opcoes;
+    opcoes.fastForward = 4000;
+    opcoes.warmup = 200;
+    opcoes.detail = 300;
+    vector<unique_ptr<IORequest>> io;
+    SamplingReport r = run_sampled(amostrada.mem, amostrada.pcb, opcoes, &io);
+    cout << format_sampling_report(r);
+    cout << "  (execucao completa: " << ciclos << " ciclos, " << ciclosMem << " ciclos de memoria)\n";
+
+    verifica(r.finished && r.totalInstructions == completa.pcb.instructions_retired.load(),
+             "total de instrucoes exato");
+    verifica(r.windows.size() >= 20 && r.detailedInstructions * 10 < r.totalInstructions,
+             "menos de 10% das instrucoes no pipeline detalhado");
+    verifica(cobre(r.totalCycles, ciclos, 0.01), "ciclos estimados cobrem a execucao completa");
+    verifica(cobre(r.totalMemoryCycles, ciclosMem, 0.05), "ciclos de memoria estimados cobrem a execucao completa");
+    verifica(r.cacheMissRate.mean > 0 && r.cacheMissRate.mean < 1, "taxa de miss medida nas janelas");
+
+    // Estado arquitetural igual ao da execução completa
+    bool igual = amostrada.pcb.regBank.s0.read() == completa.pcb.regBank.s0.read() &&
+                 amostrada.pcb.regBank.pc.read() == completa.pcb.regBank.pc.read() &&
+                 io.size() == 1 && io[0]->msg == "20000";
+    for (uint32_t addr = 0; addr < 256; addr += 4)
+        if (amostrada.mem.peek(addr) != completa.mem.peek(addr)) igual = false;
+    verifica(igual, "estado final igual ao da execucao completa");
+}
+
+// O esvaziamento tirado de cada janela é o que Core() mediu (com o divisor
+// ocupado, mais que os 4 ciclos dos estágios), não um valor fixo
+void drainTest(){
+    cout << "\n=== Sampling Drain Test ===\n";
+    ProgramImage img = compileAsmSource(programaDivisao(), 0);
+    PipelineConfig comBuffer;
+    comBuffer.storeBufferEntries = 8;
+    for (const PipelineConfig &config : {PipelineConfig{}, comBuffer}) {
+        const string nome = config.storeBufferEntries ? "store buffer: " : "divisor: ";
+        setPipelineConfig(config);
+        Maquina completa(img);
+        {
+            QuietCore quiet;
+            vector<unique_ptr<IORequest>> io;
+            bool printLock = false;
+            completa.pcb.quantum = 1000000;
+            Core(completa.mem, completa.pcb, &io, printLock);
+        }
+        const double ciclos = completa.pcb.pipeline_cycles.load();
+
+        Maquina amostrada(img);
+        SamplingOptions opcoes;
+        opcoes.fastForward = 3000;
+        opcoes.warmup = 200;
+        opcoes.detail = 1000;
+        SamplingReport r = run_sampled(amostrada.mem, amostrada.pcb, opcoes);
+        setPipelineConfig(PipelineConfig{});
+
+        uint64_t maior = 0, soma = 0;
+        for (const SampleWindow &w : r.windows) {
+            maior = max(maior, w.drainCycles);
+            soma += w.drainCycles;
+        }
+        cout << "  " << nome << r.windows.size() << " janelas, esvaziamento de ate " << maior << " ciclos; estimativa "
+             << r.totalCycles.mean << " +- " << r.totalCycles.halfWidth << ", execucao completa " << ciclos << "\n";
+        verifica(r.finished && maior > 4 && soma == amostrada.pcb.pipeline_drain_cycles.load(),
+                 nome + "esvaziamento medido em cada janela");
+        verifica(cobre(r.totalCycles, ciclos, 0.01), nome + "ciclos estimados cobrem a execucao completa");
+    }
+}
+
+void limitTest(){
+    cout << "\n=== Sampling Limit Test ===\n";
+    Maquina m(compileAsmSource(programa(), 0));
+    SamplingOptions opcoes;
+    opcoes.fastForward = 1000;
+    opcoes.warmup = 0;
+    opcoes.detail = 100;
+    opcoes.maxInstructions = 5000;
+    SamplingReport r = run_sampled(m.mem, m.pcb, opcoes);
+    verifica(!r.finished && r.totalInstructions >= 5000 && r.totalInstructions < 6200 && !r.windows.empty(),
+             "para no limite de instrucoes");
+    verifica(m.pcb.quantum == 0, "quantum do processo restaurado");
+}
+
+int main(){
+    estimateTest();
+    drainTest();
+    limitTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+/*
+  test_simd.cpp
+  Testes das instruções vetoriais: a ULA vetorial (qualquer back end) dá o
+  mesmo resultado da conta escalar, o montador de texto e o JSON geram as
+  mesmas palavras, um laço vetorizado deixa a memória igual à do laço
+  escalar com menos instruções e ciclos, o vload/vstore paga uma vez por
+  linha de 16 bytes e os quatro núcleos terminam no mesmo estado.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <string>
+#include <stdexcept>
+
+#include "cpu/PCB.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "cpu/OOO_CORE.hpp"
+#include "cpu/SMT_CORE.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_json.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+void aluTest(){
+    cout << "\n=== Vector ALU Test (" << vector_backend() << ") ===\n";
+    const uint32_t a[8] = {1, 0x7FFFFFFFu, 0xFFFFFFFFu, 0x80000000u, 123456789, 0x10001u, 0, 0xDEADBEEFu};
+    const uint32_t b[8] = {2, 1, 0xFFFFFFFFu, 0x80000000u, 987654321, 0x10001u, 5, 0x12345678u};
+
+    bool iguais = true;
+    for (operation op : {ADD, SUB, MUL}) {
+        for (unsigned lanes : {1u, 3u, 4u, 8u}) {
+            uint32_t out[8];
+            for (uint32_t &x : out) x = 0xCAFEu;
+            vector_calculate(op, a, b, out, lanes);
+            for (unsigned i = 0; i < 8; ++i) {
+                const uint32_t esperado = i >= lanes ? 0xCAFEu
+                                        : op == ADD ? a[i] + b[i] : op == SUB ? a[i] - b[i] : a[i] * b[i];
+                iguais = iguais && out[i] == esperado;
+            }
+        }
+    }
+    verifica(iguais, "add/sub/mul por lane == conta escalar (com overflow)");
+
+    uint32_t x[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    vector_calculate(ADD, x, x, x, 8);
+    verifica(x[0] == 2 && x[7] == 16, "destino igual a uma das fontes");
+}
+
+void encodingTest(){
+    cout << "\n=== Encoding Test ===\n";
+    ProgramImage texto = compileAsmSource(R"(
+        .text
+        vload.8  $w1, 32($t0)
+        vadd.4   $w2, $w0, $w1
+        vmul.8   $w7, $w7, $w3
+        vstore.4 $w2, -16($sp)
+        end
+    )", 0);
+    ProgramImage dom = compileJsonDocument(json::parse(R"J({
+        "program": [
+          { "instruction": "vload.8", "rt": "$w1", "addr": "32($t0)" },
+          { "instruction": "vadd.4", "rd": "$w2", "rs": "$w0", "rt": "$w1" },
+          { "instruction": "vmul.8", "rd": "$w7", "rs": "$w7", "rt": "$w3" },
+          { "instruction": "vstore.4", "rt": "$w2", "addr": "-16($sp)" },
+          { "instruction": "end" }
+        ] })J"), 0);
+    verifica(texto.words == dom.words, "montador de texto == JSON");
+
+    const vector<string> esperado = {"vload.8 $w1, 32($t0)", "vadd.4 $w2, $w0, $w1", "vmul.8 $w7, $w7, $w3",
+                                     "vstore.4 $w2, -16($sp)"};
+    bool ida = true;
+    for (size_t i = 0; i < esperado.size(); ++i) {
+        const isa::InstrDesc *d = isa::decode(texto.words[i]);
+        ida = ida && d && isa::isVector(d->op) && isa::disassemble(texto.words[i]) == esperado[i];
+    }
+    verifica(ida, "disassemble devolve o texto montado");
+    verifica(isa::decode(texto.words[0])->lanes == 8 && isa::decode(texto.words[1])->lanes == 4, "lanes no sufixo");
+
+    unsigned rejeitados = 0;
+    for (const char *fonte : {"vadd.4 $w8, $w0, $w1\n", "vadd.4 $t0, $w0, $w1\n", "vload.4 $t1, 0($t0)\n",
+                              "vadd.16 $w0, $w0, $w1\n"}) {
+        try { compileAsmSource(fonte, 0); } catch (const runtime_error &) { rejeitados++; }
+    }
+    verifica(rejeitados == 4, "registrador vetorial invalido e largura desconhecida rejeitados");
+}
+
+// C[i] = (A[i] + B[i]) * A[i], 16 palavras: A em 0, B em 64, C em 128
+static const char *DADOS = R"(
+        .data
+A:      .word 1, 2, 3, 4, 5, 6, 7, 8, -9, 10, 11, 12, 13, 14, 15, 0x7FFFFFFF
+B:      .word 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 1
+C:      .word 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+)";
+
+static const char *ESCALAR = R"(
+        .text
+        li   $t0, 0
+        li   $t1, 64
+        li   $t2, 128
+        li   $s0, 0
+        li   $s1, 16
+laco:   lw   $t3, 0($t0)
+        lw   $t4, 0($t1)
+        add  $t5, $t3, $t4
+        mult $t6, $t5, $t3
+        sw   $t6, 0($t2)
+        addi $t0, $t0, 4
+        addi $t1, $t1, 4
+        addi $t2, $t2, 4
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        end
+)";
+
+static const char *VETORIAL = R"(
+        .text
+        li   $t0, 0
+        li   $t1, 64
+        li   $t2, 128
+        li   $s0, 0
+        li   $s1, 16
+laco:   vload.8  $w0, 0($t0)
+        vload.8  $w1, 0($t1)
+        vadd.8   $w2, $w0, $w1
+        vmul.8   $w3, $w2, $w0
+        vstore.8 $w3, 0($t2)
+        addi $t0, $t0, 32
+        addi $t1, $t1, 32
+        addi $t2, $t2, 32
+        addi $s0, $s0, 8
+        bne  $s0, $s1, laco
+        lw   $s2, 132($zero)
+        vload.4  $w4, 136($zero)
+        print $s2
+        end
+)";
+
+enum class Nucleo { Pipeline, Rapido, ForaDeOrdem, Smt };
+
+struct Resultado {
+    uint64_t ciclos = 0, instrucoes = 0, vetoriais = 0, lanes = 0;
+    vector<uint32_t> regs;   // escalares e PC
+    vector<uint32_t> w;      // $w0..$w7, lane a lane
+    vector<uint32_t> c;      // as 16 palavras de C
+    vector<string> saida;
+};
+
+static Resultado roda(const string &fonte, Nucleo nucleo){
+    MemoryManager mem(4096, 8192);
+    PCB pcb;
+    pcb.quantum = 100000;
+    ProgramImage img = compileAsmSource(fonte, 0);
+    writeProgramImage(img, mem, pcb);
+    pcb.regBank.pc.write(img.entryAddr());
+
+    Resultado r;
+    QuietCore quiet;
+    bool printLock = false;
+    vector<unique_ptr<IORequest>> io;
+    if (nucleo == Nucleo::Smt) {
+        run_smt(mem, {&pcb}, SmtConfig{}, &io);
+    } else {
+        for (int fatia = 0; fatia < 1000 && pcb.state != State::Finished; ++fatia) {
+            if (nucleo == Nucleo::Pipeline) Core(mem, pcb, &io, printLock);
+            else if (nucleo == Nucleo::Rapido) FastCore(mem, pcb, &io, printLock);
+            else OooCore(mem, pcb, &io, printLock);
+        }
+    }
+    for (const auto &req : io) r.saida.push_back(req->msg);
+
+    r.ciclos = pcb.pipeline_cycles.load();
+    r.instrucoes = pcb.instructions_retired.load();
+    r.vetoriais = pcb.vector_instructions.load();
+    r.lanes = pcb.vector_lanes.load();
+    for (unsigned reg = 1; reg < hw::ARCH_REGISTERS; ++reg) r.regs.push_back((pcb.regBank.*hw::ARCH_REGISTER[reg]).value);
+    r.regs.push_back(pcb.regBank.pc.value);
+    for (const auto &v : pcb.regBank.w) r.w.insert(r.w.end(), v.begin(), v.end());
+    for (uint32_t addr = 128; addr < 192; addr += 4) r.c.push_back(mem.peek(addr));
+    return r;
+}
+
+void workloadTest(){
+    cout << "\n=== Vectorized Loop Test ===\n";
+    const Resultado escalar = roda(string(DADOS) + ESCALAR, Nucleo::Pipeline);
+    const Resultado vetorial = roda(string(DADOS) + VETORIAL, Nucleo::Pipeline);
+
+    vector<uint32_t> esperado;
+    const int32_t a[16] = {1, 2, 3, 4, 5, 6, 7, 8, -9, 10, 11, 12, 13, 14, 15, 0x7FFFFFFF};
+    const int32_t b[16] = {5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 1};
+    for (int i = 0; i < 16; ++i) esperado.push_back((uint32_t(a[i]) + uint32_t(b[i])) * uint32_t(a[i]));
+
+    verifica(escalar.c == esperado, "laco escalar calcula C");
+    verifica(vetorial.c == esperado, "laco vetorial deixa C igual ao escalar");
+    verifica(vetorial.saida == vector<string>({to_string(int32_t(esperado[1]))}), "lw le o que o vstore escreveu");
+    verifica(vetorial.w[4 * 8 + 0] == esperado[2] && vetorial.w[4 * 8 + 3] == esperado[5] && vetorial.w[4 * 8 + 4] == 0,
+             "vload.4 preenche so 4 lanes");
+    verifica(vetorial.vetoriais == 2 * 5 + 1 && vetorial.lanes == 2 * 5 * 8 + 4, "contadores de instrucoes e lanes");
+    verifica(vetorial.instrucoes * 3 < escalar.instrucoes, "menos instrucoes que o laco escalar");
+    verifica(vetorial.ciclos < escalar.ciclos, "menos ciclos que o laco escalar");
+    cout << "    escalar: " << escalar.instrucoes << " instrucoes, " << escalar.ciclos << " ciclos; vetorial: "
+         << vetorial.instrucoes << " instrucoes, " << vetorial.ciclos << " ciclos\n";
+}
+
+void memoryTest(){
+    cout << "\n=== Per-Line Memory Charging Test ===\n";
+    verifica(MemoryManager::vectorLines(0, 8) == 2 && MemoryManager::vectorLines(8, 8) == 3 &&
+             MemoryManager::vectorLines(16, 4) == 1 && MemoryManager::vectorLines(20, 4) == 2,
+             "linhas de 16 bytes cobertas");
+
+    // vstore.8 alinhado: o que dois sw (um por linha) custariam
+    MemoryManager mem(4096, 8192), ref(4096, 8192);
+    PCB pcb, dois;
+    uint32_t v[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    mem.writeVector(256, v, 8, pcb);
+    ref.write(256, 1, dois);
+    ref.write(272, 5, dois);
+    verifica(pcb.mem_accesses_total.load() == dois.mem_accesses_total.load() &&
+             pcb.memory_cycles.load() == dois.memory_cycles.load() && pcb.mem_writes.load() == 2,
+             "vstore.8 alinhado: uma escrita por linha");
+    const uint64_t antes = pcb.mem_accesses_total.load();
+    uint32_t lido[8] = {};
+    mem.readVector(256, lido, 8, pcb);
+    verifica(pcb.mem_accesses_total.load() - antes == 2, "vload.8 alinhado: 2 acessos");
+    verifica(equal(begin(v), end(v), begin(lido)), "vload le o que o vstore escreveu");
+
+    PCB desalinhado;
+    mem.readVector(264, lido, 8, desalinhado);
+    verifica(desalinhado.mem_accesses_total.load() == 3, "vload.8 desalinhado: 3 linhas");
+
+    PCB escalar;
+    for (uint32_t addr = 512; addr < 544; addr += 4) mem.read(addr, escalar);
+    PCB vetorial;
+    mem.readVector(1024 + 512, lido, 8, vetorial);
+    verifica(escalar.mem_accesses_total.load() == 8 && vetorial.mem_accesses_total.load() == 2,
+             "8 lw contra 1 vload.8");
+}
+
+void coresTest(){
+    cout << "\n=== Core Equivalence Test ===\n";
+    const string fonte = string(DADOS) + VETORIAL;
+    const Resultado pipeline = roda(fonte, Nucleo::Pipeline);
+    bool iguais = true;
+    for (Nucleo n : {Nucleo::Rapido, Nucleo::ForaDeOrdem, Nucleo::Smt}) {
+        const Resultado r = roda(fonte, n);
+        iguais = iguais && r.regs == pipeline.regs && r.w == pipeline.w && r.c == pipeline.c &&
+                 r.saida == pipeline.saida && r.instrucoes == pipeline.instrucoes &&
+                 r.vetoriais == pipeline.vetoriais && r.lanes == pipeline.lanes;
+    }
+    verifica(iguais, "rapido, fora de ordem e SMT == Core()");
+
+    // Store buffer e emissão dupla no Core(): o vload pega o que está no buffer
+    static const char *BUFFER = R"(
+        .text
+        li   $t0, 7
+        sw   $t0, 516($zero)
+        vload.4  $w0, 512($zero)
+        vadd.4   $w1, $w0, $w0
+        vstore.4 $w1, 528($zero)
+        lw   $t1, 532($zero)
+        print $t1
+        end
+    )";
+    PipelineConfig config;
+    config.storeBufferEntries = 4;
+    config.issueWidth = 2;
+    setPipelineConfig(config);
+    const Resultado buffer = roda(BUFFER, Nucleo::Pipeline);
+    setPipelineConfig(PipelineConfig{});
+    verifica(buffer.saida == vector<string>({"14"}) && roda(BUFFER, Nucleo::ForaDeOrdem).saida == buffer.saida,
+             "vload apos sw no store buffer e lw apos vstore");
+}
+
+int main(){
+    aluTest();
+    encodingTest();
+    workloadTest();
+    memoryTest();
+    coresTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
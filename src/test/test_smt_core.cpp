@@ -0,0 +1,234 @@
+/*
+  test_smt_core.cpp
+  Testes do multithreading de hardware (SMT_CORE): vários processos num
+  núcleo terminam com o mesmo estado que teriam sozinhos no núcleo rápido,
+  a troca de contexto esconde a latência da memória (e não ajuda quem só
+  usa a ULA), e a troca por miss paga a penalidade a cada troca.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <string>
+#include <stdexcept>
+
+#include "cpu/PCB.hpp"
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/FAST_CORE.hpp"
+#include "cpu/SMT_CORE.hpp"
+#include "memory/MemoryManager.hpp"
+#include "parser_json/parser_asm.hpp"
+#include "parser_json/program_image.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void verifica(bool ok, const string &descricao){
+    cout << "  " << descricao << ": " << (ok ? "SUCESSO" : "FALHA") << "\n";
+    if (!ok) falhas++;
+}
+
+// Percorre 30 palavras a partir de BASE: cada lw lê o que foi escrito 16
+// voltas antes, que a cache (16 linhas, dividida com as instruções) já perdeu.
+// As 16 primeiras leituras pegam palavras nunca escritas (-1).
+static string memoria(int base){
+    string fonte = R"(
+        .text
+        li   $t0, BASE
+        li   $s0, 0
+        li   $s1, 30
+laco:   sw   $s0, 0($t0)
+        lw   $t1, -64($t0)
+        add  $s2, $s2, $t1
+        addi $t0, $t0, 4
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        print $s2
+        end
+)";
+    fonte.replace(fonte.find("BASE"), 4, to_string(base));
+    return fonte;
+}
+
+// Só ULA, laço pequeno (cabe na cache)
+static const char *CALCULO = R"(
+        .text
+        li   $s0, 0
+        li   $s1, 40
+laco:   addi $t0, $t0, 3
+        add  $t1, $t1, $t0
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        print $t1
+        end
+)";
+
+// jal/jr, mult/div e mfhi
+static const char *MISTO = R"(
+        .text
+        li   $s0, 0
+        li   $s1, 6
+        li   $s4, 3
+laco:   addi $t1, $s0, 5
+        mult $t2, $t1, $s4
+        jal  soma
+        div  $t3, $t2, $s4
+        mfhi $t4
+        add  $s3, $s3, $t4
+        add  $s2, $s2, $t3
+        addi $s0, $s0, 1
+        blt  $s0, $s1, laco
+        print $s2
+        print $s3
+        end
+soma:   addi $t2, $t2, 7
+        jr   $ra
+)";
+
+struct Maquina {
+    MemoryManager mem{4096, 8192};
+    vector<unique_ptr<PCB>> processos;
+
+    PCB *carrega(const string &fonte, int inicio){
+        auto pcb = make_unique<PCB>();
+        pcb->pid = static_cast<int>(processos.size()) + 1;
+        ProgramImage img = compileAsmSource(fonte, inicio);
+        writeProgramImage(img, mem, *pcb);
+        pcb->regBank.pc.write(img.entryAddr());
+        processos.push_back(move(pcb));
+        return processos.back().get();
+    }
+
+    vector<PCB*> todos() const {
+        vector<PCB*> v;
+        for (const auto &p : processos) v.push_back(p.get());
+        return v;
+    }
+};
+
+static vector<uint32_t> registradores(const PCB &pcb){
+    vector<uint32_t> regs;
+    for (unsigned r = 1; r < hw::ARCH_REGISTERS; ++r) regs.push_back((pcb.regBank.*hw::ARCH_REGISTER[r]).value);
+    regs.push_back(pcb.regBank.pc.value);
+    return regs;
+}
+
+struct Sozinho {
+    vector<uint32_t> regs;
+    vector<string> saida;
+    uint64_t instrucoes = 0;
+};
+
+// Referência: o processo sozinho no núcleo rápido
+static Sozinho rapido(const string &fonte, int inicio){
+    Maquina m;
+    PCB *pcb = m.carrega(fonte, inicio);
+    pcb->quantum = 1000000;
+    Sozinho r;
+    bool printLock = false;
+    vector<unique_ptr<IORequest>> io;
+    FastCore(m.mem, *pcb, &io, printLock);
+    for (const auto &req : io) r.saida.push_back(req->msg);
+    r.regs = registradores(*pcb);
+    r.instrucoes = pcb->instructions_retired.load();
+    return r;
+}
+
+static SmtConfig politica(SmtPolicy p, unsigned penalidade = 3){
+    SmtConfig c;
+    c.policy = p;
+    c.switchPenalty = penalidade;
+    return c;
+}
+
+void equivalenceTest(){
+    cout << "\n=== Architectural Equivalence Test ===\n";
+    const vector<pair<string, int>> programas = {{memoria(2048), 0}, {CALCULO, 400}, {MISTO, 800}, {memoria(3072), 1200}};
+    vector<Sozinho> esperado;
+    for (const auto &p : programas) esperado.push_back(rapido(p.first, p.second));
+
+    bool iguais = true, saidasIguais = true, terminaram = true;
+    for (SmtPolicy p : {SmtPolicy::Interleaved, SmtPolicy::SwitchOnMiss}) {
+        Maquina m;
+        for (const auto &prog : programas) m.carrega(prog.first, prog.second);
+        vector<unique_ptr<IORequest>> io;
+        const SmtReport r = run_smt(m.mem, m.todos(), politica(p), &io);
+        for (size_t i = 0; i < programas.size(); ++i) {
+            const PCB &pcb = *m.processos[i];
+            iguais = iguais && registradores(pcb) == esperado[i].regs &&
+                     pcb.instructions_retired.load() == esperado[i].instrucoes &&
+                     r.threads[i].instructions == esperado[i].instrucoes;
+            vector<string> saida;
+            for (const auto &req : io)
+                if (req->process == &pcb) saida.push_back(req->msg);
+            saidasIguais = saidasIguais && saida == esperado[i].saida;
+            terminaram = terminaram && pcb.state == State::Finished && r.threads[i].finished;
+        }
+    }
+    verifica(esperado[0].saida == vector<string>({"75"}), "resultado do programa de memoria");
+    verifica(iguais, "registradores e PC de cada contexto == nucleo rapido");
+    verifica(saidasIguais, "print de cada contexto == nucleo rapido");
+    verifica(terminaram, "todos os contextos terminam");
+}
+
+void latencyTest(){
+    cout << "\n=== Latency Hiding Test ===\n";
+    Maquina m;
+    m.carrega(memoria(2048), 0);
+    m.carrega(memoria(3072), 400);
+    const SmtReport r = compare_smt(m.mem, m.todos(), politica(SmtPolicy::Interleaved));
+    cout << format_smt_report(r);
+    verifica(r.threads[0].memoryWaitCycles > 0 && r.threads[1].memoryWaitCycles > 0, "programas esperam a memoria");
+    verifica(r.speedup() > 1.2, "dois contextos escondem a latencia (ganho > 1.2x)");
+    verifica(r.threads[0].slowdown() >= 1.0 && r.threads[0].slowdown() < 2.0 &&
+             r.threads[1].slowdown() >= 1.0 && r.threads[1].slowdown() < 2.0,
+             "cada processo fica mais lento, mas menos que 2x");
+    verifica(r.cycles < r.sequentialCycles() && r.instructions > 0 && r.ipc() > 0, "vazao maior que em sequencia");
+
+    Maquina c;
+    c.carrega(CALCULO, 0);
+    c.carrega(CALCULO, 400);
+    const SmtReport calculo = compare_smt(c.mem, c.todos(), politica(SmtPolicy::Interleaved));
+    verifica(calculo.speedup() < 1.1 && calculo.speedup() > 0.9, "so ULA: nada a esconder");
+    verifica(calculo.threads[0].slowdown() > 1.5, "so ULA: os contextos dividem o ciclo");
+}
+
+void switchTest(){
+    cout << "\n=== Switch-on-Miss Test ===\n";
+    auto roda = [](SmtPolicy p, unsigned penalidade) {
+        Maquina m;
+        m.carrega(memoria(2048), 0);
+        m.carrega(memoria(3072), 400);
+        return compare_smt(m.mem, m.todos(), politica(p, penalidade));
+    };
+    const SmtReport troca = roda(SmtPolicy::SwitchOnMiss, 3);
+    verifica(troca.switches > 0 && troca.switchCycles == 3 * troca.switches, "cada troca custa a penalidade");
+    verifica(troca.speedup() > 1.0, "troca por miss tambem ganha do contexto unico");
+    const SmtReport cara = roda(SmtPolicy::SwitchOnMiss, 20);
+    const SmtReport fino = roda(SmtPolicy::Interleaved, 3);
+    verifica(cara.cycles > troca.cycles && fino.cycles < cara.cycles, "troca cara perde para a intercalacao fina");
+
+    Maquina um;
+    um.carrega(memoria(2048), 0);
+    Maquina outro;
+    outro.carrega(memoria(2048), 0);
+    const SmtReport a = run_smt(um.mem, um.todos(), politica(SmtPolicy::Interleaved));
+    const SmtReport b = run_smt(outro.mem, outro.todos(), politica(SmtPolicy::SwitchOnMiss));
+    verifica(a.cycles == b.cycles && b.switches == 0, "um contexto: as duas politicas sao o nucleo unico");
+
+    bool vazio = false, desconhecida = false;
+    try { Maquina m; run_smt(m.mem, {}); } catch (const invalid_argument &) { vazio = true; }
+    try { smt_policy_from_string("round-robin"); } catch (const invalid_argument &) { desconhecida = true; }
+    verifica(vazio && desconhecida && smt_policy_from_string("miss") == SmtPolicy::SwitchOnMiss,
+             "lista vazia e politica desconhecida sao rejeitadas");
+}
+
+int main(){
+    equivalenceTest();
+    latencyTest();
+    switchTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
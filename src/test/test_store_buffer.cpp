@@ -0,0 +1,161 @@
+/*
+  test_store_buffer.cpp
+  Testes do store buffer de Core(): o sw sai do MEM sem esperar a memória, o
+  lw no mesmo endereço recebe o valor do buffer, lw em outros endereços passam
+  pelos stores pendentes, um buffer cheio força a saída do mais antigo e, ao
+  fim da fatia, a memória tem todos os valores. O estado arquitetural é o
+  mesmo do núcleo rápido em qualquer tamanho de buffer, largura e fatia.
+*/
+#include <iostream>
+#include <vector>
+#include <memory>
+
+#include "pipeline_test.hpp"
+
+using namespace std;
+
+static PipelineConfig buffer(unsigned entradas, unsigned largura = 1, bool portaUnica = true){
+    PipelineConfig c;
+    c.storeBufferEntries = entradas;
+    c.issueWidth = largura;
+    c.unifiedMemoryPort = portaUnica;
+    return c;
+}
+
+// Acumulador na memória, relido logo depois do sw (spill/reload)
+static const char *ACUMULA = R"(
+        .data
+soma:   .word 0
+        .text
+        li   $s0, 0
+        li   $s1, 20
+laco:   lw   $t0, soma
+        add  $t0, $t0, $s0
+        sw   $t0, soma
+        lw   $t1, soma
+        addi $s0, $s0, 1
+        add  $s2, $s2, $t1
+        bne  $s0, $s1, laco
+        print $t1
+        end
+)";
+
+void forwardingTest(){
+    cout << "\n=== Store-to-Load Forwarding Test ===\n";
+    const Resultado sem = roda(ACUMULA, buffer(0));
+    const Resultado com = roda(ACUMULA, buffer(4));
+    verifica(sem.adiantados == 0 && sem.cheio == 0, "sem buffer: nenhum load adiantado");
+    verifica(com.adiantados > 0, "lw no mesmo endereco recebe o valor do buffer");
+    verifica(com.regs == sem.regs && com.dados[0] == 190 && com.saida == vector<string>({"190"}),
+             "valor adiantado e o do sw mais novo");
+    verifica(com.estrutural < sem.estrutural && com.ciclos <= sem.ciclos,
+             "sw e lw adiantado nao disputam a porta com a busca");
+}
+
+// lw em outro endereço com stores pendentes na frente
+static const char *DESVIA = R"(
+        .data
+a:      .word 11
+b:      .word 22
+        .text
+        li   $t0, 5
+        li   $t1, 6
+        sw   $t0, a
+        sw   $t1, a
+        lw   $t2, b
+        lw   $t3, a
+        end
+)";
+
+void bypassTest(){
+    cout << "\n=== Memory Disambiguation Test ===\n";
+    const Resultado r = roda(DESVIA, buffer(4));
+    verifica(r.regs[2] == 22, "lw em outro endereco le a memoria, passando pelos stores");
+    verifica(r.regs[3] == 6 && r.adiantados == 1, "lw no endereco dos stores pega o mais novo");
+    verifica(r.dados[0] == 6 && r.dados[1] == 22, "memoria fica com o ultimo sw");
+}
+
+// Stores seguidos em endereços diferentes
+static const char *RAJADA = R"(
+        .data
+vec:    .word 0, 0, 0, 0, 0, 0, 0, 0
+        .text
+        li   $t0, 1
+        li   $t1, 2
+        sw   $t0, 0($zero)
+        sw   $t1, 4($zero)
+        sw   $t0, 8($zero)
+        sw   $t1, 12($zero)
+        sw   $t0, 16($zero)
+        sw   $t1, 20($zero)
+        sw   $t0, 24($zero)
+        sw   $t1, 28($zero)
+        end
+)";
+
+void fullTest(){
+    cout << "\n=== Full Buffer Test ===\n";
+    const Resultado um = roda(RAJADA, buffer(1));
+    const Resultado oito = roda(RAJADA, buffer(8));
+    verifica(um.cheio > 0, "buffer de uma entrada enche");
+    verifica(oito.cheio == 0, "buffer de oito entradas comporta a rajada");
+    const vector<uint32_t> esperado = {1, 2, 1, 2, 1, 2, 1, 2};
+    verifica(um.dados == esperado && oito.dados == esperado, "fim da fatia: todos os stores na memoria");
+}
+
+// Laço com jal/jr, mult/div, mfhi e lw/sw no mesmo endereço
+static const char *MISTO = R"(
+        .data
+vec:    .word 4, -2, 7, 1, 9, 3, 0, 5
+        .text
+        li   $s0, 0
+        li   $s1, 8
+        li   $s2, 0
+        li   $s4, 3
+laco:   sll  $t0, $s0, 2
+        lw   $t1, 0($t0)
+        mult $t2, $t1, $s4
+        jal  soma
+        div  $t3, $t2, $s4
+        mfhi $t4
+        add  $s3, $s3, $t4
+        add  $s2, $s2, $t3
+        sw   $t3, 0($t0)
+        lw   $t5, 0($t0)
+        add  $s5, $s5, $t5
+        addi $s0, $s0, 1
+        blt  $s0, $s1, laco
+        print $s2
+        print $s3
+        print $s5
+        end
+soma:   addi $t2, $t2, 7
+        jr   $ra
+)";
+
+void equivalenceTest(){
+    cout << "\n=== Architectural Equivalence Test ===\n";
+    // Cada fatia esvazia o buffer antes de devolver a CPU
+    vector<PipelineConfig> configs;
+    for (unsigned entradas : {1u, 2u, 4u, 8u})
+        for (unsigned largura : {1u, 2u})
+            for (bool portaUnica : {true, false}) configs.push_back(buffer(entradas, largura, portaUnica));
+    bool iguais = true, fatiasIguais = true;
+    for (const char *fonte : {MISTO, ACUMULA, DESVIA, RAJADA}) {
+        const Equivalencia e = comparaComRapido(fonte, configs);
+        iguais = iguais && e.iguais;
+        fatiasIguais = fatiasIguais && e.fatiasIguais;
+    }
+    verifica(iguais, "todos os tamanhos de buffer == nucleo rapido");
+    verifica(fatiasIguais, "execucao em fatias == nucleo rapido (memoria inclusive)");
+}
+
+int main(){
+    forwardingTest();
+    bypassTest();
+    fullTest();
+    equivalenceTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}
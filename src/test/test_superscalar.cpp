@@ -0,0 +1,173 @@
+/*
+  test_superscalar.cpp
+  Testes da emissão múltipla em ordem de Core(): grupos de até W instruções
+  independentes saem juntos, dependências dentro do grupo e unidades únicas
+  (mult, div, lw/sw) separam o grupo, um desvio é sempre o último a sair e o
+  estado arquitetural é o mesmo do núcleo rápido em qualquer largura.
+*/
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <memory>
+
+#include "pipeline_test.hpp"
+
+using namespace std;
+
+static PipelineConfig largura(unsigned w, bool adiantamento = true){
+    PipelineConfig c;
+    c.issueWidth = w;
+    c.forwardExEx = c.forwardMemEx = adiantamento;
+    return c;
+}
+
+// Quatro cadeias independentes
+static const char *PARALELO = R"(
+        .text
+        li   $s0, 0
+        li   $s1, 50
+laco:   addi $t0, $t0, 1
+        addi $t1, $t1, 2
+        addi $t2, $t2, 3
+        addi $t3, $t3, 4
+        add  $t4, $t4, $t0
+        add  $t5, $t5, $t1
+        add  $t6, $t6, $t2
+        add  $t7, $t7, $t3
+        addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        end
+)";
+
+void ipcTest(){
+    cout << "\n=== Issue Width Test ===\n";
+    const Resultado w1 = roda(PARALELO, largura(1));
+    const Resultado w2 = roda(PARALELO, largura(2));
+    const Resultado w4 = roda(PARALELO, largura(4));
+    verifica(w1.regs == w2.regs && w1.regs == w4.regs && w1.instrucoes == w2.instrucoes, "mesmo resultado");
+    verifica(w2.ciclos < w1.ciclos && w4.ciclos < w2.ciclos, "mais largura, menos ciclos");
+    verifica(double(w2.instrucoes) / w2.ciclos > 1.0, "largura 2 passa de 1 IPC");
+
+    const uint64_t ciclos = accumulate(w4.emitidas.begin(), w4.emitidas.end(), uint64_t(0));
+    uint64_t emitidas = 0;
+    for (size_t n = 0; n < w4.emitidas.size(); ++n) emitidas += n * w4.emitidas[n];
+    verifica(w4.emitidas.size() == 5 && w4.emitidas[4] > 0 && ciclos == w4.ciclos,
+             "histograma: uma entrada por ciclo, com grupos de 4");
+    verifica(emitidas >= w4.instrucoes, "cada instrucao sai do Decode uma vez (mais as do caminho errado)");
+    verifica(w1.emitidas.size() == 2 && w1.dependencia == 0 && w1.separacaoEstrutural == 0,
+             "largura 1: nenhum grupo separado");
+}
+
+// Cadeia de dependências: nada para emparelhar
+static const char *CADEIA = R"(
+        .text
+        li   $t0, 1
+        addi $t1, $t0, 1
+        addi $t2, $t1, 1
+        addi $t3, $t2, 1
+        addi $t4, $t3, 1
+        end
+)";
+
+// Unidades únicas lado a lado (os dois mult também disputam HI/LO)
+static const char *UNIDADES = R"(
+        .data
+val:    .word 5, 6
+        .text
+        li   $t0, 3
+        li   $t1, 7
+        mult $t2, $t0, $t1
+        mult $t3, $t1, $t1
+        lw   $t4, val
+        lw   $t5, 4($zero)
+        end
+)";
+
+void pairingTest(){
+    cout << "\n=== Pairing Rules Test ===\n";
+    const Resultado cadeia1 = roda(CADEIA, largura(1));
+    const Resultado cadeia2 = roda(CADEIA, largura(2));
+    verifica(cadeia2.dependencia > 0 && cadeia2.regs == cadeia1.regs && cadeia2.regs[4] == 5,
+             "dependencia dentro do grupo separa as instrucoes");
+
+    const Resultado unidades = roda(UNIDADES, largura(4));
+    const Resultado unidades1 = roda(UNIDADES, largura(1));
+    verifica(unidades.separacaoEstrutural >= 1 && unidades.dependencia >= 2,
+             "dois lw (uma porta) ou dois mult (ambos escrevem HI/LO) nao saem no mesmo ciclo");
+    verifica(unidades.regs == unidades1.regs && unidades.regs[3] == 49 && unidades.regs[5] == 6, "valores corretos");
+}
+
+// sw seguido de escrita no registrador que ele guarda (lido só no MEM),
+// lw seguido de escrita no destino dele e desvio mal previsto no meio de um grupo
+static const char *ORDEM = R"(
+        .data
+val:    .word 0
+        .text
+        li   $t0, 5
+        sw   $t0, val
+        li   $t0, 9
+        lw   $t1, val
+        li   $t1, 2
+        li   $s0, 0
+        li   $s1, 3
+laco:   addi $s0, $s0, 1
+        bne  $s0, $s1, laco
+        addi $s2, $s2, 10
+        addi $s3, $s3, 20
+        print $t1
+        end
+)";
+
+// Laço com jal/jr, mult/div, mfhi e lw/sw no mesmo endereço
+static const char *MISTO = R"(
+        .data
+vec:    .word 4, -2, 7, 1, 9, 3, 0, 5
+        .text
+        li   $s0, 0
+        li   $s1, 8
+        li   $s2, 0
+        li   $s4, 3
+laco:   sll  $t0, $s0, 2
+        lw   $t1, 0($t0)
+        mult $t2, $t1, $s4
+        jal  soma
+        div  $t3, $t2, $s4
+        mfhi $t4
+        add  $s3, $s3, $t4
+        add  $s2, $s2, $t3
+        sw   $t3, 0($t0)
+        lw   $t5, 0($t0)
+        add  $s5, $s5, $t5
+        addi $s0, $s0, 1
+        blt  $s0, $s1, laco
+        print $s2
+        print $s3
+        print $s5
+        end
+soma:   addi $t2, $t2, 7
+        jr   $ra
+)";
+
+void equivalenceTest(){
+    cout << "\n=== Architectural Equivalence Test ===\n";
+    const Resultado ordem = roda(ORDEM, largura(4));
+    verifica(ordem.dado == 5 && ordem.regs[0] == 9 && ordem.regs[1] == 2 && ordem.saida == vector<string>({"2"}) &&
+             ordem.regs[10] == 10 && ordem.regs[11] == 20, "sw/lw leem e escrevem na ordem do programa");
+
+    vector<PipelineConfig> configs;
+    for (unsigned w : {2u, 3u, 4u})
+        for (bool adiantamento : {true, false}) configs.push_back(largura(w, adiantamento));
+    const Equivalencia e = comparaComRapido(MISTO, configs);
+    verifica(e.rapido.saida == vector<string>({"43", "8", "43"}), "resultado do nucleo rapido");
+    verifica(e.iguais, "todas as larguras == nucleo rapido");
+    verifica(e.fatiasIguais, "execucao em fatias com grupos separados == nucleo rapido");
+}
+
+int main(){
+    ipcTest();
+    pairingTest();
+    equivalenceTest();
+
+    cout << "\n" << (falhas == 0 ? "Todos os testes passaram." : "Ha testes falhando.") << "\n";
+    return falhas == 0 ? 0 : 1;
+}